@@ -17,7 +17,11 @@ namespace cudaq::opt {
 /// Extract resource counts from a Quake IR module using static analysis.
 /// Runs ResourceCountPreprocess to count gates with qubit indices for depth.
 /// Counted gates are erased from the module. Returns the accumulated counts,
-/// or failure if the pass pipeline fails.
+/// or failure if the pass pipeline fails. The counts may be partial: gates
+/// that could not be counted statically (e.g., in loops with a dynamic trip
+/// count) are left in the module, and the number of qubits is left at zero if
+/// any allocation has a dynamic size. Both are then counted by the resource
+/// counter simulator when the remaining module runs.
 mlir::FailureOr<cudaq::Resources> countResourcesFromIR(mlir::ModuleOp module);
 
 } // namespace cudaq::opt
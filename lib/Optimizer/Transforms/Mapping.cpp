@@ -10,12 +10,15 @@
 #include "cudaq/Optimizer/Transforms/Passes.h"
 #include "cudaq/Support/Device.h"
 #include "cudaq/Support/Placement.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/Transforms/TopologicalSortUtils.h"
+#include <random>
 
 #define DEBUG_TYPE "quantum-mapper"
 
@@ -93,6 +96,10 @@ struct VirtualOp {
 /// Modifications from the published paper include the ability to defer
 /// measurement mapping until the end, which is required for QIR Base Profile
 /// programs (see the `allowMeasurementMapping` member variable).
+///
+/// In a dry run, the router makes the same decisions but leaves the IR
+/// untouched: it only updates the placement and counts the swaps and depth of
+/// the routed circuit. Dry runs are used to evaluate placement trials.
 class SabreRouter {
   using WireMap = DenseMap<Value, Placement::VirtualQ>;
   using Swap = std::pair<Placement::DeviceQ, Placement::DeviceQ>;
@@ -100,13 +107,13 @@ class SabreRouter {
 public:
   SabreRouter(const Device &device, WireMap &wireMap, Placement &placement,
               unsigned extendedLayerSize, float extendedLayerWeight,
-              float decayDelta, unsigned roundsDecayReset)
+              float decayDelta, unsigned roundsDecayReset, bool dryRun = false)
       : device(device), wireToVirtualQ(wireMap), placement(placement),
         extendedLayerSize(extendedLayerSize),
         extendedLayerWeight(extendedLayerWeight), decayDelta(decayDelta),
-        roundsDecayReset(roundsDecayReset),
+        roundsDecayReset(roundsDecayReset), dryRun(dryRun),
         phyDecay(device.getNumQubits(), 1.0), phyToWire(device.getNumQubits()),
-        allowMeasurementMapping(false) {}
+        phyDepth(device.getNumQubits(), 0), allowMeasurementMapping(false) {}
 
   /// Main entry point into SabreRouter routing algorithm
   void route(Block &block, ArrayRef<quake::BorrowWireOp> sources);
@@ -114,6 +121,15 @@ public:
   /// After routing, this contains the final values for all the qubits
   ArrayRef<Value> getPhyToWire() { return phyToWire; }
 
+  /// After routing, the number of swaps that were added
+  std::size_t getNumSwaps() const { return numSwaps; }
+
+  /// After routing, the depth of the routed circuit, counting each operation
+  /// and swap as one layer on the device qubits it uses
+  unsigned getDepth() const {
+    return *std::max_element(phyDepth.begin(), phyDepth.end());
+  }
+
 private:
   void visitUsers(ResultRange::user_range users,
                   SmallVectorImpl<VirtualOp> &layer,
@@ -129,6 +145,8 @@ private:
 
   Swap chooseSwap();
 
+  void addToDepth(ArrayRef<Placement::DeviceQ> deviceQubits);
+
 private:
   const Device &device;
   WireMap &wireToVirtualQ;
@@ -139,6 +157,7 @@ private:
   const float extendedLayerWeight;
   const float decayDelta;
   const unsigned roundsDecayReset;
+  const bool dryRun;
 
   // Internal data
   SmallVector<VirtualOp> frontLayer;
@@ -150,6 +169,10 @@ private:
 
   SmallVector<Value> phyToWire;
 
+  /// Depth of the routed circuit on each device qubit.
+  SmallVector<unsigned> phyDepth;
+  std::size_t numSwaps = 0;
+
   /// Keeps track of how many times an operation was visited.
   DenseMap<Operation *, unsigned> visited;
 
@@ -158,8 +181,9 @@ private:
   bool allowMeasurementMapping;
 
 #ifndef NDEBUG
-  /// A logger used to emit diagnostics during the maping process.
-  llvm::ScopedPrinter logger{llvm::dbgs()};
+  /// A logger used to emit diagnostics during the maping process. Dry runs
+  /// may run concurrently and are silent.
+  llvm::ScopedPrinter logger{dryRun ? llvm::nulls() : llvm::dbgs()};
 #endif
 };
 
@@ -211,6 +235,11 @@ LogicalResult SabreRouter::mapOperation(VirtualOp &virtOp) {
       !device.areConnected(deviceQubits[0], deviceQubits[1]))
     return failure();
 
+  if (!isa<quake::SinkOp, quake::ReturnWireOp>(virtOp.op))
+    addToDepth(deviceQubits);
+  if (dryRun)
+    return success();
+
   // Rewire the operation.
   SmallVector<Value, 2> newOpWires;
   for (auto phy : deviceQubits)
@@ -229,6 +258,14 @@ LogicalResult SabreRouter::mapOperation(VirtualOp &virtOp) {
   return success();
 }
 
+void SabreRouter::addToDepth(ArrayRef<Placement::DeviceQ> deviceQubits) {
+  unsigned depth = 0;
+  for (auto phy : deviceQubits)
+    depth = std::max(depth, phyDepth[phy.index]);
+  for (auto phy : deviceQubits)
+    phyDepth[phy.index] = depth + 1;
+}
+
 LogicalResult SabreRouter::mapFrontLayer() {
   bool mappedAtLeastOne = false;
   SmallVector<VirtualOp> newFrontLayer;
@@ -384,6 +421,10 @@ void SabreRouter::route(Block &block, ArrayRef<quake::BorrowWireOp> sources) {
   auto wireType = builder.getType<quake::WireType>();
   auto addSwap = [&](Placement::DeviceQ q0, Placement::DeviceQ q1) {
     placement.swap(q0, q1);
+    ++numSwaps;
+    addToDepth({q0, q1});
+    if (dryRun)
+      return;
     auto swap = builder.create<quake::SwapOp>(
         builder.getUnknownLoc(), TypeRange{wireType, wireType}, false,
         ValueRange{}, ValueRange{},
@@ -434,6 +475,167 @@ void SabreRouter::route(Block &block, ArrayRef<quake::BorrowWireOp> sources) {
   LLVM_DEBUG(logger.startLine() << '\n' << logLineComment << '\n';);
 }
 
+//===----------------------------------------------------------------------===//
+// Placement trials
+//===----------------------------------------------------------------------===//
+
+/// Place virtual qubit `i` on device qubit `perm[i]`, where `perm` is a
+/// pseudo-random permutation derived from `seed`. The permutation only depends
+/// on the seed, not on the standard library implementation.
+void randomPlacement(Placement &placement, std::uint64_t seed) {
+  SmallVector<unsigned> perm(placement.getNumDeviceQubits());
+  for (unsigned i = 0, end = perm.size(); i < end; ++i)
+    perm[i] = i;
+  std::mt19937_64 rng(seed);
+  for (unsigned i = perm.size(); i > 1; --i)
+    std::swap(perm[i - 1], perm[rng() % i]);
+  for (unsigned i = 0, end = placement.getNumVirtualQubits(); i < end; ++i)
+    placement.map(Placement::VirtualQ(i), Placement::DeviceQ(perm[i]));
+}
+
+/// The two-qubit operations of a block and their dependencies, in terms of
+/// virtual qubits. Routing this graph forward and then backward from a
+/// placement yields a placement suited to the start of the circuit (the
+/// reverse traversal technique of the SABRE paper), without touching the IR.
+/// Single-qubit operations and measurements never require swaps and are left
+/// out.
+class InteractionDag {
+public:
+  InteractionDag(Block &block,
+                 const DenseMap<Value, Placement::VirtualQ> &wireToVirtualQ,
+                 unsigned numVirtualQubits) {
+    SmallVector<int> lastOp(numVirtualQubits, -1);
+    for (Operation &op : block.getOperations()) {
+      if (!quake::isSupportedMappingOperation(&op) ||
+          op.hasTrait<QuantumMeasure>())
+        continue;
+      auto wires = quake::getQuantumOperands(&op);
+      if (wires.size() != 2)
+        continue;
+      auto vr0 = wireToVirtualQ.lookup(wires[0]);
+      auto vr1 = wireToVirtualQ.lookup(wires[1]);
+      if (!vr0.isValid() || !vr1.isValid())
+        continue;
+      unsigned node = qubits.size();
+      qubits.emplace_back(vr0, vr1);
+      predecessors.emplace_back();
+      successors.emplace_back();
+      for (auto vr : {vr0, vr1}) {
+        int pred = lastOp[vr.index];
+        if (pred >= 0 && !llvm::is_contained(predecessors[node],
+                                             static_cast<unsigned>(pred))) {
+          predecessors[node].push_back(pred);
+          successors[pred].push_back(node);
+        }
+        lastOp[vr.index] = node;
+      }
+    }
+  }
+
+  /// Route the operations in program order (`forward`) or in reverse order,
+  /// updating `placement` with the chosen swaps. This uses the same heuristic
+  /// as `SabreRouter`.
+  void route(const Device &device, Placement &placement, bool forward,
+             unsigned extendedLayerSize, float extendedLayerWeight,
+             float decayDelta, unsigned roundsDecayReset) const {
+    const auto &dependencies = forward ? predecessors : successors;
+    const auto &dependents = forward ? successors : predecessors;
+    SmallVector<unsigned> numPending(qubits.size());
+    SmallVector<unsigned> frontLayer;
+    for (unsigned node = 0, end = qubits.size(); node < end; ++node) {
+      numPending[node] = dependencies[node].size();
+      if (numPending[node] == 0)
+        frontLayer.push_back(node);
+    }
+
+    auto getDistance = [&](unsigned node) {
+      return device.getDistance(placement.getPhy(qubits[node].first),
+                                placement.getPhy(qubits[node].second));
+    };
+    auto computeLayerCost = [&](ArrayRef<unsigned> layer) {
+      double cost = 0.0;
+      for (auto node : layer)
+        cost += getDistance(node) - 1;
+      return cost / layer.size();
+    };
+
+    SmallVector<float> phyDecay(device.getNumQubits(), 1.0);
+    std::size_t numSwapSearches = 0;
+    while (!frontLayer.empty()) {
+      bool mappedAtLeastOne = false;
+      SmallVector<unsigned> newFrontLayer;
+      for (auto node : frontLayer) {
+        if (getDistance(node) != 1) {
+          newFrontLayer.push_back(node);
+          continue;
+        }
+        mappedAtLeastOne = true;
+        for (auto next : dependents[node])
+          if (--numPending[next] == 0)
+            newFrontLayer.push_back(next);
+      }
+      frontLayer = std::move(newFrontLayer);
+      if (mappedAtLeastOne)
+        continue;
+
+      // The extended layer holds the next operations after the front layer.
+      SmallVector<unsigned> extendedLayer;
+      llvm::DenseSet<unsigned> seen(frontLayer.begin(), frontLayer.end());
+      for (std::size_t i = 0;
+           i < frontLayer.size() + extendedLayer.size() &&
+           extendedLayer.size() < extendedLayerSize;
+           ++i) {
+        unsigned node = i < frontLayer.size()
+                            ? frontLayer[i]
+                            : extendedLayer[i - frontLayer.size()];
+        for (auto next : dependents[node])
+          if (extendedLayer.size() < extendedLayerSize &&
+              seen.insert(next).second)
+            extendedLayer.push_back(next);
+      }
+
+      // Choose the swap with minimal cost among the ones involving the device
+      // qubits of the front layer.
+      std::optional<std::pair<Placement::DeviceQ, Placement::DeviceQ>> best;
+      double bestCost = 0.0;
+      for (auto node : frontLayer)
+        for (auto vr : {qubits[node].first, qubits[node].second}) {
+          auto phy0 = placement.getPhy(vr);
+          for (auto phy1 : device.getNeighbours(phy0)) {
+            placement.swap(phy0, phy1);
+            double swapCost = computeLayerCost(frontLayer);
+            if (!extendedLayer.empty()) {
+              swapCost /= frontLayer.size();
+              swapCost += extendedLayerWeight *
+                          computeLayerCost(extendedLayer) /
+                          extendedLayer.size();
+            }
+            swapCost *= std::max(phyDecay[phy0.index], phyDecay[phy1.index]);
+            placement.swap(phy0, phy1);
+            if (!best || swapCost < bestCost) {
+              best = {phy0, phy1};
+              bestCost = swapCost;
+            }
+          }
+        }
+
+      auto [phy0, phy1] = *best;
+      placement.swap(phy0, phy1);
+      if ((++numSwapSearches % roundsDecayReset) == 0) {
+        std::fill(phyDecay.begin(), phyDecay.end(), 1.0);
+      } else {
+        phyDecay[phy0.index] += decayDelta;
+        phyDecay[phy1.index] += decayDelta;
+      }
+    }
+  }
+
+private:
+  SmallVector<std::pair<Placement::VirtualQ, Placement::VirtualQ>> qubits;
+  SmallVector<SmallVector<unsigned, 2>> predecessors;
+  SmallVector<SmallVector<unsigned, 2>> successors;
+};
+
 std::pair<bool, std::optional<Device>>
 deviceFromString(llvm::StringRef deviceString) {
   std::size_t deviceDim[2];
@@ -600,6 +802,11 @@ struct MappingFunc : public cudaq::opt::impl::MappingFuncBase<MappingFunc> {
   std::optional<Device> deviceInstance;
 
   virtual LogicalResult initialize(MLIRContext *context) override {
+    if (trialCost != "swaps" && trialCost != "depth") {
+      llvm::errs() << "Unknown trialCost option: " << trialCost << '\n';
+      return failure();
+    }
+
     std::tie(deviceBypass, deviceInstance) = deviceFromString(device);
     if (deviceInstance || deviceBypass || !nonComposable) {
       return success();
@@ -609,6 +816,71 @@ struct MappingFunc : public cudaq::opt::impl::MappingFuncBase<MappingFunc> {
     return failure();
   }
 
+  /// Evaluate `numTrials` initial placements in parallel and return the one
+  /// whose routing is the cheapest according to `trialCost`. Each trial is
+  /// scored with a dry run of the router, so the returned placement routes
+  /// exactly to the reported number of swaps and depth. Ties go to the lowest
+  /// trial number, so the result does not depend on thread scheduling.
+  Placement selectPlacement(func::FuncOp func, Block &block,
+                            ArrayRef<quake::BorrowWireOp> sources,
+                            const DenseMap<Value, Placement::VirtualQ> &wires) {
+    const Device &device = *deviceInstance;
+    const unsigned numQubits = sources.size();
+    InteractionDag dag(block, wires, numQubits);
+
+    SmallVector<Placement> placements(
+        numTrials, Placement(numQubits, device.getNumQubits()));
+    SmallVector<std::size_t> numSwaps(numTrials);
+    SmallVector<unsigned> depths(numTrials);
+    mlir::parallelFor(func.getContext(), 0, numTrials, [&](std::size_t trial) {
+      Placement &placement = placements[trial];
+      if (trial < 2)
+        identityPlacement(placement);
+      else
+        randomPlacement(placement, std::uint64_t(trialSeed) + trial);
+
+      // Forward-backward refinement of the initial placement.
+      if (trial > 0)
+        for (bool forward : {true, false})
+          dag.route(device, placement, forward, extendedLayerSize,
+                    extendedLayerWeight, decayDelta, roundsDecayReset);
+
+      Placement routedPlacement = placement;
+      DenseMap<Value, Placement::VirtualQ> wireToVirtualQ = wires;
+      SabreRouter router(device, wireToVirtualQ, routedPlacement,
+                         extendedLayerSize, extendedLayerWeight, decayDelta,
+                         roundsDecayReset, /*dryRun=*/true);
+      router.route(block, sources);
+      numSwaps[trial] = router.getNumSwaps();
+      depths[trial] = router.getDepth();
+    });
+
+    using Cost = std::pair<std::size_t, std::size_t>;
+    auto getCost = [&](std::size_t trial) -> Cost {
+      if (trialCost == "depth")
+        return {depths[trial], numSwaps[trial]};
+      return {numSwaps[trial], depths[trial]};
+    };
+    std::size_t best = 0;
+    for (std::size_t trial = 1; trial < numTrials; ++trial)
+      if (getCost(trial) < getCost(best))
+        best = trial;
+
+    for (std::size_t trial = 0; trial < numTrials; ++trial) {
+      LLVM_DEBUG(llvm::dbgs() << "mapping trial " << trial << ": "
+                              << numSwaps[trial] << " swaps, depth "
+                              << depths[trial] << '\n');
+      if (reportTrials)
+        func.emitRemark() << "mapping trial " << trial << ": "
+                          << numSwaps[trial] << " swaps, depth "
+                          << depths[trial];
+    }
+    if (reportTrials)
+      func.emitRemark() << "selected mapping trial " << best << ": "
+                        << numSwaps[best] << " swaps, depth " << depths[best];
+    return placements[best];
+  }
+
   /// Add `op` and all of its users into `opsToMoveToEnd`. `op` may not be
   /// nullptr.
   void addOpAndUsersToList(Operation *op,
@@ -858,13 +1130,25 @@ struct MappingFunc : public cudaq::opt::impl::MappingFuncBase<MappingFunc> {
     // Place
     Placement placement(sources.size(), deviceInstance->getNumQubits());
     identityPlacement(placement);
+    if (numTrials > 1)
+      placement = selectPlacement(func, block, sources, wireToVirtualQ);
 
     // Route
+    auto countSwaps = [&block]() -> std::size_t {
+      auto swaps = block.getOps<quake::SwapOp>();
+      return std::distance(swaps.begin(), swaps.end());
+    };
+    const std::size_t swapsBefore = reportTrials ? countSwaps() : 0;
     SabreRouter router(*deviceInstance, wireToVirtualQ, placement,
                        extendedLayerSize, extendedLayerWeight, decayDelta,
                        roundsDecayReset);
     router.route(*blocks.begin(), sources);
     sortTopologically(&block);
+    // Report the swaps actually inserted, to be compared with the cost of the
+    // selected trial.
+    if (reportTrials)
+      func.emitRemark() << "routed with " << countSwaps() - swapsBefore
+                        << " swaps";
 
     // Ensure that the original measurement ordering is still honored by moving
     // the measurements to the end (in their original order). Note that we must
@@ -961,6 +1245,10 @@ struct MappingPipelineOptions
   DECLARE_SUB_OPTION(MappingFuncOptions, extendedLayerWeight);
   DECLARE_SUB_OPTION(MappingFuncOptions, decayDelta);
   DECLARE_SUB_OPTION(MappingFuncOptions, roundsDecayReset);
+  DECLARE_SUB_OPTION(MappingFuncOptions, numTrials);
+  DECLARE_SUB_OPTION(MappingFuncOptions, trialSeed);
+  DECLARE_SUB_OPTION(MappingFuncOptions, trialCost);
+  DECLARE_SUB_OPTION(MappingFuncOptions, reportTrials);
   PassOptions::Option<bool> nonComposable{*this, "raise-fatal-errors"};
 };
 
@@ -988,6 +1276,10 @@ void registerMappingPipeline() {
         setIt(funcOpts.extendedLayerWeight, opt.extendedLayerWeight);
         setIt(funcOpts.decayDelta, opt.decayDelta);
         setIt(funcOpts.roundsDecayReset, opt.roundsDecayReset);
+        setIt(funcOpts.numTrials, opt.numTrials);
+        setIt(funcOpts.trialSeed, opt.trialSeed);
+        setIt(funcOpts.trialCost, opt.trialCost);
+        setIt(funcOpts.reportTrials, opt.reportTrials);
         setIt(funcOpts.nonComposable, opt.nonComposable);
         pm.addNestedPass<func::FuncOp>(cudaq::opt::createMappingFunc(funcOpts));
       });
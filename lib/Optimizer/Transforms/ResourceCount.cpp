@@ -16,9 +16,9 @@ using namespace mlir;
 
 mlir::FailureOr<cudaq::Resources>
 cudaq::opt::countResourcesFromIR(ModuleOp module) {
-  // Check upfront whether all qubit allocations have statically known sizes.
-  // If any veq has a dynamic size we cannot count qubits statically, so bail
-  // out before running the gate-erasing pass manager.
+  // Count the qubit allocations. If any veq has a dynamic size the number of
+  // qubits is left unset (zero) for the simulator to count at runtime, while
+  // the gates are still counted statically below.
   std::size_t allocated = 0;
   bool unresolvedVeq = false;
   module.walk([&](quake::AllocaOp alloc) {
@@ -30,17 +30,17 @@ cudaq::opt::countResourcesFromIR(ModuleOp module) {
       unresolvedVeq = true;
     }
   });
-  if (unresolvedVeq)
-    return failure();
 
-  // All qubit sizes are statically known — proceed to count gates and erase
-  // them from the IR so the subsequent JIT compiles a near-empty module.
+  // Count gates and erase them from the IR so the subsequent JIT compiles a
+  // near-empty module. Gates repeated by loops are counted in closed form.
   cudaq::Resources counts;
-  auto countGate = [&counts](std::string gate,
+  auto countGate = [&counts](std::string gate, std::size_t numControls,
                              std::vector<std::size_t> controls,
                              std::vector<std::size_t> targets, size_t count) {
-    for (size_t i = 0; i < count; i++)
-      counts.appendInstruction(gate, controls, targets);
+    if (controls.empty() && targets.empty())
+      counts.appendInstruction(gate, numControls, count);
+    else
+      counts.appendInstruction(gate, controls, targets, count);
   };
   ResourceCountPreprocessOptions opt{countGate};
   // The countGate callback captures &counts, a shared mutable Resources.
@@ -59,6 +59,7 @@ cudaq::opt::countResourcesFromIR(ModuleOp module) {
   if (failed(pmResult))
     return failure();
 
-  counts.setNumQubits(allocated);
+  if (!unresolvedVeq)
+    counts.setNumQubits(allocated);
   return counts;
 }
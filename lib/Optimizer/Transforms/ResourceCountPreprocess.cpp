@@ -31,35 +31,203 @@ namespace cudaq::opt {
 #include "cudaq/Optimizer/Transforms/Passes.h.inc"
 } // namespace cudaq::opt
 
+/// Return the amount added to the induction of a monotonic loop by each
+/// iteration, or std::nullopt if it is not a compile-time constant.
+static std::optional<std::int64_t>
+getStep(const cudaq::opt::LoopComponents &comp) {
+  auto stepOpt = cudaq::opt::factory::maybeValueOfIntConstant(comp.stepValue);
+  if (!stepOpt)
+    return std::nullopt;
+  // The step is a signed delta, whatever the signedness of the comparison.
+  auto stepWidth = cast<IntegerType>(comp.stepValue.getType()).getWidth();
+  std::int64_t step = llvm::SignExtend64(*stepOpt, stepWidth);
+  return comp.stepIsAnAddOp() ? step : -step;
+}
+
+/// Return the number of times a monotonic loop runs its body, or std::nullopt
+/// if it is not a compile-time constant. Loops counting up must be bounded by
+/// `<`, `<=` or `!=`, loops counting down by `>`, `>=` or `!=`, with the
+/// induction on the left-hand side of the comparison. A `!=` bound is only
+/// trusted with a unit step, since a larger step may jump over it.
+static std::optional<std::size_t>
+getTripCount(const cudaq::opt::LoopComponents &comp) {
+  auto cmp = cast<arith::CmpIOp>(comp.compareOp);
+  if (cmp.getRhs() != comp.compareValue || comp.hasAlwaysTrueCondition())
+    return std::nullopt;
+  auto stepOpt = getStep(comp);
+  if (!stepOpt || *stepOpt == 0)
+    return std::nullopt;
+  std::int64_t step = *stepOpt;
+
+  const bool countsUp = step > 0;
+  bool closed = false;
+  switch (cmp.getPredicate()) {
+  case arith::CmpIPredicate::ule:
+  case arith::CmpIPredicate::sle:
+    closed = true;
+    [[fallthrough]];
+  case arith::CmpIPredicate::ult:
+  case arith::CmpIPredicate::slt:
+    if (!countsUp)
+      return std::nullopt;
+    break;
+  case arith::CmpIPredicate::uge:
+  case arith::CmpIPredicate::sge:
+    closed = true;
+    [[fallthrough]];
+  case arith::CmpIPredicate::ugt:
+  case arith::CmpIPredicate::sgt:
+    if (countsUp || comp.isLinearExpr())
+      return std::nullopt;
+    break;
+  case arith::CmpIPredicate::ne:
+    if ((step != 1 && step != -1) || comp.isLinearExpr())
+      return std::nullopt;
+    break;
+  default:
+    return std::nullopt;
+  }
+
+  // getIterationsConstant folds a linear expression of the induction into the
+  // bounds, for loops counting up towards a `<` or `<=` bound.
+  if (comp.isLinearExpr()) {
+    if (comp.minusOneMult)
+      return std::nullopt;
+    return comp.getIterationsConstant();
+  }
+
+  auto initOpt =
+      cudaq::opt::factory::maybeValueOfIntConstant(comp.initialValue);
+  auto endOpt = cudaq::opt::factory::maybeValueOfIntConstant(comp.compareValue);
+  if (!initOpt || !endOpt)
+    return std::nullopt;
+  auto extend = [&](Value v, std::uint64_t val) {
+    return comp.extendValue(cast<IntegerType>(v.getType()).getWidth(), val);
+  };
+  std::int64_t init = extend(comp.initialValue, *initOpt);
+  std::int64_t end = extend(comp.compareValue, *endOpt);
+
+  // Distance from the start to the bound, in the direction of the step.
+  std::int64_t distance = countsUp ? end - init : init - end;
+  std::int64_t stride = countsUp ? step : -step;
+  if (cmp.getPredicate() == arith::CmpIPredicate::ne) {
+    if (distance < 0)
+      return std::nullopt;
+    return distance;
+  }
+  if (closed)
+    return distance < 0 ? 0 : distance / stride + 1;
+  return distance <= 0 ? 0 : (distance - 1) / stride + 1;
+}
+
+/// Is \p v an integer computed from \p induction?
+static bool dependsOnInduction(Value v, Value induction) {
+  if (v == induction)
+    return true;
+  auto *op = v.getDefiningOp();
+  if (!isa_and_nonnull<arith::AddIOp, arith::SubIOp, arith::MulIOp,
+                       arith::ExtSIOp, arith::ExtUIOp, arith::TruncIOp,
+                       cudaq::cc::CastOp>(op))
+    return false;
+  return llvm::any_of(op->getOperands(), [&](Value operand) {
+    return dependsOnInduction(operand, induction);
+  });
+}
+
 struct ResourceCountPreprocessPass
     : public cudaq::opt::impl::ResourceCountPreprocessBase<
           ResourceCountPreprocessPass> {
   using ResourceCountPreprocessBase::ResourceCountPreprocessBase;
+
+  /// The induction of an enclosing loop with a constant trip count.
+  struct Induction {
+    Value value;
+    std::int64_t initial;
+    std::int64_t step;
+    std::size_t iterations;
+  };
+
+  /// The control and target qubits of a gate in one iteration.
+  using Placement =
+      std::pair<std::vector<std::size_t>, std::vector<std::size_t>>;
+
+  /// Gates indexed by the inductions of more loop iterations than this are
+  /// counted without their qubit indices.
+  static constexpr std::size_t maxPlacements = 4096;
+
   SetVector<Operation *> to_erase;
   DenseMap<Value, std::size_t> qubitIndexMap;
   std::size_t nextQubitIndex = 0;
+  // Qubits allocated after a veq of unknown size cannot be numbered as the
+  // simulator numbers them.
+  bool unnumberedQubits = false;
+  SmallVector<Induction> inductions;
+  DenseMap<Value, std::int64_t> inductionValues;
 
   /// Assign a base qubit index for a qvector Value. For sized veqs, advances
-  /// nextQubitIndex by the veq size so each qubit gets a unique index. For
-  /// unsized veqs, the base index is shared (nextQubitIndex is not advanced)
-  /// since individual qubits cannot be resolved.
-  std::size_t getVeqBase(Value veq) {
+  /// nextQubitIndex by the veq size so each qubit gets a unique index. An
+  /// unsized veq gets a base index, but the qubits allocated after it do not.
+  std::optional<std::size_t> getVeqBase(Value veq) {
     auto it = qubitIndexMap.find(veq);
     if (it != qubitIndexMap.end())
       return it->second;
+    if (unnumberedQubits)
+      return std::nullopt;
     auto base = nextQubitIndex;
     if (auto size = quake::getVeqSize(veq))
       nextQubitIndex += *size;
+    else
+      unnumberedQubits = true;
     qubitIndexMap[veq] = base;
     return base;
   }
 
+  /// Evaluate an integer that is a constant or computed from the inductions
+  /// in inductionValues.
+  std::optional<std::int64_t> evaluateIndex(Value v) {
+    if (auto it = inductionValues.find(v); it != inductionValues.end())
+      return it->second;
+    if (auto c = cudaq::opt::factory::maybeValueOfIntConstant(v)) {
+      if (auto intTy = dyn_cast<IntegerType>(v.getType()))
+        return llvm::SignExtend64(*c, intTy.getWidth());
+      return static_cast<std::int64_t>(*c);
+    }
+    auto *op = v.getDefiningOp();
+    if (!op)
+      return std::nullopt;
+    if (isa<arith::ExtSIOp, arith::ExtUIOp, arith::TruncIOp,
+            cudaq::cc::CastOp>(op))
+      return evaluateIndex(op->getOperand(0));
+    if (!isa<arith::AddIOp, arith::SubIOp, arith::MulIOp>(op))
+      return std::nullopt;
+    auto lhs = evaluateIndex(op->getOperand(0));
+    auto rhs = evaluateIndex(op->getOperand(1));
+    if (!lhs || !rhs)
+      return std::nullopt;
+    if (isa<arith::AddIOp>(op))
+      return *lhs + *rhs;
+    if (isa<arith::SubIOp>(op))
+      return *lhs - *rhs;
+    return *lhs * *rhs;
+  }
+
   /// Resolve a quake value to a globally unique qubit index.
   std::optional<std::size_t> resolveQubitIndex(Value v) {
     // extract_ref from a qvector: base offset + local index.
-    if (auto extractRef = v.getDefiningOp<quake::ExtractRefOp>())
+    if (auto extractRef = v.getDefiningOp<quake::ExtractRefOp>()) {
+      auto base = getVeqBase(extractRef.getVeq());
+      if (!base)
+        return std::nullopt;
       if (extractRef.hasConstantIndex())
-        return getVeqBase(extractRef.getVeq()) + extractRef.getConstantIndex();
+        return *base + extractRef.getConstantIndex();
+      auto index = evaluateIndex(extractRef.getIndex());
+      if (!index || *index < 0)
+        return std::nullopt;
+      if (auto size = quake::getVeqSize(extractRef.getVeq()))
+        if (static_cast<std::size_t>(*index) >= *size)
+          return std::nullopt;
+      return *base + *index;
+    }
     // Wire semantics: concrete physical index from routing.
     if (auto borrow = v.getDefiningOp<quake::BorrowWireOp>())
       return static_cast<std::size_t>(borrow.getIdentity());
@@ -69,6 +237,8 @@ struct ResourceCountPreprocessPass
       auto it = qubitIndexMap.find(v);
       if (it != qubitIndexMap.end())
         return it->second;
+      if (unnumberedQubits)
+        return std::nullopt;
       auto idx = nextQubitIndex++;
       qubitIndexMap[v] = idx;
       return idx;
@@ -76,6 +246,63 @@ struct ResourceCountPreprocessPass
     return std::nullopt;
   }
 
+  bool resolveQubitIndices(ArrayRef<Value> qubits,
+                           std::vector<std::size_t> &indices) {
+    for (auto qubit : qubits) {
+      auto idx = resolveQubitIndex(qubit);
+      if (!idx)
+        return false;
+      indices.push_back(*idx);
+    }
+    return true;
+  }
+
+  /// Resolve the qubits of a gate in each iteration of the enclosing loops
+  /// that its qubit indices depend on, such as `h(q[i])` in a loop over `i`.
+  /// Returns false if a qubit cannot be resolved or if there are more than
+  /// maxPlacements iterations to list.
+  bool resolvePlacements(ArrayRef<Value> controls, ArrayRef<Value> targets,
+                         SmallVectorImpl<Placement> &placements) {
+    SmallVector<Value> indices;
+    for (auto qubit : llvm::concat<const Value>(controls, targets))
+      if (auto extractRef = qubit.getDefiningOp<quake::ExtractRefOp>())
+        if (!extractRef.hasConstantIndex())
+          indices.push_back(extractRef.getIndex());
+
+    SmallVector<const Induction *> used;
+    std::size_t numPlacements = 1;
+    for (auto &induction : inductions) {
+      if (llvm::none_of(indices, [&](Value index) {
+            return dependsOnInduction(index, induction.value);
+          }))
+        continue;
+      if (induction.iterations == 0 ||
+          induction.iterations > maxPlacements / numPlacements)
+        return false;
+      used.push_back(&induction);
+      numPlacements *= induction.iterations;
+    }
+
+    bool resolved = true;
+    for (std::size_t n = 0; resolved && n < numPlacements; ++n) {
+      // Split the placement number into one iteration of each loop.
+      std::size_t rest = n;
+      for (auto *induction : used) {
+        std::int64_t iteration = rest % induction->iterations;
+        inductionValues[induction->value] =
+            induction->initial + iteration * induction->step;
+        rest /= induction->iterations;
+      }
+      Placement placement;
+      resolved = resolveQubitIndices(controls, placement.first) &&
+                 resolveQubitIndices(targets, placement.second);
+      placements.push_back(std::move(placement));
+    }
+    for (auto *induction : used)
+      inductionValues.erase(induction->value);
+    return resolved;
+  }
+
   bool preCount(Operation *op, size_t to_add) {
     if (!isQuakeOperation(op))
       return false;
@@ -91,43 +318,42 @@ struct ResourceCountPreprocessPass
 
     auto name = op->getName().stripDialect();
 
-    std::vector<std::size_t> controlIndices, targetIndices;
-    bool allResolved = true;
-
-    // Resolve qubit indices. Operands may be ref (single qubit) or veq
-    // (e.g. from ConcatOp when Python passes a list of controls).
-    auto resolveOperands = [&](auto operands, std::vector<std::size_t> &out) {
+    // Operands may be ref (single qubit) or veq (e.g. from ConcatOp when
+    // Python passes a list of controls).
+    auto qubitOperands = [](auto operands) {
+      SmallVector<Value> qubits;
       for (auto val : operands) {
-        if (auto concat = val.template getDefiningOp<quake::ConcatOp>()) {
-          for (auto operand : concat.getTargets()) {
-            if (auto idx = resolveQubitIndex(operand))
-              out.push_back(*idx);
-            else
-              allResolved = false;
-          }
-        } else if (auto idx = resolveQubitIndex(val)) {
-          out.push_back(*idx);
-        } else {
-          allResolved = false;
-        }
+        if (auto concat = val.template getDefiningOp<quake::ConcatOp>())
+          qubits.append(concat.getTargets().begin(),
+                        concat.getTargets().end());
+        else
+          qubits.push_back(val);
       }
+      return qubits;
     };
-    resolveOperands(opi.getControls(), controlIndices);
-    resolveOperands(opi.getTargets(), targetIndices);
-
-    // If not all qubit indices resolved, use operand counts for the gate
-    // classification but skip depth tracking (indices are unreliable).
-    if (!allResolved) {
-      controlIndices.clear();
-      targetIndices.clear();
-    }
+    auto controls = qubitOperands(opi.getControls());
+    auto targets = qubitOperands(opi.getTargets());
+
+    // If not all qubit indices resolve, count the gate but skip depth tracking
+    // (indices are unreliable).
+    SmallVector<Placement> placements;
+    if (!resolvePlacements(controls, targets, placements))
+      placements.clear();
 
     if (dumpPreprocessed)
       llvm::outs() << "Preprocessing " << name << "("
                    << opi.getControls().size() << ")"
                    << " for " << to_add << " counts\n";
 
-    countGate(name.str(), controlIndices, targetIndices, to_add);
+    if (placements.empty()) {
+      countGate(name.str(), controls.size(), {}, {}, to_add);
+    } else {
+      // Every placement is repeated by the loops its qubits do not depend on.
+      auto repeats = to_add / placements.size();
+      for (auto &[controlIndices, targetIndices] : placements)
+        countGate(name.str(), controls.size(), controlIndices, targetIndices,
+                  repeats);
+    }
     to_erase.insert(op);
     return true;
   }
@@ -137,22 +363,40 @@ struct ResourceCountPreprocessPass
       return;
 
     if (auto loop = dyn_cast<cudaq::cc::LoopOp>(op)) {
+      // A monotonic loop without early exits runs its body a fixed number of
+      // times, which is known here when the bounds and step are constants.
       cudaq::opt::LoopComponents comp;
-      if (cudaq::opt::isaInvariantLoop(loop, true, false, &comp)) {
-        auto loopSize = comp.getIterationsConstant();
+      if (cudaq::opt::isaMonotonicLoop(loop, /*allowEarlyExit=*/false,
+                                       &comp)) {
+        auto loopSize = getTripCount(comp);
         if (!loopSize.has_value())
           return;
         auto iterations = loopSize.value();
+        // Keep the values taken by the induction, for the qubit indices that
+        // depend on it.
+        auto initial =
+            cudaq::opt::factory::maybeValueOfIntConstant(comp.initialValue);
+        auto step = getStep(comp);
+        const bool knownInduction = initial && step;
+        if (knownInduction) {
+          auto width =
+              cast<IntegerType>(comp.initialValue.getType()).getWidth();
+          inductions.push_back({loop.getDoEntryArguments()[comp.induction],
+                                comp.extendValue(width, *initial), *step,
+                                iterations});
+        }
         for (auto &b : loop.getBodyRegion().getBlocks())
           for (auto &op : b.getOperations())
             preprocessOp(&op, to_add * iterations);
+        if (knownInduction)
+          inductions.pop_back();
       }
     } else if (auto ifop = dyn_cast<cudaq::cc::IfOp>(op)) {
-      auto cond = ifop.getCondition();
-      auto defop = cond.getDefiningOp();
-      if (auto cop = dyn_cast<mlir::arith::ConstantOp>(defop)) {
+      auto cop = ifop.getCondition().getDefiningOp<mlir::arith::ConstantOp>();
+      if (cop) {
         if (auto value = dyn_cast<BoolAttr>(cop.getValue())) {
-          auto &region = value ? ifop.getThenRegion() : ifop.getElseRegion();
+          auto &region =
+              value.getValue() ? ifop.getThenRegion() : ifop.getElseRegion();
           for (auto &b : region.getBlocks())
             for (auto &op : b.getOperations())
               preprocessOp(&op, to_add);
@@ -164,6 +408,18 @@ struct ResourceCountPreprocessPass
   void runOnOperation() override {
     auto func = getOperation();
 
+    // Number the qubits in allocation order, as the simulator does, so that
+    // gates counted here and gates left for the simulator agree on the depth
+    // of each qubit.
+    if (!func.getBody().empty()) {
+      for (auto alloc : func.getBody().front().getOps<quake::AllocaOp>()) {
+        if (isa<quake::RefType>(alloc.getType()))
+          resolveQubitIndex(alloc.getResult());
+        else
+          getVeqBase(alloc.getResult());
+      }
+    }
+
     for (auto &b : func.getBody()) {
       // We only pre-process the main block as the other blocks may be
       // conditional when the IR is lowered to CFG.
@@ -178,5 +434,6 @@ struct ResourceCountPreprocessPass
     to_erase.clear();
     qubitIndexMap.clear();
     nextQubitIndex = 0;
+    unnumberedQubits = false;
   }
 };
@@ -8,6 +8,7 @@
 
 import ast
 import inspect
+import itertools
 import json
 import types
 from functools import wraps
@@ -35,6 +36,10 @@ from .utils import (emitFatalError, emitErrorIfInvalidPauli,
 # compilation infrastructure which maps the AST representation to an MLIR
 # representation and ultimately executable code.
 
+# Source of the keys that identify the module of each kernel decorator in the
+# runtime launch cache.
+_launch_cache_keys = itertools.count(1)
+
 
 def ensure_compiled(method):
     """
@@ -127,6 +132,7 @@ class PyKernelDecorator(object):
 
         self.location = location
         self.signature = signature
+        self.launchCacheKey = next(_launch_cache_keys)
         self.kernelModuleName = None
         self.name = kernelName
         self.verbose = verbose
@@ -621,10 +627,15 @@ class PyKernelDecorator(object):
         if args and self.formal_arity() != len(args):
             emitFatalError("wrong number of arguments provided")
 
-        processed_args, module = self.prepare_call(*args)
+        processed_args = self.process_call_arguments(*args)
+        processed_args.extend(self.resolve_captured_arguments())
 
-        result = cudaq_runtime.marshal_and_launch_module(
-            self.uniqName, module, *processed_args)
+        # The runtime launches a clone of `qkeModule`, or the kernel it has
+        # already compiled from it for the current target.
+        result = cudaq_runtime.launch_module_cached(self.uniqName,
+                                                    self.qkeModule,
+                                                    self.launchCacheKey,
+                                                    *processed_args)
         return result
 
     def beta_reduction(self, isEntryPoint, *args):
@@ -639,10 +650,13 @@ class PyKernelDecorator(object):
         passed to algorithms written in C++ that call back to these Python
         kernels in a functional composition.
         """
-        processed_args, module = self.prepare_call(*args, allow_no_args=True)
-        return cudaq_runtime.marshal_and_retain_module(self.uniqName, module,
-                                                       isEntryPoint,
-                                                       *processed_args)
+        processed_args = self.process_call_arguments(*args,
+                                                     allow_no_args=True)
+        processed_args.extend(self.resolve_captured_arguments())
+        return cudaq_runtime.retain_module_cached(self.uniqName,
+                                                  self.qkeModule,
+                                                  self.launchCacheKey,
+                                                  isEntryPoint, *processed_args)
 
     def process_argument(self, arg, arg_type):
         if isa_kernel_decorator(arg):
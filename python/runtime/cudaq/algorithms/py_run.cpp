@@ -207,7 +207,9 @@ run_async_impl(const std::string &shortName, MlirModule module,
           }
           platform.reset_noise();
         });
-    platform.enqueueAsyncTask(qpu_id, wrapped);
+    // The task resets the noise model of the QPU, so it must not run
+    // concurrently with other tasks on that QPU.
+    platform.enqueueAsyncTask(qpu_id, wrapped, /*ordered=*/true);
   }
 
   // Convert results after the span is computed.
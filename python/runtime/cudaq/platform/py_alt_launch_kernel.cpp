@@ -10,12 +10,14 @@
 #include "common/AnalogHamiltonian.h"
 #include "common/ArgumentWrapper.h"
 #include "common/Environment.h"
+#include "common/RuntimeTarget.h"
 #include "cudaq/Optimizer/Builder/Marshal.h"
 #include "cudaq/Optimizer/Builder/Runtime.h"
 #include "cudaq/Optimizer/CAPI/Dialects.h"
 #include "cudaq/Optimizer/CodeGen/OpenQASMEmitter.h"
 #include "cudaq/Optimizer/CodeGen/OptUtils.h"
 #include "cudaq/Optimizer/CodeGen/Passes.h"
+#include "cudaq/Optimizer/Transforms/AddMetadata.h"
 #include "cudaq/Optimizer/Transforms/Passes.h"
 #include "cudaq/platform.h"
 #include "cudaq/platform/qpu.h"
@@ -40,7 +42,9 @@
 #include "mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h"
 #include "mlir/Target/LLVMIR/Export.h"
 #include "mlir/Transforms/Passes.h"
+#include <deque>
 #include <fmt/core.h>
+#include <mutex>
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
 #include <nanobind/stl/complex.h>
@@ -50,6 +54,7 @@
 #include <nanobind/stl/pair.h>
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/vector.h>
+#include <tuple>
 
 using namespace mlir;
 using namespace cudaq_internal::compiler;
@@ -948,6 +953,296 @@ marshal_and_retain_module(const std::string &name, MlirModule module,
   return compiled;
 }
 
+//===----------------------------------------------------------------------===//
+// Launch cache
+//===----------------------------------------------------------------------===//
+//
+// On a local simulator, a kernel launched as an entry point unpacks its
+// arguments at run time, with its `argsCreator`, so that its JIT compiled code
+// does not depend on the argument values. The compiled kernel is therefore
+// cached per kernel and target, along with a plan to pack the Python arguments
+// of its signature. Calls that hit the cache go from the Python arguments
+// straight to the compiled code, without cloning, specializing or lowering the
+// module.
+
+namespace {
+/// How one Python argument is packed for the `argsCreator` of a kernel.
+struct ArgPackingStep {
+  enum class Kind { Float64, Float32, Bool, Int64, Generic };
+  Kind kind;
+  /// The argument type, packed by `packArgs` for `Kind::Generic`.
+  Type type;
+};
+
+/// A kernel compiled for a target, and what is needed to call it.
+struct LaunchCacheEntry {
+  cudaq::CompiledModule compiled;
+  std::vector<ArgPackingStep> plan;
+  bool hasGenericSteps = false;
+  Type resultType;
+  std::size_t resultBufferSize = 0;
+  bool isRunContext = false;
+  bool hasConditionalsOnMeasure = false;
+};
+
+/// Compiled kernels, keyed on the launch cache key of the kernel decorator,
+/// the kernel name and the target. The oldest entries are dropped when the
+/// cache is full.
+class LaunchCache {
+public:
+  using Key = std::tuple<std::int64_t, std::string, std::string>;
+  static constexpr std::size_t maxEntries = 256;
+
+  std::shared_ptr<const LaunchCacheEntry> find(const Key &key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto iter = entries.find(key);
+    return iter == entries.end() ? nullptr : iter->second;
+  }
+
+  void insert(const Key &key, std::shared_ptr<const LaunchCacheEntry> entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entries.insert_or_assign(key, std::move(entry)).second)
+      order.push_back(key);
+    while (entries.size() > maxEntries) {
+      entries.erase(order.front());
+      order.pop_front();
+    }
+  }
+
+private:
+  std::mutex mutex;
+  std::map<Key, std::shared_ptr<const LaunchCacheEntry>> entries;
+  std::deque<Key> order;
+};
+} // namespace
+
+static LaunchCache &getLaunchCache() {
+  // Never destroyed: the cached JIT engines must not be torn down after LLVM
+  // at exit.
+  static auto *cache = new LaunchCache;
+  return *cache;
+}
+
+/// Return true if kernels launched in the current context may be served from,
+/// and added to, the launch cache. The compilation of a kernel depends on
+/// these settings in ways that the cached kernel does not capture.
+static bool canUseLaunchCache() {
+  static const bool enabled =
+      cudaq::getEnvBool("CUDAQ_PYTHON_LAUNCH_CACHE", true);
+  if (!enabled || cudaq::getEnvBool("CUDAQ_PYTHON_CODEGEN_DUMP", false))
+    return false;
+  if (cudaq::is_remote_platform() || cudaq::is_emulated_platform())
+    return false;
+  if (cudaq::compiler_artifact::isPersistingJITEngine())
+    return false;
+  auto *ctx = cudaq::getExecutionContext();
+  return !ctx || (ctx->name != "resource-count" && !ctx->jitEng);
+}
+
+/// Identify the current target, including its `set_target` options.
+static std::string getLaunchCacheTarget() {
+  const auto *target = cudaq::get_platform().get_runtime_target();
+  if (!target)
+    return {};
+  std::string key = target->name + '\n' + target->simulatorName + '\n' +
+                    target->platformName;
+  for (const auto &[option, value] : target->runtimeConfig)
+    key += '\n' + option + '=' + value;
+  return key;
+}
+
+/// Decide how to pack each argument of \p kernelFunc. Returns `std::nullopt`
+/// if the kernel cannot be cached: callable arguments are merged into the
+/// module when it is launched, so the compiled code depends on them.
+static std::optional<std::vector<ArgPackingStep>>
+makeArgPackingPlan(func::FuncOp kernelFunc) {
+  using Kind = ArgPackingStep::Kind;
+  std::vector<ArgPackingStep> plan;
+  for (Type ty : kernelFunc.getFunctionType().getInputs()) {
+    if (isa<Float64Type>(ty))
+      plan.push_back({Kind::Float64, ty});
+    else if (isa<Float32Type>(ty))
+      plan.push_back({Kind::Float32, ty});
+    else if (ty.isInteger(1))
+      plan.push_back({Kind::Bool, ty});
+    else if (isa<IntegerType>(ty))
+      plan.push_back({Kind::Int64, ty});
+    else if (isa<ComplexType, cc::CharspanType, cc::PointerType,
+                 cc::StructType, cc::StdvecType>(ty))
+      plan.push_back({Kind::Generic, ty});
+    else
+      return std::nullopt;
+  }
+  return plan;
+}
+
+/// Pack \p runtimeArgs as `packArgs<PackingStyle::argsCreator>` does, following
+/// the plan of \p entry, and append the result buffer.
+static void packWithPlan(cudaq::OpaqueArguments &args,
+                         const LaunchCacheEntry &entry, ModuleOp mod,
+                         const std::string &name, nanobind::args runtimeArgs) {
+  using Kind = ArgPackingStep::Kind;
+  using BoolArg = cudaq::BoolVecElem<PackingStyle::argsCreator>;
+  if (runtimeArgs.size() != entry.plan.size())
+    throw std::runtime_error("Invalid runtime arguments - kernel expected " +
+                             std::to_string(entry.plan.size()) +
+                             " but was provided " +
+                             std::to_string(runtimeArgs.size()) +
+                             " arguments.");
+  func::FuncOp kernelFunc;
+  if (entry.hasGenericSteps)
+    kernelFunc = cudaq::getKernelFuncOp(mod, name);
+  auto noBackup = [](cudaq::OpaqueArguments &, nanobind::object &, unsigned) {
+    return false;
+  };
+
+  for (auto [i, h] : llvm::enumerate(runtimeArgs)) {
+    auto arg = nanobind::borrow<nanobind::object>(h);
+    if (arg.is_none()) {
+      args.emplace_back(nullptr, [](void *ptr) {});
+      continue;
+    }
+    const auto &step = entry.plan[i];
+    switch (step.kind) {
+    case Kind::Float64:
+      cudaq::checkArgumentType<py_ext::Float>(arg, i);
+      cudaq::addArgument(args, nanobind::cast<double>(arg));
+      break;
+    case Kind::Float32:
+      cudaq::checkArgumentType<py_ext::Float>(arg, i);
+      cudaq::addArgument(args, nanobind::cast<float>(arg));
+      break;
+    case Kind::Bool:
+      cudaq::checkArgumentType<nanobind::bool_>(arg, i);
+      cudaq::addArgument(args, static_cast<BoolArg>(nanobind::cast<bool>(arg)));
+      break;
+    case Kind::Int64:
+      cudaq::checkArgumentType<py_ext::Int>(arg, i);
+      cudaq::addArgument(args, nanobind::cast<std::int64_t>(arg));
+      break;
+    case Kind::Generic: {
+      nanobind::list single;
+      single.append(arg);
+      cudaq::packArgs<PackingStyle::argsCreator>(args, single, step.type,
+                                                 noBackup, kernelFunc);
+      break;
+    }
+    }
+  }
+
+  if (entry.resultBufferSize)
+    args.emplace_back(std::calloc(1, entry.resultBufferSize),
+                      [](void *ptr) { std::free(ptr); });
+}
+
+static bool hasConditionalsOnMeasure(ModuleOp module) {
+  for (auto &artifact : module) {
+    quake::detail::QuakeFunctionAnalysis analysis{&artifact};
+    if (analysis.getAnalysisInfo().lookup(&artifact).hasConditionalsOnMeasure)
+      return true;
+  }
+  return false;
+}
+
+/// Pack \p runtimeArgs into \p args, for a launch of the kernel \p name of
+/// \p mod as an entry point, and return its launch cache entry. On a miss, the
+/// kernel is compiled from a clone of \p mod and added to the cache. Returns
+/// `nullptr`, without packing, if the kernel cannot be cached.
+static std::shared_ptr<const LaunchCacheEntry>
+packForLaunchCache(const std::string &name, ModuleOp mod,
+                   std::int64_t cacheKey, nanobind::args runtimeArgs,
+                   cudaq::OpaqueArguments &args) {
+  if (!canUseLaunchCache())
+    return nullptr;
+
+  const bool isRunContext = mod->hasAttr(cudaq::runtime::enableCudaqRun);
+  const LaunchCache::Key key{cacheKey, name, getLaunchCacheTarget()};
+  if (auto entry = getLaunchCache().find(key)) {
+    if (entry->isRunContext == isRunContext) {
+      packWithPlan(args, *entry, mod, name, runtimeArgs);
+      if (entry->hasConditionalsOnMeasure)
+        if (auto *ctx = cudaq::getExecutionContext())
+          ctx->hasConditionalsOnMeasureResults = true;
+      return entry;
+    }
+  }
+
+  auto kernelFunc = cudaq::getKernelFuncOp(mod, name);
+  auto plan = makeArgPackingPlan(kernelFunc);
+  if (!plan)
+    return nullptr;
+
+  ScopedTraceWithContext("packForLaunchCache::compile", name);
+  Type retTy = cudaq::runtime::getReturnType(kernelFunc);
+  auto clone = mod.clone();
+  args = cudaq::marshal_arguments_for_module_launch(
+      clone, runtimeArgs, cudaq::getKernelFuncOp(clone, name));
+  const auto &rawArgs = appendResultToArgsVector(args, retTy, clone, name);
+  const bool hasConditionals = hasConditionalsOnMeasure(clone);
+  auto compiled = cudaq::streamlinedSpecializeModule(name, clone, rawArgs,
+                                                     /*isEntryPoint=*/true);
+  clone.erase();
+
+  const bool hasGenericSteps =
+      llvm::any_of(*plan, [](const ArgPackingStep &step) {
+        return step.kind == ArgPackingStep::Kind::Generic;
+      });
+  std::size_t resultBufferSize = 0;
+  if (retTy)
+    resultBufferSize = getResultBufferLayout(mod, retTy).first;
+  auto entry = std::make_shared<const LaunchCacheEntry>(LaunchCacheEntry{
+      std::move(compiled), std::move(*plan), hasGenericSteps, retTy,
+      resultBufferSize, isRunContext, hasConditionals});
+  getLaunchCache().insert(key, entry);
+  return entry;
+}
+
+/// Launch the kernel \p name of the kernel decorator module \p module, which
+/// is not modified. \p cacheKey identifies the module in the launch cache.
+static nanobind::object launch_module_cached(const std::string &name,
+                                             MlirModule module,
+                                             std::int64_t cacheKey,
+                                             nanobind::args runtimeArgs) {
+  ScopedTraceWithContext("launch_module_cached", name);
+  auto mod = unwrap(module);
+  cudaq::OpaqueArguments args;
+  auto entry = packForLaunchCache(name, mod, cacheKey, runtimeArgs, args);
+  if (!entry) {
+    auto clone = mod.clone();
+    auto result =
+        cudaq::marshal_and_launch_module(name, wrap(clone), runtimeArgs);
+    clone.erase();
+    return result;
+  }
+
+  [[maybe_unused]] auto resultPtr =
+      cudaq::streamlinedLaunchCompiledModule(entry->compiled, args.getArgs());
+  if (!entry->resultType)
+    return nanobind::none();
+  return cudaq::convertResult(
+      mod, entry->resultType, reinterpret_cast<char *>(args.getArgs().back()));
+}
+
+/// Compile the kernel \p name of the kernel decorator module \p module, which
+/// is not modified. Entry points are served from the launch cache.
+static cudaq::CompiledModule
+retain_module_cached(const std::string &name, MlirModule module,
+                     std::int64_t cacheKey, bool isEntryPoint,
+                     nanobind::args runtimeArgs) {
+  ScopedTraceWithContext("retain_module_cached", name);
+  auto mod = unwrap(module);
+  if (isEntryPoint) {
+    cudaq::OpaqueArguments args;
+    if (auto entry = packForLaunchCache(name, mod, cacheKey, runtimeArgs, args))
+      return entry->compiled;
+  }
+  auto clone = mod.clone();
+  auto compiled = marshal_and_retain_module(name, wrap(clone), isEntryPoint,
+                                            runtimeArgs);
+  clone.erase();
+  return compiled;
+}
+
 static MlirModule synthesizeKernel(nanobind::object kernel,
                                    nanobind::args runtimeArgs) {
   auto module = nanobind::cast<MlirModule>(kernel.attr("qkeModule"));
@@ -1161,6 +1456,14 @@ void cudaq::bindAltLaunchKernel(nanobind::module_ &mod,
   mod.def("marshal_and_retain_module", marshal_and_retain_module,
           "Compile (specialize + JIT) a kernel module. Returns a "
           "CompiledModule object that owns the JIT engine.");
+  mod.def("launch_module_cached", launch_module_cached,
+          "Launch a kernel of a kernel decorator module, without modifying "
+          "it. Entry points compiled for the current target are cached, so "
+          "that repeated launches skip MLIR compilation.");
+  mod.def("retain_module_cached", retain_module_cached,
+          "Compile (specialize + JIT) a kernel of a kernel decorator module, "
+          "without modifying it. Entry points are served from the launch "
+          "cache.");
   mod.def("pyAltLaunchAnalogKernel", pyAltLaunchAnalogKernel,
           "Launch an analog Hamiltonian simulation kernel with given JSON "
           "payload.");
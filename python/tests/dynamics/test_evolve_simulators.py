@@ -8,6 +8,8 @@
 
 import os
 import pytest
+import subprocess
+import sys
 import cudaq
 from cudaq.operators import *
 from cudaq.dynamics import *
@@ -460,6 +462,52 @@ def test_evolve_async_no_intermediate_results():
     assert final_exp_decay[0][1].expectation() != final_exp[0][1].expectation()
 
 
+def test_evolve_async_noise_concurrent():
+    """Noisy and ideal evolve_async tasks running concurrently on the default
+    QPU (CUDAQ_ASYNC_THREADS > 1) must each use their own noise model."""
+    code = """
+import cudaq
+import numpy as np
+from cudaq import spin
+from cudaq.dynamics import Schedule
+
+cudaq.set_target("density-matrix-cpu")
+hamiltonian = 2 * np.pi * 0.1 * spin.x(0)
+rho0 = cudaq.State.from_data(
+    np.array([[1.0, 0.0], [0.0, 0.0]], dtype=np.complex128))
+
+
+def launch(noisy):
+    return cudaq.evolve_async(
+        hamiltonian, {0: 2},
+        Schedule(np.linspace(0, 10, 101), ["time"]),
+        rho0,
+        observables=[spin.z(0)],
+        collapse_operators=[np.sqrt(0.05) * spin.x(0)] if noisy else [],
+        store_intermediate_results=cudaq.IntermediateResultSave.NONE)
+
+
+def final_z(future):
+    return future.get().expectation_values()[0][0].expectation()
+
+
+expected = {noisy: final_z(launch(noisy)) for noisy in (False, True)}
+assert abs(expected[True] - expected[False]) > 1e-2
+pattern = [i % 2 == 0 for i in range(8)]
+futures = [launch(noisy) for noisy in pattern]
+for noisy, future in zip(pattern, futures):
+    np.testing.assert_allclose(final_z(future), expected[noisy], atol=1e-8)
+"""
+    result = subprocess.run([sys.executable, '-c', code],
+                            capture_output=True,
+                            text=True,
+                            env={
+                                **os.environ, 'CUDAQ_ASYNC_THREADS': '4'
+                            })
+    if result.returncode != 0:
+        pytest.fail(f"Subprocess failed:\n{result.stderr}")
+
+
 def test_final_expectation_values_without_observables():
     """Test that final_expectation_values returns None instead of crashing
     when evolve is called without observables."""
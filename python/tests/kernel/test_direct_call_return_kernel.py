@@ -670,6 +670,40 @@ def test_run_errors():
     assert 'Invalid number of arguments passed to run' in repr(e)
 
 
+def test_repeated_calls():
+
+    @cudaq.kernel
+    def scaled(theta: float, count: int, flip: bool,
+               weights: list[float]) -> float:
+        q = cudaq.qubit()
+        ry(theta, q)
+        total = 0.0
+        for w in weights:
+            total += w
+        if flip:
+            total = -total
+        return total * count
+
+    # Every call after the first is served by the compiled kernel cached by the
+    # runtime. The arguments must still be packed anew for each call.
+    for i in range(20):
+        weights = [0.5 * k for k in range(1 + i % 4)]
+        expected = sum(weights) * i * (-1 if i % 2 else 1)
+        assert is_close(scaled(0.1 * i, i, i % 2 == 1, weights), expected)
+
+    @cudaq.kernel
+    def measured(flip: bool) -> bool:
+        q = cudaq.qubit()
+        if flip:
+            x(q)
+        return mz(q)
+
+    for i in range(10):
+        assert measured(i % 2 == 1) == (i % 2 == 1)
+    assert cudaq.run(measured, True, shots_count=5) == [True] * 5
+    assert measured(False) == False
+
+
 # leave for gdb debugging
 if __name__ == "__main__":
     loc = os.path.abspath(__file__)
@@ -0,0 +1,101 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cudaq {
+
+/// @brief A chunk of bit-packed detection events and logical observable flips.
+///
+/// The chunk covers `chunkShots` shots starting at `firstShot`, of which the
+/// first `numShots` are valid; the bits of the remaining (padding) shots are
+/// zero. `chunkShots` is a multiple of 64. The data holds `numDetectors` rows,
+/// followed by `numObservables` rows, of `chunkShots / 64` words each. Bit
+/// `s % 64` of word `s / 64` of a row is the value of that detector or
+/// observable in shot `firstShot + s`.
+struct detector_sample_batch {
+  std::size_t firstShot = 0;
+  std::size_t numShots = 0;
+  std::size_t chunkShots = 0;
+  std::size_t numDetectors = 0;
+  std::size_t numObservables = 0;
+  const std::uint64_t *data = nullptr;
+
+  std::size_t wordsPerRow() const { return chunkShots / 64; }
+  const std::uint64_t *detector(std::size_t d) const {
+    return data + d * wordsPerRow();
+  }
+  const std::uint64_t *observable(std::size_t o) const {
+    return data + (numDetectors + o) * wordsPerRow();
+  }
+};
+
+/// @brief Header of a detector sample file. The file holds the header followed
+/// by every chunk, in order, in the layout of `detector_sample_batch` (with
+/// the chunk size of the header), so that the file can be memory mapped and
+/// read chunk by chunk.
+struct detector_sample_file_header {
+  static constexpr char expectedMagic[8] = {'C', 'U', 'D', 'A',
+                                            'Q', 'D', 'E', 'T'};
+  static constexpr std::uint64_t currentVersion = 1;
+
+  char magic[8];
+  std::uint64_t version;
+  std::uint64_t numShots;
+  std::uint64_t chunkShots;
+  std::uint64_t numDetectors;
+  std::uint64_t numObservables;
+  std::uint64_t reserved[2];
+};
+static_assert(sizeof(detector_sample_file_header) == 64);
+
+/// @brief Options and results of the "detector_sample" execution context,
+/// supported by the `stim` backend.
+///
+/// The kernel is executed once to record its noisy Clifford circuit.
+/// Detectors and logical observables are then annotated on that circuit, each
+/// as the parity of a set of measurements, identified by their index in the
+/// order in which the kernel measured them. The annotated circuit and its
+/// detector error model are returned in the Stim text format, and, if
+/// `ExecutionContext::shots` is non-zero, that many shots of detection events
+/// and observable flips are streamed to `outputFile` and/or `callback` in
+/// chunks of `chunkShots` shots, without building any per-shot result.
+/// Detectors must be deterministic in the absence of noise.
+struct detector_sample_options {
+  /// Measurement indices of each detector.
+  std::vector<std::vector<std::size_t>> detectors;
+
+  /// Measurement indices of each logical observable.
+  std::vector<std::vector<std::size_t>> observables;
+
+  /// The number of shots simulated and delivered at a time, rounded up to a
+  /// multiple of 64.
+  std::size_t chunkShots = 1 << 16;
+
+  /// If not empty, the path of the memory-mapped file to write the samples
+  /// to.
+  std::string outputFile;
+
+  /// If set, called with every chunk of samples. The data is only valid for
+  /// the duration of the call.
+  std::function<void(const detector_sample_batch &)> callback;
+
+  /// Output: the executed circuit with its detector and observable
+  /// annotations, in the Stim circuit format.
+  std::string circuit;
+
+  /// Output: the detector error model of the circuit, in the Stim format.
+  std::string errorModel;
+};
+
+} // namespace cudaq
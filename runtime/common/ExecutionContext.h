@@ -9,6 +9,7 @@
 #pragma once
 
 #include "CompiledModule.h"
+#include "DetectorSample.h"
 #include "Future.h"
 #include "NoiseModel.h"
 #include "SampleResult.h"
@@ -155,6 +156,10 @@ public:
   /// https://arxiv.org/pdf/2407.13826.
   std::optional<std::pair<std::size_t, std::size_t>> msm_dimensions;
 
+  /// @brief Detector and observable annotations, sample sinks, and outputs of
+  /// the "detector_sample" execution context.
+  std::optional<detector_sample_options> detectorSample;
+
   bool allowJitEngineCaching = false;
 
   bool useParametricJit = false;
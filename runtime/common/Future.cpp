@@ -11,6 +11,8 @@
 #include "RestClient.h"
 #include "ServerHelper.h"
 #include "cudaq/runtime/logger/logger.h"
+#include <algorithm>
+#include <chrono>
 #include <thread>
 
 namespace cudaq::details {
@@ -24,41 +26,84 @@ sample_result future::get() {
   auto serverHelper = registry::get<ServerHelper>(qpuName);
   serverHelper->initialize(serverConfig);
   auto headers = serverHelper->getHeaders();
-  std::vector<ExecutionResult> results;
-  for (auto &id : jobs) {
-    CUDAQ_INFO("Future retrieving results for {}.", id.first);
 
-    auto jobGetPath = serverHelper->constructGetJobPath(id.first);
+  QirServerHelper *qirServerHelper = nullptr;
+  if (resultType == ExecutionContextType::run) {
+    qirServerHelper = dynamic_cast<QirServerHelper *>(serverHelper.get());
+    if (!qirServerHelper)
+      throw std::runtime_error("To support `run` API, " + qpuName +
+                               " must inherit `QirServerHelper` class");
+    if (!inFutureRawOutput)
+      throw std::runtime_error(
+          "cudaq::details::future::get() for 'run' requires a raw output "
+          "pointer but it was not provided.");
+  }
 
+  // Poll all the jobs from one loop sharing one client, so that the wait is
+  // bounded by the slowest job rather than the sum over all jobs. Each job is
+  // polled again after its own server-provided interval, and its results are
+  // decoded as soon as it is done, while the other jobs are still running.
+  // Only the first job's output is returned for `run`.
+  using clock = std::chrono::steady_clock;
+  struct PendingJob {
+    std::size_t index;
+    std::string path;
+    clock::time_point nextPoll;
+  };
+  const std::size_t numJobs = qirServerHelper
+                                  ? std::min<std::size_t>(jobs.size(), 1)
+                                  : jobs.size();
+  std::vector<PendingJob> pending;
+  for (std::size_t i = 0; i < numJobs; ++i) {
+    CUDAQ_INFO("Future retrieving results for {}.", jobs[i].first);
+    auto jobGetPath = serverHelper->constructGetJobPath(jobs[i].first);
     CUDAQ_INFO("Future got job retrieval path as {}.", jobGetPath);
-    auto resultResponse =
-        client.get(jobGetPath, "", headers, false, serverHelper->getCookies());
-    while (!serverHelper->jobIsDone(resultResponse)) {
-      auto polling_interval =
-          serverHelper->nextResultPollingInterval(resultResponse);
-      std::this_thread::sleep_for(polling_interval);
-      resultResponse = client.get(jobGetPath, "", headers, false,
-                                  serverHelper->getCookies());
-    }
+    pending.push_back({i, std::move(jobGetPath), clock::now()});
+  }
 
-    if (resultType == ExecutionContextType::run) {
-      QirServerHelper *qirServerHelper =
-          dynamic_cast<QirServerHelper *>(serverHelper.get());
-      if (!qirServerHelper)
-        throw std::runtime_error("To support `run` API, " + qpuName +
-                                 " must inherit `QirServerHelper` class");
-      if (!inFutureRawOutput)
-        throw std::runtime_error(
-            "cudaq::details::future::get() for 'run' requires a raw output "
-            "pointer but it was not provided.");
-
-      const auto qirOutputLog =
-          qirServerHelper->extractOutputLog(resultResponse, id.first);
-      inFutureRawOutput->assign(qirOutputLog.begin(), qirOutputLog.end());
-      return sample_result();
+  std::vector<sample_result> jobResults(numJobs);
+  while (!pending.empty()) {
+    auto nextPoll = clock::time_point::max();
+    for (auto iter = pending.begin(); iter != pending.end();) {
+      if (iter->nextPoll > clock::now()) {
+        nextPoll = std::min(nextPoll, iter->nextPoll);
+        ++iter;
+        continue;
+      }
+
+      auto resultResponse = client.get(iter->path, "", headers, false,
+                                       serverHelper->getCookies());
+      if (!serverHelper->jobIsDone(resultResponse)) {
+        iter->nextPoll =
+            clock::now() +
+            serverHelper->nextResultPollingInterval(resultResponse);
+        nextPoll = std::min(nextPoll, iter->nextPoll);
+        ++iter;
+        continue;
+      }
+
+      auto &jobId = jobs[iter->index].first;
+      if (qirServerHelper) {
+        const auto qirOutputLog =
+            qirServerHelper->extractOutputLog(resultResponse, jobId);
+        inFutureRawOutput->assign(qirOutputLog.begin(), qirOutputLog.end());
+      } else {
+        jobResults[iter->index] =
+            serverHelper->processResults(resultResponse, jobId);
+      }
+      iter = pending.erase(iter);
     }
 
-    auto c = serverHelper->processResults(resultResponse, id.first);
+    if (!pending.empty())
+      std::this_thread::sleep_until(nextPoll);
+  }
+
+  if (qirServerHelper)
+    return sample_result();
+
+  std::vector<ExecutionResult> results;
+  for (std::size_t i = 0; i < numJobs; ++i) {
+    auto &c = jobResults[i];
     if (c.has_expectation()) {
       // If the QPU returns the data with expectation values, just use it
       // directly.
@@ -68,7 +113,7 @@ sample_result future::get() {
     }
     if (isObserve()) {
       // Use the job name instead of the global register.
-      results.emplace_back(c.to_map(), id.second);
+      results.emplace_back(c.to_map(), jobs[i].second);
       results.back().sequentialData = c.sequential_data();
     } else {
       // For each register, add the results into result.
@@ -57,9 +57,9 @@ namespace cudaq {
 // Here, we capture full data (not just bit string statistics) since the remote
 // platform can populate simulator-only data, such as `expectationValue`.
 inline void to_json(json &j, const ExecutionResult &result) {
-  j = json{{"counts", result.counts},
+  j = json{{"counts", result.getCounts()},
            {"registerName", result.registerName},
-           {"sequentialData", result.sequentialData}};
+           {"sequentialData", result.getSequentialData()}};
   if (result.expectationValue.has_value())
     j["expectationValue"] = result.expectationValue.value();
 }
@@ -439,11 +439,17 @@ make_optimizer_from_json(const nlohmann::json &j,
 
 // ----- cudaq::gradient serialization/deserialization support below
 
-enum class GradientEnum { CENTRAL_DIFF, FORWARD_DIFF, PARAMETER_SHIFT };
+enum class GradientEnum {
+  CENTRAL_DIFF,
+  FORWARD_DIFF,
+  PARAMETER_SHIFT,
+  ADJOINT
+};
 NLOHMANN_JSON_SERIALIZE_ENUM(GradientEnum,
                              {JSON_ENUM(GradientEnum, CENTRAL_DIFF),
                               JSON_ENUM(GradientEnum, FORWARD_DIFF),
-                              JSON_ENUM(GradientEnum, PARAMETER_SHIFT)});
+                              JSON_ENUM(GradientEnum, PARAMETER_SHIFT),
+                              JSON_ENUM(GradientEnum, ADJOINT)});
 
 inline GradientEnum get_gradient_type(const cudaq::gradient &p) {
   if (dynamic_cast<const cudaq::gradients::central_difference *>(&p))
@@ -452,6 +458,8 @@ inline GradientEnum get_gradient_type(const cudaq::gradient &p) {
     return GradientEnum::FORWARD_DIFF;
   if (dynamic_cast<const cudaq::gradients::parameter_shift *>(&p))
     return GradientEnum::PARAMETER_SHIFT;
+  if (dynamic_cast<const cudaq::gradients::adjoint *>(&p))
+    return GradientEnum::ADJOINT;
   // This shouldn't happen, but handle it gracefully if it does.
   return GradientEnum::CENTRAL_DIFF;
 }
@@ -463,6 +471,11 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(cudaq::gradients::central_difference, step);
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(cudaq::gradients::forward_difference, step);
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(cudaq::gradients::parameter_shift,
                                    shiftScalar);
+// The adjoint gradient has no settings.
+inline void to_json(json &j, const cudaq::gradients::adjoint &) {
+  j = json::object();
+}
+inline void from_json(const json &, cudaq::gradients::adjoint &) {}
 
 inline void to_json(json &j, const cudaq::gradient &p) {
   if (auto *central_difference =
@@ -474,6 +487,8 @@ inline void to_json(json &j, const cudaq::gradient &p) {
   else if (auto *parameter_shift =
                dynamic_cast<const cudaq::gradients::parameter_shift *>(&p))
     j = json(*parameter_shift);
+  else if (auto *adjoint = dynamic_cast<const cudaq::gradients::adjoint *>(&p))
+    j = json(*adjoint);
 }
 
 inline std::unique_ptr<cudaq::gradient>
@@ -495,6 +510,11 @@ make_gradient_from_json(const nlohmann::json &j,
     from_json(j, *ret_ptr);
     return ret_ptr;
   }
+  case GradientEnum::ADJOINT: {
+    auto ret_ptr = std::make_unique<cudaq::gradients::adjoint>();
+    from_json(j, *ret_ptr);
+    return ret_ptr;
+  }
   }
   // This shouldn't happen, but handle it gracefully if it does.
   return std::make_unique<cudaq::gradients::central_difference>();
@@ -281,6 +281,7 @@ void noise_model::add_channel(const std::string &quantumOp,
         std::to_string(channelDim) + " on " + std::to_string(nQubits) +
         " qubits.");
 
+  resolvedChannels.clear();
   auto key = std::make_pair(quantumOp, qubits);
   auto iter = noiseModel.find(key);
   if (iter == noiseModel.end()) {
@@ -322,6 +323,7 @@ void noise_model::add_all_qubit_channel(const std::string &quantumOp,
       !isCustomOp)
     throw std::runtime_error(
         "Invalid quantum op for noise_model::add_channel (" + quantumOp + ").");
+  resolvedChannels.clear();
   GateIdentifier key(actualGateName, numControls);
   auto iter = defaultNoiseModel.find(key);
   if (iter == defaultNoiseModel.end()) {
@@ -350,6 +352,7 @@ void noise_model::add_channel(const std::string &quantumOp,
   if (iter == gatePredicates.end()) {
     CUDAQ_INFO("Adding new callback kraus_channel to noise_model for {}.",
                quantumOp);
+    resolvedChannels.clear();
     gatePredicates.insert({quantumOp, pred});
     return;
   }
@@ -429,6 +432,75 @@ noise_model::get_channels(const std::string &quantumOp,
   return resultChannels;
 }
 
+namespace {
+// Hash a get_channels_cached key.
+std::size_t hashChannelKey(std::string_view quantumOp,
+                           const std::vector<std::size_t> &controls,
+                           const std::vector<std::size_t> &targets,
+                           const std::vector<double> &params) {
+  auto hash = std::hash<std::string_view>{}(quantumOp);
+  const auto combine = [&](std::size_t value) {
+    hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  };
+  combine(controls.size());
+  for (auto q : controls)
+    combine(q);
+  for (auto q : targets)
+    combine(q);
+  for (auto p : params)
+    combine(std::hash<double>{}(p));
+  return hash;
+}
+} // namespace
+
+noise_model::channel_list
+noise_model::get_channels_cached(std::string_view quantumOp,
+                                 const std::vector<std::size_t> &targetQubits,
+                                 const std::vector<std::size_t> &controlQubits,
+                                 const std::vector<double> &params) const {
+  // Only callback channels depend on the gate parameters. Leaving them out of
+  // the key otherwise keeps parameterized circuits from adding one entry per
+  // angle.
+  static const std::vector<double> noParams;
+  const auto &keyParams = gatePredicates.empty() ? noParams : params;
+  const auto hash =
+      hashChannelKey(quantumOp, controlQubits, targetQubits, keyParams);
+  const auto matches = [&](const ResolvedChannelCache::Entry &entry) {
+    return entry.quantumOp == quantumOp && entry.controls == controlQubits &&
+           entry.targets == targetQubits && entry.params == keyParams;
+  };
+
+  {
+    std::lock_guard<std::mutex> lock(resolvedChannels.mutex);
+    auto iter = resolvedChannels.entries.find(hash);
+    if (iter != resolvedChannels.entries.end())
+      for (const auto &entry : iter->second)
+        if (matches(entry))
+          return entry.channels;
+  }
+
+  // Resolve outside of the lock, since callback channels may run user code.
+  auto channels = std::make_shared<const std::vector<kraus_channel>>(
+      get_channels(std::string(quantumOp), targetQubits, controlQubits,
+                   params));
+
+  std::lock_guard<std::mutex> lock(resolvedChannels.mutex);
+  if (resolvedChannels.numEntries >= maxResolvedChannelEntries) {
+    CUDAQ_INFO("Resolved kraus_channel cache is full, clearing it.");
+    resolvedChannels.entries.clear();
+    resolvedChannels.numEntries = 0;
+  }
+  auto &bucket = resolvedChannels.entries[hash];
+  // Another thread may have resolved the same key in the meantime.
+  for (const auto &entry : bucket)
+    if (matches(entry))
+      return entry.channels;
+  bucket.push_back({std::string(quantumOp), controlQubits, targetQubits,
+                    keyParams, channels});
+  ++resolvedChannels.numEntries;
+  return channels;
+}
+
 noise_model::noise_model() {
   register_channel<depolarization_channel>();
   register_channel<amplitude_damping_channel>();
@@ -14,8 +14,11 @@
 #include <cstdint>
 #include <functional>
 #include <math.h>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -448,7 +451,51 @@ protected:
                    std::function<kraus_channel(const std::vector<double> &)>>>
       registeredChannels;
 
+  /// @brief Cache of the channels resolved by get_channels_cached. A copy of
+  /// the cache starts out empty, so copies of a noise_model never share it.
+  class ResolvedChannelCache {
+  public:
+    ResolvedChannelCache() = default;
+    ResolvedChannelCache(const ResolvedChannelCache &) {}
+    ResolvedChannelCache &operator=(const ResolvedChannelCache &) {
+      clear();
+      return *this;
+    }
+
+    /// @brief The resolved channels for one (operation, controls, targets,
+    /// parameters) key.
+    struct Entry {
+      std::string quantumOp;
+      std::vector<std::size_t> controls;
+      std::vector<std::size_t> targets;
+      std::vector<double> params;
+      std::shared_ptr<const std::vector<kraus_channel>> channels;
+    };
+
+    /// @brief Drop all entries. Called whenever the noise model changes.
+    void clear() {
+      std::lock_guard<std::mutex> lock(mutex);
+      entries.clear();
+      numEntries = 0;
+    }
+
+    /// @brief Entries by hash of their key.
+    std::unordered_map<std::size_t, std::vector<Entry>> entries;
+    std::size_t numEntries = 0;
+    std::mutex mutex;
+  };
+
+  /// @brief Resolved channels, filled lazily by get_channels_cached.
+  mutable ResolvedChannelCache resolvedChannels;
+
+  /// @brief Bound on the number of cached keys. Reaching it clears the cache.
+  static constexpr std::size_t maxResolvedChannelEntries = 1 << 16;
+
 public:
+  /// @brief Immutable list of resolved channels, shared between all users of
+  /// the same cache entry.
+  using channel_list = std::shared_ptr<const std::vector<kraus_channel>>;
+
   /// @brief default constructor
   noise_model();
 
@@ -629,6 +676,19 @@ public:
                const std::vector<std::size_t> &controlQubits = {},
                const std::vector<double> &params = {}) const;
 
+  /// @brief Return the same kraus_channels as get_channels, resolving each
+  /// (quantumOp, qubits, params) key only once. Later calls with the same
+  /// key return the shared, immutable result without any map lookups,
+  /// callback calls or matrix copies. Gate parameters are only part of the
+  /// key if the model has callback channels, which are expected to depend
+  /// on nothing but their qubits and parameters. Adding channels to the
+  /// model invalidates the cache.
+  channel_list
+  get_channels_cached(std::string_view quantumOp,
+                      const std::vector<std::size_t> &targetQubits,
+                      const std::vector<std::size_t> &controlQubits = {},
+                      const std::vector<double> &params = {}) const;
+
   /// @brief Get all kraus_channels on the given qubits
   template <typename QuantumOp>
   std::vector<kraus_channel>
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "PackedBitStrings.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace cudaq {
+
+void PackedBitStrings::pack(std::string_view bitString,
+                            std::uint64_t *record) {
+  std::fill_n(record, wordsFor(bitString.size()), 0);
+  for (std::size_t k = 0; k < bitString.size(); ++k)
+    if (bitString[k] == '1')
+      setBit(record, k);
+}
+
+std::string PackedBitStrings::toString(const std::uint64_t *record,
+                                       std::size_t numBits) {
+  std::string result(numBits, '0');
+  for (std::size_t k = 0; k < numBits; ++k)
+    if (getBit(record, k))
+      result[k] = '1';
+  return result;
+}
+
+void PackedBitStrings::append(const PackedBitStrings &other) {
+  if (other.bits != bits)
+    throw std::runtime_error("Cannot append bit strings of length " +
+                             std::to_string(other.bits) + " to bit strings " +
+                             "of length " + std::to_string(bits));
+  words.insert(words.end(), other.words.begin(), other.words.end());
+}
+
+std::vector<std::string> PackedBitStrings::to_strings() const {
+  std::vector<std::string> result;
+  result.reserve(size());
+  for (std::size_t i = 0; i < size(); ++i)
+    result.push_back(to_string(i));
+  return result;
+}
+
+//===----------------------------------------------------------------------===//
+
+std::uint64_t PackedCounts::hash(const std::uint64_t *record) const {
+  // Combine the words with the `splitmix64` finalizer.
+  std::uint64_t h = 0x9e3779b97f4a7c15ULL;
+  for (std::size_t w = 0; w < keys.numWords(); ++w) {
+    std::uint64_t z = h ^ record[w];
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    h = z ^ (z >> 31);
+  }
+  return h;
+}
+
+std::size_t PackedCounts::findSlot(const std::uint64_t *record) const {
+  const std::size_t mask = slots.size() - 1;
+  const std::size_t numWords = keys.numWords();
+  for (std::size_t slot = hash(record) & mask;; slot = (slot + 1) & mask) {
+    const auto idx = slots[slot];
+    if (idx == emptySlot || std::equal(record, record + numWords, keys[idx]))
+      return slot;
+  }
+}
+
+void PackedCounts::grow() {
+  slots.assign(std::max<std::size_t>(16, 2 * slots.size()), emptySlot);
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    slots[findSlot(keys[i])] = i;
+}
+
+void PackedCounts::add(const std::uint64_t *record, std::size_t count) {
+  // Keep the load factor at or below 1/2.
+  if (2 * (counts.size() + 1) > slots.size())
+    grow();
+  const auto slot = findSlot(record);
+  if (slots[slot] == emptySlot) {
+    slots[slot] = counts.size();
+    keys.push_back(record);
+    counts.push_back(count);
+  } else {
+    counts[slots[slot]] += count;
+  }
+  total += count;
+}
+
+std::size_t PackedCounts::count(const std::uint64_t *record) const {
+  if (counts.empty())
+    return 0;
+  const auto idx = slots[findSlot(record)];
+  return idx == emptySlot ? 0 : counts[idx];
+}
+
+std::size_t PackedCounts::count(std::string_view bitString) const {
+  if (bitString.size() != numBits())
+    return 0;
+  std::vector<std::uint64_t> record(numWords());
+  PackedBitStrings::pack(bitString, record.data());
+  return count(record.data());
+}
+
+void PackedCounts::merge(const PackedCounts &other) {
+  if (other.numBits() != numBits())
+    throw std::runtime_error("Cannot merge counts of bit strings of length " +
+                             std::to_string(other.numBits()) + " into counts " +
+                             "of length " + std::to_string(numBits()));
+  for (std::size_t i = 0; i < other.size(); ++i)
+    add(other.key(i), other.countAt(i));
+}
+
+void PackedCounts::clear() {
+  keys.clear();
+  counts.clear();
+  slots.clear();
+  total = 0;
+}
+
+std::unordered_map<std::string, std::size_t> PackedCounts::to_map() const {
+  std::unordered_map<std::string, std::size_t> result;
+  result.reserve(size());
+  for (std::size_t i = 0; i < size(); ++i)
+    result.emplace(PackedBitStrings::toString(key(i), numBits()), counts[i]);
+  return result;
+}
+
+} // namespace cudaq
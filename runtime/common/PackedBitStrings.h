@@ -0,0 +1,153 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cudaq {
+
+/// @brief A sequence of equal-length bit strings, stored bit-packed in 64-bit
+/// words. Character `k` of the string form of a record is bit `k % 64` of word
+/// `k / 64` of that record.
+class PackedBitStrings {
+public:
+  PackedBitStrings() = default;
+  explicit PackedBitStrings(std::size_t numBits)
+      : bits(numBits), wordsPerRecord(wordsFor(numBits)) {}
+
+  /// @brief Number of 64-bit words needed for a record of `numBits` bits.
+  /// Zero-length records still occupy one (all zero) word.
+  static std::size_t wordsFor(std::size_t numBits) {
+    return numBits == 0 ? 1 : (numBits + 63) / 64;
+  }
+
+  static bool getBit(const std::uint64_t *record, std::size_t bit) {
+    return (record[bit / 64] >> (bit % 64)) & 1;
+  }
+
+  static void setBit(std::uint64_t *record, std::size_t bit) {
+    record[bit / 64] |= (1ULL << (bit % 64));
+  }
+
+  /// @brief Return true if the record has an even number of set bits.
+  static bool hasEvenParity(const std::uint64_t *record,
+                            std::size_t numWords) {
+    std::uint64_t acc = 0;
+    for (std::size_t w = 0; w < numWords; ++w)
+      acc ^= record[w];
+    return __builtin_parityll(acc) == 0;
+  }
+
+  /// @brief Pack the '0'/'1' string `bitString` into `record`, which must
+  /// hold `wordsFor(bitString.size())` words.
+  static void pack(std::string_view bitString, std::uint64_t *record);
+
+  /// @brief Return the '0'/'1' string form of a record of `numBits` bits.
+  static std::string toString(const std::uint64_t *record,
+                              std::size_t numBits);
+
+  std::size_t numBits() const { return bits; }
+  std::size_t numWords() const { return wordsPerRecord; }
+  std::size_t size() const { return words.size() / wordsPerRecord; }
+  bool empty() const { return words.empty(); }
+
+  const std::uint64_t *operator[](std::size_t i) const {
+    return words.data() + i * wordsPerRecord;
+  }
+
+  void reserve(std::size_t numRecords) {
+    words.reserve(numRecords * wordsPerRecord);
+  }
+
+  /// @brief Append `count` copies of the given record.
+  void push_back(const std::uint64_t *record, std::size_t count = 1) {
+    for (std::size_t c = 0; c < count; ++c)
+      words.insert(words.end(), record, record + wordsPerRecord);
+  }
+
+  /// @brief Append all records of `other`, which must have the same length.
+  void append(const PackedBitStrings &other);
+
+  void clear() { words.clear(); }
+
+  /// @brief Return the string form of record `i`.
+  std::string to_string(std::size_t i) const {
+    return toString((*this)[i], bits);
+  }
+
+  /// @brief Return the string form of all records.
+  std::vector<std::string> to_strings() const;
+
+private:
+  std::size_t bits = 0;
+  std::size_t wordsPerRecord = 1;
+  std::vector<std::uint64_t> words;
+};
+
+/// @brief Counts of distinct equal-length bit strings, keyed on the packed
+/// bit strings. Distinct records are stored contiguously and indexed by an
+/// open-addressing hash table, so adding a shot never allocates a string.
+class PackedCounts {
+public:
+  PackedCounts() = default;
+  explicit PackedCounts(std::size_t numBits) : keys(numBits) {}
+
+  std::size_t numBits() const { return keys.numBits(); }
+  std::size_t numWords() const { return keys.numWords(); }
+
+  /// @brief Number of distinct bit strings.
+  std::size_t size() const { return counts.size(); }
+  bool empty() const { return counts.empty(); }
+
+  /// @brief The `i`-th distinct bit string and the number of times it was
+  /// observed.
+  const std::uint64_t *key(std::size_t i) const { return keys[i]; }
+  std::size_t countAt(std::size_t i) const { return counts[i]; }
+
+  /// @brief Total number of observations.
+  std::size_t totalCount() const { return total; }
+
+  /// @brief Record `count` observations of the given bit string.
+  void add(const std::uint64_t *record, std::size_t count = 1);
+
+  /// @brief Return the number of observations of the given bit string.
+  std::size_t count(const std::uint64_t *record) const;
+
+  /// @brief Return the number of observations of the given '0'/'1' string, or
+  /// 0 if it does not have the expected length.
+  std::size_t count(std::string_view bitString) const;
+
+  /// @brief Add all observations of `other`, which must have the same length.
+  void merge(const PackedCounts &other);
+
+  void clear();
+
+  /// @brief Return the counts keyed on the string form of the bit strings.
+  std::unordered_map<std::string, std::size_t> to_map() const;
+
+private:
+  static constexpr std::size_t emptySlot = ~std::size_t(0);
+
+  std::uint64_t hash(const std::uint64_t *record) const;
+  std::size_t findSlot(const std::uint64_t *record) const;
+  void grow();
+
+  PackedBitStrings keys;
+  std::vector<std::size_t> counts;
+  std::size_t total = 0;
+  /// Index into `keys`/`counts`, or `emptySlot`. The size is a power of two.
+  std::vector<std::size_t> slots;
+};
+
+} // namespace cudaq
@@ -98,6 +98,9 @@ public:
 
   void resizeBuffer(std::size_t more) { buffer.resize(buffer.size() + more); }
 
+  /// Drop the decoded records, keeping the allocation for reuse.
+  void clearBuffer() { buffer.clear(); }
+
   template <typename T>
   void addPrimitiveRecord(T value) {
     std::size_t position = buffer.size();
@@ -313,6 +316,11 @@ public:
   /// Get the size of the data buffer (in bytes).
   std::size_t getBufferSize() const { return bufferHandler.getBufferSize(); }
 
+  /// Drop the data decoded so far, so that the parser can decode the next
+  /// portion of a log in fixed memory. The schema and metadata read from
+  /// earlier portions are kept.
+  void clearBuffer() { bufferHandler.clearBuffer(); }
+
 private:
   /// Process different types of records
   void handleHeader(const std::vector<std::string> &);
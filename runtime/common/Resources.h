@@ -71,10 +71,12 @@ public:
 
   /// @brief Append instruction with qubit indices. Updates gate counts
   /// and depth metrics (total depth, per-arity depth and gate counts).
-  /// Used by ResourceCounter and IR-level resource counting.
+  /// Used by ResourceCounter and IR-level resource counting. Appending
+  /// `count` back-to-back copies of the gate is done in constant time.
   void appendInstruction(const std::string &name,
                          const std::vector<std::size_t> &controls,
-                         const std::vector<std::size_t> &targets);
+                         const std::vector<std::size_t> &targets,
+                         std::size_t count = 1);
 
   /// @brief Dump resource count to the given output stream
   void dump(std::ostream &os) const;
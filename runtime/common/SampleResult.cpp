@@ -15,6 +15,7 @@
 
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <vector>
 
 static std::string longToBitString(int size, long x) {
@@ -67,19 +68,28 @@ ExecutionResult::ExecutionResult(CountsDictionary c, std::string name, double e)
 
 ExecutionResult::ExecutionResult(CountsDictionary c, double e)
     : counts(c), expectationValue(e) {}
+ExecutionResult::ExecutionResult(PackedCounts c, PackedBitStrings s)
+    : packedCounts(std::move(c)), packedSequentialData(std::move(s)) {}
 ExecutionResult::ExecutionResult(const ExecutionResult &other)
     : counts(other.counts), expectationValue(other.expectationValue),
-      registerName(other.registerName), sequentialData(other.sequentialData) {}
+      registerName(other.registerName), sequentialData(other.sequentialData),
+      packedCounts(other.packedCounts),
+      packedSequentialData(other.packedSequentialData),
+      packedCountsCached(other.packedCountsCached) {}
 
 ExecutionResult &ExecutionResult::operator=(const ExecutionResult &other) {
   counts = other.counts;
   expectationValue = other.expectationValue;
   registerName = other.registerName;
   sequentialData = other.sequentialData;
+  packedCounts = other.packedCounts;
+  packedSequentialData = other.packedSequentialData;
+  packedCountsCached = other.packedCountsCached;
   return *this;
 }
 
 void ExecutionResult::appendResult(std::string bitString, std::size_t count) {
+  unpack();
   auto [iter, inserted] = counts.emplace(std::move(bitString), count);
   if (!inserted)
     iter->second += count;
@@ -87,8 +97,47 @@ void ExecutionResult::appendResult(std::string bitString, std::size_t count) {
   sequentialData.insert(sequentialData.end(), count, iter->first);
 }
 
+void ExecutionResult::unpack() {
+  if (!isPacked())
+    return;
+  cachePackedCounts();
+  packedCountsCached = false;
+  sequentialData.reserve(sequentialData.size() + packedSequentialData.size());
+  for (std::size_t i = 0; i < packedSequentialData.size(); ++i)
+    sequentialData.push_back(packedSequentialData.to_string(i));
+  packedCounts = PackedCounts();
+  packedSequentialData = PackedBitStrings();
+}
+
+void ExecutionResult::cachePackedCounts() {
+  if (!isPacked() || packedCountsCached)
+    return;
+  for (std::size_t i = 0; i < packedCounts.size(); ++i)
+    counts[PackedBitStrings::toString(packedCounts.key(i),
+                                      packedCounts.numBits())] +=
+        packedCounts.countAt(i);
+  packedCountsCached = true;
+}
+
+std::size_t ExecutionResult::getTotalCount() const {
+  if (isPacked())
+    return packedCounts.totalCount();
+  std::size_t total = 0;
+  for (auto &[bits, count] : counts)
+    total += count;
+  return total;
+}
+
+CountsDictionary ExecutionResult::getCounts() const {
+  return isPacked() ? packedCounts.to_map() : counts;
+}
+
 bool ExecutionResult::operator==(const ExecutionResult &result) const {
-  return registerName == result.registerName && counts == result.counts;
+  if (registerName != result.registerName)
+    return false;
+  if (!isPacked() && !result.isPacked())
+    return counts == result.counts;
+  return getCounts() == result.getCounts();
 }
 
 /// @brief  Encoding - 1st element is size of the register name N, then next N
@@ -105,6 +154,19 @@ std::vector<std::size_t> ExecutionResult::serialize() const {
   }
 
   // Encode the counts data
+  if (isPacked()) {
+    retData.push_back(packedCounts.size());
+    const auto numBits = packedCounts.numBits();
+    for (std::size_t i = 0; i < packedCounts.size(); ++i) {
+      std::size_t l = 0;
+      for (std::size_t k = 0; k < numBits; ++k)
+        l = (l << 1) | PackedBitStrings::getBit(packedCounts.key(i), k);
+      retData.push_back(l);
+      retData.push_back(numBits);
+      retData.push_back(packedCounts.countAt(i));
+    }
+    return retData;
+  }
   retData.push_back(counts.size());
   for (auto &kv : counts) {
     auto bits = kv.first;
@@ -163,10 +225,8 @@ void sample_result::deserialize(std::vector<std::size_t> &data) {
 }
 
 sample_result::sample_result(ExecutionResult &&result) {
-  auto counts = result.counts;
+  totalShots = result.getTotalCount();
   sampleResults.insert({result.registerName, std::move(result)});
-  for (auto &[bits, count] : counts)
-    totalShots += count;
 }
 
 sample_result::sample_result(const ExecutionResult &result)
@@ -178,8 +238,7 @@ sample_result::sample_result(const std::vector<ExecutionResult> &results) {
 
   if (results.empty())
     return;
-  for (auto &[bits, count] : results[0].counts)
-    totalShots += count;
+  totalShots = results[0].getTotalCount();
 }
 
 sample_result::sample_result(double preComputedExp,
@@ -196,13 +255,46 @@ void sample_result::append(const ExecutionResult &result, bool concatenate) {
   auto iter = sampleResults.find(result.registerName);
   if (iter != sampleResults.end()) {
     auto &existingExecResult = iter->second;
-    if (concatenate) {
+    if (concatenate && existingExecResult.isPacked() && result.isPacked()) {
+      // Stitch the packed bitstrings together
+      const auto &lhs = existingExecResult.packedSequentialData;
+      const auto &rhs = result.packedSequentialData;
+      if (this->totalShots == rhs.size() && lhs.size() == rhs.size()) {
+        const auto lhsBits = lhs.numBits();
+        PackedBitStrings stitched(lhsBits + rhs.numBits());
+        PackedCounts stitchedCounts(stitched.numBits());
+        stitched.reserve(rhs.size());
+        std::vector<std::uint64_t> record(stitched.numWords());
+        for (std::size_t i = 0; i < rhs.size(); i++) {
+          std::fill(record.begin(), record.end(), 0);
+          for (std::size_t k = 0; k < lhsBits; k++)
+            if (PackedBitStrings::getBit(lhs[i], k))
+              PackedBitStrings::setBit(record.data(), k);
+          for (std::size_t k = 0; k < rhs.numBits(); k++)
+            if (PackedBitStrings::getBit(rhs[i], k))
+              PackedBitStrings::setBit(record.data(), lhsBits + k);
+          stitched.push_back(record.data());
+          stitchedCounts.add(record.data());
+        }
+        existingExecResult.packedCounts = std::move(stitchedCounts);
+        existingExecResult.packedSequentialData = std::move(stitched);
+        existingExecResult.counts.clear();
+        existingExecResult.packedCountsCached = false;
+      }
+    } else if (concatenate) {
+      existingExecResult.unpack();
+      ExecutionResult unpackedResult;
+      if (result.isPacked()) {
+        unpackedResult = result;
+        unpackedResult.unpack();
+      }
+      const auto &toAppend = result.isPacked() ? unpackedResult : result;
       // Stitch the bitstrings together
-      if (this->totalShots == result.sequentialData.size()) {
+      if (this->totalShots == toAppend.sequentialData.size()) {
         existingExecResult.counts.clear();
         for (std::size_t i = 0; i < this->totalShots; i++) {
-          std::string newStr =
-              existingExecResult.sequentialData[i] + result.sequentialData[i];
+          std::string newStr = existingExecResult.sequentialData[i] +
+                               toAppend.sequentialData[i];
           existingExecResult.counts[newStr]++;
           existingExecResult.sequentialData[i] = std::move(newStr);
         }
@@ -215,8 +307,7 @@ void sample_result::append(const ExecutionResult &result, bool concatenate) {
     sampleResults.insert({result.registerName, result});
   }
   if (!totalShots)
-    for (auto &[bits, count] : result.counts)
-      totalShots += count;
+    totalShots = result.getTotalCount();
 }
 
 bool sample_result::operator==(const sample_result &counts) const {
@@ -234,7 +325,26 @@ sample_result &sample_result::operator+=(const sample_result &other) {
       // We already have a sample result with this name, so now lets just merge
       // them.
       auto &sr = sampleResults[regName];
-      for (auto &[bits, count] : otherResults.second.counts) {
+      const auto &otherResult = otherResults.second;
+      if (sr.isPacked() && otherResult.isPacked() &&
+          sr.packedCounts.numBits() == otherResult.packedCounts.numBits()) {
+        sr.packedCounts.merge(otherResult.packedCounts);
+        sr.packedSequentialData.append(otherResult.packedSequentialData);
+        sr.counts.clear();
+        sr.packedCountsCached = false;
+        if (regName == GlobalRegisterName)
+          totalShots += other.totalShots;
+        continue;
+      }
+      sr.unpack();
+      ExecutionResult unpackedResult;
+      if (otherResult.isPacked()) {
+        unpackedResult = otherResult;
+        unpackedResult.unpack();
+      }
+      const auto &toMerge =
+          otherResult.isPacked() ? unpackedResult : otherResult;
+      for (auto &[bits, count] : toMerge.counts) {
         auto &ourCounts = sr.counts;
         if (ourCounts.count(bits))
           ourCounts[bits] += count;
@@ -242,10 +352,10 @@ sample_result &sample_result::operator+=(const sample_result &other) {
           ourCounts.insert({bits, count});
       }
 
-      if (!otherResults.second.sequentialData.empty())
+      if (!toMerge.sequentialData.empty())
         sr.sequentialData.insert(sr.sequentialData.end(),
-                                 otherResults.second.sequentialData.begin(),
-                                 otherResults.second.sequentialData.end());
+                                 toMerge.sequentialData.begin(),
+                                 toMerge.sequentialData.end());
     }
     if (regName == GlobalRegisterName)
       totalShots += other.totalShots;
@@ -293,48 +403,69 @@ sample_result::retrieve_result(const std::string &registerName) {
   return iter->second;
 }
 
+cudaq::ExecutionResult &
+sample_result::retrieve_unpacked_result(const std::string &registerName) {
+  auto &result = retrieve_result(registerName);
+  result.unpack();
+  return result;
+}
+
+const cudaq::ExecutionResult &
+sample_result::retrieve_cached_result(const std::string &registerName) const {
+  // Const accessors may be called concurrently. The cache only adds the string
+  // form of the counts, which the other accessors do not read while the
+  // bit-packed form is present, and is built once under this lock.
+  static std::mutex cacheMutex;
+  // The map is mutable, so its elements may be modified from here.
+  auto &result = const_cast<ExecutionResult &>(retrieve_result(registerName));
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  result.cachePackedCounts();
+  return result;
+}
+
 std::vector<std::string>
 sample_result::sequential_data(const std::string_view registerName) const {
   return retrieve_result(registerName.data()).getSequentialData();
 }
 
 CountsDictionary::iterator sample_result::begin() {
-  return retrieve_result(GlobalRegisterName).counts.begin();
+  return retrieve_unpacked_result(GlobalRegisterName).counts.begin();
 }
 
 CountsDictionary::iterator sample_result::end() {
-  return retrieve_result(GlobalRegisterName).counts.end();
+  return retrieve_unpacked_result(GlobalRegisterName).counts.end();
 }
 
 CountsDictionary::const_iterator sample_result::cbegin() const {
-  return retrieve_result(GlobalRegisterName).counts.cbegin();
+  return retrieve_cached_result(GlobalRegisterName).counts.cbegin();
 }
 
 CountsDictionary::const_iterator sample_result::cend() const {
-  return retrieve_result(GlobalRegisterName).counts.cend();
+  return retrieve_cached_result(GlobalRegisterName).counts.cend();
 }
 
 std::size_t
 sample_result::size(const std::string_view registerName) const noexcept {
   auto [found, result] = try_retrieve_result(registerName.data());
   if (found)
-    return result.counts.size();
+    return result.isPacked() ? result.packedCounts.size()
+                             : result.counts.size();
   else
     return 0;
 }
 
 double sample_result::probability(std::string_view bitStr,
                                   const std::string_view registerName) const {
-  const auto &result = retrieve_result(registerName.data());
-  const auto countIter = result.counts.find(bitStr.data());
-  return (countIter == result.counts.end())
-             ? 0.0
-             : (double)countIter->second / totalShots;
+  const auto observed = count(bitStr, registerName);
+  return observed == 0 ? 0.0 : (double)observed / totalShots;
 }
 
 std::size_t sample_result::count(std::string_view bitStr,
                                  const std::string_view registerName) const {
-  const auto &counts = retrieve_result(registerName.data()).counts;
+  const auto &result = retrieve_result(registerName.data());
+  if (result.isPacked())
+    return result.packedCounts.count(bitStr);
+  const auto &counts = result.counts;
   auto it = counts.find(bitStr.data());
   if (it == counts.cend())
     return 0;
@@ -344,7 +475,16 @@ std::size_t sample_result::count(std::string_view bitStr,
 
 std::string
 sample_result::most_probable(const std::string_view registerName) const {
-  const auto &counts = retrieve_result(registerName.data()).counts;
+  const auto &result = retrieve_result(registerName.data());
+  if (result.isPacked()) {
+    const auto &packed = result.packedCounts;
+    std::size_t best = 0;
+    for (std::size_t i = 1; i < packed.size(); ++i)
+      if (packed.countAt(i) > packed.countAt(best))
+        best = i;
+    return PackedBitStrings::toString(packed.key(best), packed.numBits());
+  }
+  const auto &counts = result.counts;
   return std::max_element(counts.begin(), counts.end(),
                           [](const auto &el1, const auto &el2) {
                             return el1.second < el2.second;
@@ -369,6 +509,16 @@ double sample_result::expectation(const std::string_view registerName) const {
     return result.expectationValue.value();
 
   double aver = 0.0;
+  if (result.isPacked()) {
+    const auto &packed = result.packedCounts;
+    for (std::size_t i = 0; i < packed.size(); ++i) {
+      const double p = (double)packed.countAt(i) / totalShots;
+      aver += PackedBitStrings::hasEvenParity(packed.key(i), packed.numWords())
+                  ? p
+                  : -p;
+    }
+    return aver;
+  }
   const auto &counts = result.counts;
   for (auto &kv : counts) {
     auto par = has_even_parity(kv.first);
@@ -393,17 +543,40 @@ std::vector<std::string> sample_result::register_names() const {
 
 CountsDictionary
 sample_result::to_map(const std::string_view registerName) const {
-  return retrieve_result(registerName.data()).counts;
+  return retrieve_result(registerName.data()).getCounts();
 }
 
 sample_result
 sample_result::get_marginal(const std::vector<std::size_t> &marginalIndices,
                             const std::string_view registerName) const {
-  const auto &counts = retrieve_result(registerName.data()).counts;
+  const auto &result = retrieve_result(registerName.data());
   auto mutableIndices = marginalIndices;
 
   std::sort(mutableIndices.begin(), mutableIndices.end());
 
+  if (result.isPacked()) {
+    const auto &packed = result.packedCounts;
+    for (auto index : mutableIndices)
+      if (index >= packed.numBits())
+        throw std::runtime_error("Invalid marginal index (" +
+                                 std::to_string(index) + ", size=" +
+                                 std::to_string(packed.numBits()));
+    PackedCounts marginalCounts(mutableIndices.size());
+    PackedBitStrings marginalShots(mutableIndices.size());
+    std::vector<std::uint64_t> record(marginalCounts.numWords());
+    for (std::size_t i = 0; i < packed.size(); ++i) {
+      std::fill(record.begin(), record.end(), 0);
+      for (std::size_t k = 0; k < mutableIndices.size(); ++k)
+        if (PackedBitStrings::getBit(packed.key(i), mutableIndices[k]))
+          PackedBitStrings::setBit(record.data(), k);
+      marginalCounts.add(record.data(), packed.countAt(i));
+      marginalShots.push_back(record.data(), packed.countAt(i));
+    }
+    return sample_result(ExecutionResult(std::move(marginalCounts),
+                                         std::move(marginalShots)));
+  }
+
+  const auto &counts = result.counts;
   ExecutionResult sr;
   for (auto &[bits, count] : counts) {
     std::string newBits;
@@ -448,7 +621,8 @@ void sample_result::dump(std::ostream &os) const {
     std::size_t counter = 0;
     for (auto &result : sortByKeys(sampleResults)) {
       os << result->first << " : { ";
-      for (auto &kv : sortByKeys(result->second.counts)) {
+      const auto counts = result->second.getCounts();
+      for (auto &kv : sortByKeys(counts)) {
         os << kv->first << ":" << kv->second << " ";
       }
       bool isLast = counter == sampleResults.size() - 1;
@@ -461,11 +635,11 @@ void sample_result::dump(std::ostream &os) const {
     CountsDictionary counts;
     auto [found, result] = try_retrieve_result(GlobalRegisterName);
     if (found)
-      counts = result.counts;
+      counts = result.getCounts();
     else {
       auto first = sampleResults.begin();
       os << "\n   " << first->first << " : { ";
-      counts = sampleResults.begin()->second.counts;
+      counts = sampleResults.begin()->second.getCounts();
     }
 
     for (auto &kv : sortByKeys(counts)) {
@@ -487,8 +661,35 @@ bool sample_result::has_even_parity(std::string_view bitString) {
 
 void sample_result::reorder(const std::vector<std::size_t> &idx,
                             const std::string_view registerName) {
-  // First process the counts
   auto &result = retrieve_result(registerName.data());
+  if (result.isPacked()) {
+    const auto numBits = result.packedCounts.numBits();
+    if (idx.size() != numBits)
+      throw std::runtime_error("Calling reorder() with invalid parameter idx");
+    std::vector<std::uint64_t> record(result.packedCounts.numWords());
+    auto permute = [&](const std::uint64_t *bits) {
+      std::fill(record.begin(), record.end(), 0);
+      for (std::size_t i = 0; i < numBits; i++)
+        if (PackedBitStrings::getBit(bits, idx[i]))
+          PackedBitStrings::setBit(record.data(), i);
+      return record.data();
+    };
+    PackedCounts newCounts(numBits);
+    for (std::size_t i = 0; i < result.packedCounts.size(); i++)
+      newCounts.add(permute(result.packedCounts.key(i)),
+                    result.packedCounts.countAt(i));
+    PackedBitStrings newShots(numBits);
+    newShots.reserve(result.packedSequentialData.size());
+    for (std::size_t i = 0; i < result.packedSequentialData.size(); i++)
+      newShots.push_back(permute(result.packedSequentialData[i]));
+    result.packedCounts = std::move(newCounts);
+    result.packedSequentialData = std::move(newShots);
+    result.counts.clear();
+    result.packedCountsCached = false;
+    return;
+  }
+
+  // First process the counts
   CountsDictionary newCounts;
   for (auto [bits, count] : result.counts) {
     if (idx.size() != bits.size())
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "PackedBitStrings.h"
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -38,6 +39,18 @@ struct ExecutionResult {
   /// @brief Sequential bit strings observed (not collated into a map)
   std::vector<std::string> sequentialData;
 
+  /// @brief Bit-packed form of `counts` and `sequentialData`. Simulators that
+  /// produce many shots fill these instead, and the string form is only built
+  /// when it is asked for (see `unpack()`). A result uses one form or the
+  /// other, never both (except for `packedCountsCached`).
+  PackedCounts packedCounts;
+  PackedBitStrings packedSequentialData;
+
+  /// @brief True if `counts` also holds the string form of `packedCounts`,
+  /// built for the iterators of a const `sample_result`. The bit-packed form
+  /// remains the reference data until `unpack()` is called.
+  bool packedCountsCached = false;
+
   /// @brief Serialize this sample result to a vector of integers.
   /// Encoding: 1st element is size of the register name N, then next N
   /// represent register name, next is the number of bitstrings M,
@@ -76,6 +89,10 @@ struct ExecutionResult {
   /// @param e The precomputed expected value
   ExecutionResult(CountsDictionary c, double e);
 
+  /// @brief Construct from bit-packed counts and (optionally) shot records,
+  /// assumes registerName == __global__
+  ExecutionResult(PackedCounts c, PackedBitStrings s = {});
+
   /// @brief Copy constructor
   /// @param other
   ExecutionResult(const ExecutionResult &other);
@@ -95,7 +112,25 @@ struct ExecutionResult {
   /// @param count
   void appendResult(std::string bitString, std::size_t count);
 
-  std::vector<std::string> getSequentialData() const { return sequentialData; }
+  /// @brief Return true if the data is held in the bit-packed form.
+  bool isPacked() const { return !packedCounts.empty(); }
+
+  /// @brief Convert bit-packed data (if any) to the string form.
+  void unpack();
+
+  /// @brief Build the string form of the bit-packed counts (if any) in
+  /// `counts`, without modifying the bit-packed data.
+  void cachePackedCounts();
+
+  /// @brief Total number of shots in the counts.
+  std::size_t getTotalCount() const;
+
+  /// @brief Return the counts keyed on bit strings, in either form.
+  CountsDictionary getCounts() const;
+
+  std::vector<std::string> getSequentialData() const {
+    return isPacked() ? packedSequentialData.to_strings() : sequentialData;
+  }
 };
 
 /// @brief The sample_result abstraction wraps a set of `ExecutionResult`s for
@@ -105,8 +140,10 @@ struct ExecutionResult {
 /// observed measurement results holistically for the quantum kernel.
 class sample_result {
 private:
-  /// @brief A mapping of register names to `ExecutionResult`s
-  std::unordered_map<std::string, ExecutionResult> sampleResults;
+  /// @brief A mapping of register names to `ExecutionResult`s. Mutable since
+  /// the string form of bit-packed counts is cached on first use of the const
+  /// iterators (see `ExecutionResult::cachePackedCounts()`).
+  mutable std::unordered_map<std::string, ExecutionResult> sampleResults;
 
   /// @brief Keep track of the total number of shots. We keep this
   /// here so we don't have to keep recomputing it.
@@ -116,6 +153,9 @@ private:
   try_retrieve_result(const std::string &registerName) const;
   const ExecutionResult &retrieve_result(const std::string &registerName) const;
   ExecutionResult &retrieve_result(const std::string &registerName);
+  ExecutionResult &retrieve_unpacked_result(const std::string &registerName);
+  const ExecutionResult &
+  retrieve_cached_result(const std::string &registerName) const;
 
 public:
   /// @brief Default constructor
@@ -22,6 +22,9 @@ static constexpr int TIMING_JIT = 6;
 static constexpr int TIMING_JIT_PASSES = 7;
 static constexpr int TIMING_RUN = 8;
 static constexpr int TIMING_TENSORNET = 9;
-static constexpr int TIMING_MAX_VALUE = 9;
+static constexpr int TIMING_JIT_CACHE = 10;
+static constexpr int TIMING_BROADCAST = 11;
+static constexpr int TIMING_PROFILE = 12;
+static constexpr int TIMING_MAX_VALUE = 12;
 bool isTimingTagEnabled(int tag);
 } // namespace cudaq
@@ -8,8 +8,12 @@
 
 #pragma once
 
+#include "common/Timing.h"
 #include "cudaq/host_config.h"
 #include "cudaq/platform.h"
+#include "cudaq/runtime/logger/logger.h"
+#include <algorithm>
+#include <chrono>
 
 namespace cudaq {
 
@@ -37,14 +41,20 @@ using BroadcastFunctorType = const std::function<ReturnType(
 
 /// @brief Given the input BroadcastFunctorType, apply it to all argument sets
 /// in the provided ArgumentSet `params`. Distribute the work over the provided
-/// number of QPUs.
+/// number of QPUs, each QPU taking a contiguous slice of the argument sets.
+///
+/// Each QPU runs its slice as a single batch: the functor is given the index
+/// of the argument set within the slice and the slice size, so that the
+/// execution context is in batch mode and the simulator resets its state to
+/// |0> between argument sets instead of freeing and reallocating it. Results
+/// are written in place into one preallocated block, in argument-set order.
+/// The throughput of the sweep is reported when `CUDAQ_TIMING_TAGS` includes
+/// `TIMING_BROADCAST`.
 template <typename ResType, typename... Args>
 std::vector<ResType>
 broadcastFunctionOverArguments(std::size_t numQpus, quantum_platform &platform,
                                BroadcastFunctorType<ResType, Args...> &apply,
                                ArgumentSet<Args...> &params) {
-  using FutureCollection = std::vector<std::future<std::vector<ResType>>>;
-
   // Assert all arg vectors are the same size
   auto N = std::get<0>(params).size();
   auto nExecsPerQpu = N / numQpus + (N % numQpus != 0);
@@ -59,68 +69,73 @@ broadcastFunctionOverArguments(std::size_t numQpus, quantum_platform &platform,
   // Fetch the thread-specific seed outside the functor and then pass it inside.
   std::size_t seed = cudaq::get_random_seed();
 
-  FutureCollection futures;
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<ResType> allResults(N);
+  std::vector<std::future<void>> futures;
   for (std::size_t qpuId = 0; qpuId < numQpus; qpuId++) {
-    std::promise<std::vector<ResType>> _promise;
+    // Compute the lower and upper bounds of the argument set that should be
+    // computed on the current QPU. The last slices may be short (or empty).
+    auto lowerBound = std::min(N, qpuId * nExecsPerQpu);
+    auto upperBound = std::min(N, lowerBound + nExecsPerQpu);
+    if (lowerBound == upperBound)
+      continue;
+
+    std::promise<void> _promise;
     futures.emplace_back(_promise.get_future());
     std::function<void()> functor = detail::make_copyable_function(
-        [&params, &apply, qpuId, nExecsPerQpu, seed,
+        [&params, &apply, &allResults, qpuId, lowerBound, upperBound, seed,
          promise = std::move(_promise)]() mutable {
-          // Compute the lower and upper bounds of the
-          // argument set that should be computed on the current QPU
-          auto lowerBound = qpuId * nExecsPerQpu;
-          auto upperBound = lowerBound + nExecsPerQpu;
-
-          // Store the results
-          std::vector<ResType> results;
-
-          // Loop over all sets of arguments, the ith element of each vector
-          // in the ArgumentSet tuple
-          for (std::size_t i = lowerBound, counter = 0; i < upperBound; i++) {
-            // Construct the current set of arguments as a new tuple
-            // We want a tuple so we can use std::apply with the
-            // existing sample()/observe() functions.
+          try {
+            // Construct the current set of arguments as a tuple, so we can
+            // use std::apply with the existing sample()/observe() functions.
+            // The QPU id and the number of argument sets applied on this QPU
+            // are the same for the whole slice.
             std::tuple<std::size_t, std::size_t, std::size_t, Args...>
                 currentArgs;
-
-            // Fill the argument tuple with the QPU id, current argument
-            // iteration, and the total number of arguments that will be applied
-            // on this QPU.
             std::get<0>(currentArgs) = qpuId;
-            std::get<1>(currentArgs) = counter;
-            std::get<2>(currentArgs) = nExecsPerQpu;
-            counter++;
-
-            // If seed is 0, then it has not been set.
-            if (seed > 0)
-              cudaq::set_random_seed(seed);
-
-            // Fill the argument tuple with the actual arguments.
-            cudaq::tuple_for_each_with_idx(
-                params, [&]<typename IDX_TYPE>(auto &&element, IDX_TYPE &&idx) {
-                  std::get<IDX_TYPE::value + 3>(currentArgs) = element[i];
-                });
-
-            // Call observe/sample with the current set of arguments
-            // (provided as a tuple)
-            auto result = std::apply(apply, currentArgs);
-
-            // Store the result.
-            results.push_back(result);
+            std::get<2>(currentArgs) = upperBound - lowerBound;
+
+            // Loop over all sets of arguments, the ith element of each vector
+            // in the ArgumentSet tuple
+            for (std::size_t i = lowerBound; i < upperBound; i++) {
+              std::get<1>(currentArgs) = i - lowerBound;
+
+              // If seed is 0, then it has not been set.
+              if (seed > 0)
+                cudaq::set_random_seed(seed);
+
+              // Fill the argument tuple with the actual arguments.
+              cudaq::tuple_for_each_with_idx(
+                  params,
+                  [&]<typename IDX_TYPE>(auto &&element, IDX_TYPE &&idx) {
+                    std::get<IDX_TYPE::value + 3>(currentArgs) = element[i];
+                  });
+
+              // Call observe/sample with the current set of arguments and
+              // store the result in place.
+              allResults[i] = std::apply(apply, currentArgs);
+            }
+            promise.set_value();
+          } catch (...) {
+            promise.set_exception(std::current_exception());
           }
-
-          // Set the promised results.
-          promise.set_value(results);
         });
 
     platform.enqueueAsyncTask(qpuId, functor);
   }
 
-  // Get all the async-generated results and return.
-  std::vector<ResType> allResults;
-  for (auto &f : futures) {
-    auto res = f.get();
-    allResults.insert(allResults.end(), res.begin(), res.end());
+  // Wait for all the async executions.
+  for (auto &f : futures)
+    f.get();
+
+  if (cudaq::isTimingTagEnabled(cudaq::TIMING_BROADCAST)) {
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+    cudaq::log("[tag={}] Broadcast over {} argument sets on {} QPUs took {} "
+               "ms ({} argument sets/s)",
+               cudaq::TIMING_BROADCAST, N, futures.size(), seconds * 1e3,
+               seconds > 0 ? N / seconds : 0.0);
   }
 
   return allResults;
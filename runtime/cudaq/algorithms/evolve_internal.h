@@ -114,7 +114,10 @@ evolve_async(state initial_state, QuantumKernel &&kernel,
         p.set_value(std::move(result));
       });
 
-  platform.enqueueAsyncTask(qpu_id, wrapped);
+  // A task with its own noise model sets the noise model of the platform, so
+  // it must not run concurrently with other tasks on that QPU.
+  platform.enqueueAsyncTask(qpu_id, wrapped,
+                            /*ordered=*/noise_model.has_value());
   return f;
 }
 
@@ -141,7 +144,10 @@ evolve_async(state initial_state, std::vector<QuantumKernel> kernels,
         p.set_value(std::move(result));
       });
 
-  platform.enqueueAsyncTask(qpu_id, wrapped);
+  // A task with its own noise model sets the noise model of the platform, so
+  // it must not run concurrently with other tasks on that QPU.
+  platform.enqueueAsyncTask(qpu_id, wrapped,
+                            /*ordered=*/noise_model.has_value());
   return f;
 }
 
@@ -48,6 +48,35 @@ protected:
     return cudaq::observe(ansatz_functor, h, x);
   }
 
+  // Given a batch of parameter sets and the spin_op h, compute the expected
+  // value at each of them. The observations are dispatched round-robin over
+  // all QPUs of the platform with observe_async, and the results are
+  // returned in the order of the batch. A noise model set with
+  // cudaq::set_noise only applies to QPU 0, so noisy observations all stay
+  // there.
+  std::vector<double>
+  getExpectedValues(const std::vector<std::vector<double>> &xs,
+                    const spin_op &h) {
+    std::vector<double> values(xs.size());
+    auto &platform = cudaq::get_platform();
+    const auto nQpus = platform.num_qpus();
+    if (nQpus <= 1 || xs.size() <= 1 || platform.get_noise()) {
+      for (std::size_t i = 0; i < xs.size(); i++) {
+        auto x = xs[i];
+        values[i] = getExpectedValue(x, h);
+      }
+      return values;
+    }
+
+    std::vector<async_observe_result> results;
+    results.reserve(xs.size());
+    for (std::size_t i = 0; i < xs.size(); i++)
+      results.emplace_back(observe_async(i % nQpus, ansatz_functor, h, xs[i]));
+    for (std::size_t i = 0; i < xs.size(); i++)
+      values[i] = results[i].get().expectation();
+    return values;
+  }
+
   // Copy constructor. Derived classes should implement the clone() method.
   gradient(const gradient &o) {
     ansatz_functor = o.ansatz_functor;
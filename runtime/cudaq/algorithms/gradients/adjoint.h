@@ -0,0 +1,234 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "cudaq/algorithms/gradient.h"
+#include "cudaq/algorithms/unitary.h"
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace cudaq::gradients {
+
+/// @brief Exact gradient of `<H>` by the adjoint method, on a CPU state
+/// vector.
+///
+/// The kernel is traced, without simulation, and its gates are applied to
+/// `|psi> = U_N ... U_1 |0>`. With `|lambda> = H |psi>`, the gates are then
+/// undone one by one on both vectors, so that the derivative of `<H>` with
+/// respect to an angle of gate `g` is `2 Re <lambda| dU_g |psi_(g-1)>`. The
+/// whole gradient costs about three simulations of the kernel, regardless of
+/// the number of parameters.
+///
+/// Gate angles are arbitrary functions of the kernel parameters. Their
+/// derivatives are obtained from two extra traces of the kernel per
+/// parameter, by central differences, which is exact for angles that are
+/// affine in the parameters. The kernel must apply the same gates, without
+/// measurements or noise, for all parameters. Only the built-in (named) gates
+/// are supported.
+class adjoint : public gradient {
+public:
+  using gradient::gradient;
+
+  virtual std::unique_ptr<cudaq::gradient> clone() override {
+    return std::make_unique<adjoint>(*this);
+  }
+
+  void compute(const std::vector<double> &x, std::vector<double> &dx,
+               const spin_op &h, double exp_h) override {
+    std::size_t numQubits = 0;
+    const auto gates = traceGates(x, numQubits);
+
+    // Sensitivities of every gate angle, flattened over the gates, to the
+    // kernel parameters.
+    std::vector<std::size_t> firstAngle(gates.size() + 1, 0);
+    for (std::size_t g = 0; g < gates.size(); ++g)
+      firstAngle[g + 1] = firstAngle[g] + gates[g].params.size();
+    std::vector<std::vector<std::pair<std::size_t, double>>> sensitivities(
+        firstAngle.back());
+    auto tmpX = x;
+    for (std::size_t i = 0; i < x.size(); i++) {
+      const double step = std::cbrt(std::numeric_limits<double>::epsilon()) *
+                          std::max(1.0, std::abs(x[i]));
+      std::size_t shiftedQubits = 0;
+      tmpX[i] = x[i] + step;
+      const auto plus = traceGates(tmpX, shiftedQubits);
+      tmpX[i] = x[i] - step;
+      const auto minus = traceGates(tmpX, shiftedQubits);
+      const double width = (x[i] + step) - (x[i] - step);
+      tmpX[i] = x[i];
+      checkSameGates(gates, plus);
+      checkSameGates(gates, minus);
+      for (std::size_t g = 0; g < gates.size(); ++g)
+        for (std::size_t k = 0; k < gates[g].params.size(); ++k) {
+          const double derivative =
+              (plus[g].params[k] - minus[g].params[k]) / width;
+          if (derivative != 0.0)
+            sensitivities[firstAngle[g] + k].emplace_back(i, derivative);
+        }
+    }
+
+    const std::size_t dim = 1ULL << numQubits;
+    std::vector<std::complex<double>> psi(dim), lambda(dim);
+    psi[0] = 1.0;
+    for (const auto &gate : gates)
+      contrib::detail::apply_gate_to_columns(psi.data(), numQubits, 1,
+                                             gate.gate);
+    applySpinOp(h, numQubits, psi.data(), lambda.data());
+
+    dx.assign(x.size(), 0.0);
+    for (std::size_t g = gates.size(); g-- > 0;) {
+      const auto &gate = gates[g];
+      auto inverse = gate.gate;
+      const std::size_t localDim = 1ULL << gate.gate.targets.size();
+      for (std::size_t r = 0; r < localDim; ++r)
+        for (std::size_t c = 0; c < localDim; ++c)
+          inverse.matrix[r * localDim + c] =
+              std::conj(gate.gate.matrix[c * localDim + r]);
+      contrib::detail::apply_gate_to_columns(psi.data(), numQubits, 1,
+                                             inverse);
+
+      for (std::size_t k = 0; k < gate.params.size(); ++k) {
+        const auto &dependents = sensitivities[firstAngle[g] + k];
+        if (dependents.empty())
+          continue;
+        const contrib::detail::unitary_gate derivative{
+            gateDerivative(gate.name, gate.params, k), gate.gate.controls,
+            gate.gate.targets};
+        const double angleGradient =
+            2.0 * contrib::detail::gate_inner_product(
+                      lambda.data(), psi.data(), numQubits, derivative)
+                      .real();
+        for (const auto &[i, sensitivity] : dependents)
+          dx[i] += sensitivity * angleGradient;
+      }
+
+      if (g > 0)
+        contrib::detail::apply_gate_to_columns(lambda.data(), numQubits, 1,
+                                               inverse);
+    }
+  }
+
+  /// @brief The adjoint method needs the observable, so it cannot
+  /// differentiate an arbitrary function.
+  std::vector<double>
+  compute(const std::vector<double> &x,
+          const std::function<double(std::vector<double>)> &func,
+          double funcAtX) override {
+    throw std::runtime_error(
+        "The adjoint gradient can only differentiate the expectation value of "
+        "a spin_op. Use another gradient strategy for arbitrary functions.");
+  }
+
+private:
+  struct traced_gate {
+    nvqir::GateName name;
+    std::vector<double> params;
+    contrib::detail::unitary_gate gate;
+  };
+
+  /// @brief Trace the kernel at the given parameters and return its gates.
+  std::vector<traced_gate> traceGates(const std::vector<double> &x,
+                                      std::size_t &numQubits) {
+    auto trace = contrib::traceFromKernel(ansatz_functor, x);
+    numQubits = trace.getNumQudits();
+    if (numQubits == 0)
+      throw std::runtime_error(
+          "The adjoint gradient requires a kernel that allocates qubits, "
+          "executed on a simulator.");
+
+    std::vector<traced_gate> gates;
+    for (const auto &inst : trace) {
+      if (inst.type != TraceInstructionType::Gate)
+        throw std::runtime_error(
+            "The adjoint gradient does not support measurements or noise in "
+            "the kernel.");
+      traced_gate gate{nvqir::getGateNameFromString(inst.name), inst.params};
+      gate.gate.matrix = nvqir::getGateByName<double>(gate.name, inst.params);
+      for (const auto &control : inst.controls)
+        gate.gate.controls.push_back(control.id);
+      for (const auto &target : inst.targets)
+        gate.gate.targets.push_back(target.id);
+      gates.push_back(std::move(gate));
+    }
+    return gates;
+  }
+
+  static void checkSameGates(const std::vector<traced_gate> &expected,
+                             const std::vector<traced_gate> &actual) {
+    bool same = expected.size() == actual.size();
+    for (std::size_t g = 0; same && g < expected.size(); ++g)
+      same = expected[g].name == actual[g].name &&
+             expected[g].gate.controls == actual[g].gate.controls &&
+             expected[g].gate.targets == actual[g].gate.targets;
+    if (!same)
+      throw std::runtime_error(
+          "The adjoint gradient requires a kernel that applies the same gates "
+          "for all parameter values.");
+  }
+
+  /// @brief Return the derivative of the gate matrix with respect to its
+  /// angle `k`. The entries of every named gate matrix are trigonometric
+  /// polynomials of each angle with frequencies 1/2 and 1, for which
+  /// `(1 - sqrt(2)) / 4 * (U(a + pi) - U(a - pi)) +
+  ///  1 / 2 * (U(a + pi/2) - U(a - pi/2))` is the exact derivative.
+  static std::vector<std::complex<double>>
+  gateDerivative(nvqir::GateName name, std::vector<double> params,
+                 std::size_t k) {
+    const double angle = params[k];
+    const std::pair<double, double> rules[] = {
+        {M_PI, (1.0 - std::sqrt(2.0)) / 4.0}, {M_PI_2, 0.5}};
+    std::vector<std::complex<double>> derivative;
+    for (const auto &[shift, weight] : rules) {
+      params[k] = angle + shift;
+      const auto plus = nvqir::getGateByName<double>(name, params);
+      params[k] = angle - shift;
+      const auto minus = nvqir::getGateByName<double>(name, params);
+      derivative.resize(plus.size());
+      for (std::size_t i = 0; i < plus.size(); ++i)
+        derivative[i] += weight * (plus[i] - minus[i]);
+    }
+    return derivative;
+  }
+
+  /// @brief Write `h |psi>` to `out`. Qubit `q` maps to bit
+  /// `numQubits - 1 - q` of the amplitude index, as for the gates.
+  static void applySpinOp(const spin_op &h, std::size_t numQubits,
+                          const std::complex<double> *psi,
+                          std::complex<double> *out) {
+    const std::int64_t dim = 1LL << numQubits;
+    std::fill(out, out + dim, std::complex<double>(0.0, 0.0));
+    static const std::complex<double> powersOfI[] = {
+        {1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+    for (const auto &term : h) {
+      const auto word = term.get_pauli_word(numQubits);
+      std::size_t xMask = 0, zMask = 0, numY = 0;
+      for (std::size_t q = 0; q < numQubits; ++q) {
+        const std::size_t bit = 1ULL << (numQubits - 1 - q);
+        if (word[q] == 'X' || word[q] == 'Y')
+          xMask |= bit;
+        if (word[q] == 'Z' || word[q] == 'Y')
+          zMask |= bit;
+        numY += word[q] == 'Y';
+      }
+      // P |j> = i^numY (-1)^popcount(j & zMask) |j ^ xMask>
+      const auto phase = term.evaluate_coefficient() * powersOfI[numY % 4];
+#if defined(_OPENMP)
+#pragma omp parallel for if (dim >= (1LL << 14))
+#endif
+      for (std::int64_t j = 0; j < dim; ++j) {
+        const std::size_t source = j ^ xMask;
+        const auto amplitude = phase * psi[source];
+        out[j] +=
+            std::popcount(source & zMask) % 2 ? -amplitude : amplitude;
+      }
+    }
+  }
+};
+} // namespace cudaq::gradients
@@ -25,18 +25,23 @@ public:
 
   void compute(const std::vector<double> &x, std::vector<double> &dx,
                const spin_op &h, double exp_h) override {
+    std::vector<std::vector<double>> points;
+    points.reserve(2 * x.size());
     auto tmpX = x;
     for (std::size_t i = 0; i < x.size(); i++) {
       // increase value to x_i + dx_i
       tmpX[i] += step;
-      auto px = getExpectedValue(tmpX, h);
+      points.push_back(tmpX);
       // decrease the value to x_i - dx_i
       tmpX[i] -= 2 * step;
-      auto mx = getExpectedValue(tmpX, h);
+      points.push_back(tmpX);
       // return value back to x_i
       tmpX[i] += step;
-      dx[i] = (px - mx) / (2. * step);
     }
+    // Evaluate all shifted points at once, spread over the available QPUs.
+    auto values = getExpectedValues(points, h);
+    for (std::size_t i = 0; i < x.size(); i++)
+      dx[i] = (values[2 * i] - values[2 * i + 1]) / (2. * step);
   }
 
   /// @brief Compute the `central_difference` gradient for the arbitrary
@@ -28,15 +28,20 @@ public:
   /// @brief Compute the `forward_difference` gradient
   void compute(const std::vector<double> &x, std::vector<double> &dx,
                const spin_op &h, double funcAtX) override {
+    std::vector<std::vector<double>> points;
+    points.reserve(x.size());
     auto tmpX = x;
     for (std::size_t i = 0; i < x.size(); i++) {
       // increase value to x_i + dx_i
       tmpX[i] += step;
-      auto px = getExpectedValue(tmpX, h);
+      points.push_back(tmpX);
       // return value back to x_i
       tmpX[i] -= step;
-      dx[i] = (px - funcAtX) / step;
     }
+    // Evaluate all shifted points at once, spread over the available QPUs.
+    auto values = getExpectedValues(points, h);
+    for (std::size_t i = 0; i < x.size(); i++)
+      dx[i] = (values[i] - funcAtX) / step;
   }
 
   /// @brief Compute the `forward_difference` gradient for the arbitrary
@@ -452,12 +452,13 @@ std::vector<observe_result> observe(QuantumKernel &&kernel, const spin_op &H,
   auto &platform = cudaq::get_platform();
   auto numQpus = platform.num_qpus();
 
+  auto kernelName = cudaq::getKernelName(kernel);
+
   // Create the functor that will broadcast the observations across
   // all requested argument sets provided.
   details::BroadcastFunctorType<observe_result, Args...> functor =
       [&](std::size_t qpuId, std::size_t counter, std::size_t N,
           Args &...singleIterParameters) -> observe_result {
-    auto kernelName = cudaq::getKernelName(kernel);
     auto ret =
         details::runObservation(
             [&kernel, &singleIterParameters...]() mutable {
@@ -491,12 +492,13 @@ std::vector<observe_result> observe(std::size_t shots, QuantumKernel &&kernel,
   auto &platform = cudaq::get_platform();
   auto numQpus = platform.num_qpus();
 
+  auto kernelName = cudaq::getKernelName(kernel);
+
   // Create the functor that will broadcast the observations across
   // all requested argument sets provided.
   details::BroadcastFunctorType<observe_result, Args...> functor =
       [&](std::size_t qpuId, std::size_t counter, std::size_t N,
           Args &...singleIterParameters) -> observe_result {
-    auto kernelName = cudaq::getKernelName(kernel);
     auto ret = details::runObservation(
                    [&kernel, &singleIterParameters...]() mutable {
                      kernel(std::forward<Args>(singleIterParameters)...);
@@ -531,12 +533,13 @@ std::vector<observe_result> observe(cudaq::observe_options &options,
 
   platform.set_noise(&options.noise);
 
+  auto kernelName = cudaq::getKernelName(kernel);
+
   // Create the functor that will broadcast the observations across
   // all requested argument sets provided.
   details::BroadcastFunctorType<observe_result, Args...> functor =
       [&](std::size_t qpuId, std::size_t counter, std::size_t N,
           Args &...singleIterParameters) -> observe_result {
-    auto kernelName = cudaq::getKernelName(kernel);
     auto ret = details::runObservation(
                    [&kernel, &singleIterParameters...]() mutable {
                      kernel(std::forward<Args>(singleIterParameters)...);
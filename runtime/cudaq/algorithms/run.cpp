@@ -11,6 +11,42 @@
 #include "common/Timing.h"
 #include "cudaq/runtime/logger/logger.h"
 #include "cudaq/simulators.h"
+#include <algorithm>
+
+namespace {
+/// Return true if the platform executes all the shots of a `run` in a single
+/// (remote or emulated) launch, rather than one launch per shot.
+bool launchesAllShotsAtOnce(cudaq::quantum_platform &platform) {
+  return platform.is_remote() || platform.is_emulated() ||
+         platform.get_remote_capabilities().isRemoteSimulator;
+}
+
+/// Launch the kernel once in a `run` context of \p shots shots and return the
+/// output log of all the shots.
+std::string launchAllShots(std::function<void()> &kernel,
+                           cudaq::quantum_platform &platform,
+                           std::size_t shots, std::size_t qpu_id,
+                           bool allowCaching) {
+  cudaq::ExecutionContext ctx("run", shots, qpu_id);
+  ctx.allowJitEngineCaching = allowCaching;
+  platform.with_execution_context(ctx, std::move(kernel));
+  // FIXME: this currently assumes all the shots are good.
+  return std::string(ctx.invocationResultBuffer.begin(),
+                     ctx.invocationResultBuffer.end());
+}
+
+/// Copy the data decoded by \p parser into a `malloc`-ed buffer and return
+/// it as a span. NB: it is the responsibility of the caller to free the
+/// buffer.
+cudaq::details::RunResultSpan
+copyParsedResults(const cudaq::RecordLogParser &parser) {
+  auto *origBuffer = parser.getBufferPtr();
+  std::size_t bufferSize = parser.getBufferSize();
+  char *buffer = static_cast<char *>(malloc(bufferSize));
+  std::memcpy(buffer, origBuffer, bufferSize);
+  return {buffer, bufferSize};
+}
+} // namespace
 
 cudaq::details::RunResultSpan cudaq::details::runTheKernel(
     std::function<void()> &&kernel, quantum_platform &platform,
@@ -28,19 +64,13 @@ cudaq::details::RunResultSpan cudaq::details::runTheKernel(
     throw std::runtime_error("`run` is not yet supported on this target.");
 
   // 2. Launch the kernel on the QPU.
-  if (platform.is_remote() || platform.is_emulated() ||
-      platform.get_remote_capabilities().isRemoteSimulator) {
+  if (launchesAllShotsAtOnce(platform)) {
     // In a remote simulator execution or hardware emulation environment, set
-    // the `run` context name and number of iterations (shots)
-    cudaq::ExecutionContext ctx("run", shots, qpu_id);
-    ctx.allowJitEngineCaching = allowCaching;
-    // Launch the kernel a single time to post the 'run' request to the remote
-    // server or emulation executor.
-    platform.with_execution_context(ctx, std::move(kernel));
-    // Retrieve the result output log.
-    // FIXME: this currently assumes all the shots are good.
-    std::string remoteOutputLog(ctx.invocationResultBuffer.begin(),
-                                ctx.invocationResultBuffer.end());
+    // the `run` context name and number of iterations (shots) and launch the
+    // kernel a single time to post the 'run' request to the remote server or
+    // emulation executor. Then retrieve the result output log.
+    auto remoteOutputLog =
+        launchAllShots(kernel, platform, shots, qpu_id, allowCaching);
     circuitSimulator->outputLog.swap(remoteOutputLog);
   } else {
     cudaq::ExecutionContext ctx("run", 1, qpu_id);
@@ -56,16 +86,79 @@ cudaq::details::RunResultSpan cudaq::details::runTheKernel(
   cudaq::RecordLogParser parser(layoutInfo);
   parser.parse(circuitSimulator->outputLog);
 
-  // 4. Get the buffer and length of buffer (in bytes) from the parser.
-  auto *origBuffer = parser.getBufferPtr();
-  std::size_t bufferSize = parser.getBufferSize();
-  char *buffer = static_cast<char *>(malloc(bufferSize));
-  std::memcpy(buffer, origBuffer, bufferSize);
+  // 4. Get a copy of the buffer decoded by the parser.
+  auto span = copyParsedResults(parser);
 
   // 5. Clear the outputLog (?)
   circuitSimulator->outputLog.clear();
 
   // 6. Pass the span back as a RunResultSpan. NB: it is the responsibility of
   // the caller to free the buffer.
-  return {buffer, bufferSize};
+  return span;
+}
+
+std::size_t cudaq::details::runTheKernelStreaming(
+    std::function<void()> &&kernel, quantum_platform &platform,
+    const std::string &kernel_name, const std::string &original_name,
+    std::size_t shots,
+    const cudaq_internal::compiler::LayoutInfoType &layoutInfo,
+    std::size_t chunkShots, std::size_t maxBufferedBytes,
+    const std::function<bool(RunResultSpan &)> &onChunk, std::size_t qpu_id,
+    bool allowCaching) {
+  ScopedTraceWithContext(cudaq::TIMING_RUN, "runTheKernelStreaming");
+  auto *circuitSimulator = nvqir::getCircuitSimulatorInternal();
+  circuitSimulator->outputLog.clear();
+
+  if (!platform.get_codegen_config().outputLog)
+    throw std::runtime_error("`run` is not yet supported on this target.");
+
+  if (chunkShots == 0)
+    chunkShots = shots;
+
+  // A single parser decodes all the chunks, so that the schema and metadata
+  // records of the log carry over from one chunk to the next.
+  cudaq::RecordLogParser parser(layoutInfo);
+  // Decode the pending output log, hand it to the callback and release it.
+  // Return false if the callback asked to stop.
+  auto deliverChunk = [&]() {
+    parser.parse(circuitSimulator->outputLog);
+    circuitSimulator->outputLog.clear();
+    auto span = copyParsedResults(parser);
+    parser.clearBuffer();
+    return onChunk(span);
+  };
+
+  std::size_t completedShots = 0;
+  if (launchesAllShotsAtOnce(platform)) {
+    // Post one request per chunk.
+    while (completedShots < shots) {
+      const auto numShots = std::min(chunkShots, shots - completedShots);
+      auto remoteOutputLog =
+          launchAllShots(kernel, platform, numShots, qpu_id, allowCaching);
+      circuitSimulator->outputLog.swap(remoteOutputLog);
+      completedShots += numShots;
+      if (!deliverChunk())
+        break;
+    }
+  } else {
+    cudaq::ExecutionContext ctx("run", 1, qpu_id);
+    ctx.allowJitEngineCaching = allowCaching;
+    std::size_t pendingShots = 0;
+    while (completedShots < shots) {
+      platform.with_execution_context(ctx, std::move(kernel));
+      ++completedShots;
+      // Deliver the chunk once it is full, or earlier if the output log
+      // reached the memory budget.
+      if (++pendingShots < chunkShots && completedShots < shots &&
+          (maxBufferedBytes == 0 ||
+           circuitSimulator->outputLog.size() < maxBufferedBytes))
+        continue;
+      pendingShots = 0;
+      if (!deliverChunk())
+        break;
+    }
+  }
+
+  circuitSimulator->outputLog.clear();
+  return completedShots;
 }
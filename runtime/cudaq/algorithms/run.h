@@ -15,6 +15,7 @@
 #include "cudaq/host_config.h"
 #include "cudaq/platform/QuantumExecutionQueue.h"
 #include "cudaq/qis/kernel_utils.h"
+#include <algorithm>
 #include <cstdint>
 
 extern "C" {
@@ -55,6 +56,21 @@ runTheKernel(std::function<void()> &&kernel, quantum_platform &platform,
              const cudaq_internal::compiler::LayoutInfoType &layoutInfo,
              std::size_t qpu_id = 0, bool allowCaching = true);
 
+// Streaming variant of `runTheKernel`. The shots are executed in chunks of at
+// most \p chunkShots shots. After each chunk, its results are decoded and
+// handed to \p onChunk as a span, whose buffer the callback then owns. For
+// locally simulated shots, a chunk is also delivered early once the pending
+// output log reaches \p maxBufferedBytes bytes (if non-zero). Execution stops
+// early if \p onChunk returns false. Returns the number of shots executed.
+std::size_t runTheKernelStreaming(
+    std::function<void()> &&kernel, quantum_platform &platform,
+    const std::string &kernel_name, const std::string &original_name,
+    std::size_t shots,
+    const cudaq_internal::compiler::LayoutInfoType &layoutInfo,
+    std::size_t chunkShots, std::size_t maxBufferedBytes,
+    const std::function<bool(RunResultSpan &)> &onChunk,
+    std::size_t qpu_id = 0, bool allowCaching = true);
+
 // Template to transfer the ownership of the buffer in a RunResultSpan to a
 // `std::vector<T>` object. This special code is required because a
 // `std::vector<T>` will always construct its own data, and own it, using its
@@ -151,6 +167,85 @@ run(std::size_t shots, QuantumKernel &&kernel, ARGS &&...args) {
   return results;
 }
 
+/// @brief Options for `cudaq::run_streaming`.
+struct run_streaming_options {
+  /// @brief Maximum number of shots whose results are delivered to the
+  /// callback at once (0 delivers all the shots at once).
+  std::size_t chunk_size = 1024;
+  /// @brief Bound, in bytes, on the output log of locally simulated shots held
+  /// before a chunk is decoded and delivered, even if it has fewer than
+  /// `chunk_size` shots (0 for no bound).
+  std::size_t max_buffered_bytes = 0;
+};
+
+/// @brief Run a kernel \p shots number of times, handing the results to
+/// \p callback in chunks as they are produced instead of returning them all
+/// at once. The callback receives a `std::vector` of results, which it may
+/// move from, and returns false to stop the run before all the shots are
+/// executed. At most one chunk of results is held in memory at a time.
+/// @tparam QuantumKernel Quantum kernel type (must return a non-void result)
+/// @tparam Callback Callable type, `bool(std::vector<Result> &&)`
+/// @tparam ...ARGS Quantum kernel argument types
+/// @param shots Number of shots to run
+/// @param options Chunk size and memory budget
+/// @param callback Callback invoked with each chunk of results
+/// @param kernel Quantum kernel
+/// @param ...args Kernel arguments
+/// @return The number of shots executed
+template <typename QuantumKernel, typename Callback, typename... ARGS>
+  requires(!std::is_void_v<std::invoke_result_t<std::decay_t<QuantumKernel>,
+                                                std::decay_t<ARGS>...>> &&
+           std::is_invocable_r_v<
+               bool, Callback,
+               std::vector<std::invoke_result_t<std::decay_t<QuantumKernel>,
+                                                std::decay_t<ARGS>...>> &&>)
+std::size_t run_streaming(std::size_t shots,
+                          const run_streaming_options &options,
+                          Callback &&callback, QuantumKernel &&kernel,
+                          ARGS &&...args) {
+  if (shots == 0)
+    return 0;
+  using ResultTy =
+      std::invoke_result_t<std::decay_t<QuantumKernel>, std::decay_t<ARGS>...>;
+  auto &platform = get_platform();
+#ifdef CUDAQ_LIBRARY_MODE
+  cudaq::ExecutionContext ctx("run", 1);
+  // Direct kernel invocation loop for library mode
+  const std::size_t chunkSize =
+      options.chunk_size == 0 ? shots : options.chunk_size;
+  std::vector<ResultTy> results;
+  results.reserve(std::min(chunkSize, shots));
+  for (std::size_t i = 0; i < shots;) {
+    results.emplace_back(platform.with_execution_context(
+        ctx, std::forward<QuantumKernel>(kernel), std::forward<ARGS>(args)...));
+    ++i;
+    if (results.size() < chunkSize && i < shots)
+      continue;
+    if (!callback(std::move(results)))
+      return i;
+    results.clear();
+    results.reserve(std::min(chunkSize, shots - i));
+  }
+  return shots;
+#else
+  std::string kernelName{details::getKernelName(kernel)};
+  cudaq_internal::compiler::LayoutInfoType layoutInfo =
+      cudaq_internal::compiler::getLayoutInfo(kernelName, nullptr);
+  return details::runTheKernelStreaming(
+      [&]() mutable {
+        auto *runKernel =
+            details::get_run_entry_point(qkernel{kernel}, kernelName);
+        (*runKernel)(std::forward<ARGS>(args)...);
+      },
+      platform, kernelName, kernelName, shots, layoutInfo, options.chunk_size,
+      options.max_buffered_bytes, [&](details::RunResultSpan &span) -> bool {
+        std::vector<ResultTy> results;
+        details::resultSpanToVectorViaOwnership<ResultTy>(results, span);
+        return callback(std::move(results));
+      });
+#endif
+}
+
 /// @brief Run a kernel \p shots number of times with noise and return a
 /// `std::vector` of results.
 /// @tparam QuantumKernel Quantum kernel type (must return a non-void result)
@@ -341,7 +436,9 @@ run_async(std::size_t qpu_id, std::size_t shots,
         p.set_value(std::move(results));
 #endif
       });
-  platform.enqueueAsyncTask(qpu_id, wrapped);
+  // The task sets the noise model of the QPU, so it must not run
+  // concurrently with other tasks on that QPU.
+  platform.enqueueAsyncTask(qpu_id, wrapped, /*ordered=*/true);
   return fut;
 }
 } // namespace cudaq
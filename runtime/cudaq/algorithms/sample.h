@@ -224,8 +224,10 @@ auto runSamplingAsync(KernelFunctor &&wrappedKernel, quantum_platform &platform,
         return result.value();
       });
 
-  return async_sample_result(
-      details::future(platform.enqueueAsyncTask(qpu_id, task)));
+  // A task with its own noise model sets the noise model of the QPU, so it
+  // must not run concurrently with other tasks on that QPU.
+  return async_sample_result(details::future(
+      platform.enqueueAsyncTask(qpu_id, task, /*ordered=*/hasNoise)));
 }
 } // namespace details
 
@@ -475,12 +477,13 @@ std::vector<sample_result> sample(QuantumKernel &&kernel,
   auto &platform = cudaq::get_platform();
   auto numQpus = platform.num_qpus();
 
+  auto kernelName = cudaq::getKernelName(kernel);
+
   // Create the functor that will broadcast the sampling tasks across
   // all requested argument sets provided.
   details::BroadcastFunctorType<sample_result, Args...> functor =
       [&](std::size_t qpuId, std::size_t counter, std::size_t N,
           Args &...singleIterParameters) -> sample_result {
-    auto kernelName = cudaq::getKernelName(kernel);
     auto ret = details::runSampling(
                    [&kernel, &singleIterParameters...]() mutable {
                      kernel(std::forward<Args>(singleIterParameters)...);
@@ -512,12 +515,13 @@ std::vector<sample_result> sample(std::size_t shots, QuantumKernel &&kernel,
   auto &platform = cudaq::get_platform();
   auto numQpus = platform.num_qpus();
 
+  auto kernelName = cudaq::getKernelName(kernel);
+
   // Create the functor that will broadcast the sampling tasks across
   // all requested argument sets provided.
   details::BroadcastFunctorType<sample_result, Args...> functor =
       [&](std::size_t qpuId, std::size_t counter, std::size_t N,
           Args &...singleIterParameters) -> sample_result {
-    auto kernelName = cudaq::getKernelName(kernel);
     auto ret = details::runSampling(
                    [&kernel, &singleIterParameters...]() mutable {
                      kernel(std::forward<Args>(singleIterParameters)...);
@@ -554,13 +558,14 @@ std::vector<sample_result> sample(const sample_options &options,
   if (!options.noise.empty())
     platform.set_noise(&options.noise);
 
+  auto kernelName = cudaq::getKernelName(kernel);
+
   // Create the functor that will broadcast the sampling tasks across
   // all requested argument sets provided.
   details::BroadcastFunctorType<sample_result, Args...> functor =
       [&, explicit_mz = options.explicit_measurements](
           std::size_t qpuId, std::size_t counter, std::size_t N,
           Args &...singleIterParameters) -> sample_result {
-    auto kernelName = cudaq::getKernelName(kernel);
     auto ret = details::runSampling(
                    [&kernel, &singleIterParameters...]() mutable {
                      kernel(std::forward<Args>(singleIterParameters)...);
@@ -594,12 +599,13 @@ sample_n(QuantumKernel &&kernel, ArgumentSet<Args...> &&params) {
   auto &platform = cudaq::get_platform();
   auto numQpus = platform.num_qpus();
 
+  auto kernelName = cudaq::getKernelName(kernel);
+
   // Create the functor that will broadcast the sampling tasks across
   // all requested argument sets provided.
   details::BroadcastFunctorType<sample_result, Args...> functor =
       [&](std::size_t qpuId, std::size_t counter, std::size_t N,
           Args &...singleIterParameters) -> sample_result {
-    auto kernelName = cudaq::getKernelName(kernel);
     auto ret = details::runSampling(
                    [&kernel, &singleIterParameters...]() mutable {
                      kernel(std::forward<Args>(singleIterParameters)...);
@@ -632,12 +638,13 @@ sample_n(std::size_t shots, QuantumKernel &&kernel,
   auto &platform = cudaq::get_platform();
   auto numQpus = platform.num_qpus();
 
+  auto kernelName = cudaq::getKernelName(kernel);
+
   // Create the functor that will broadcast the sampling tasks across
   // all requested argument sets provided.
   details::BroadcastFunctorType<sample_result, Args...> functor =
       [&](std::size_t qpuId, std::size_t counter, std::size_t N,
           Args &...singleIterParameters) -> sample_result {
-    auto kernelName = cudaq::getKernelName(kernel);
     auto ret = details::runSampling(
                    [&kernel, &singleIterParameters...]() mutable {
                      kernel(std::forward<Args>(singleIterParameters)...);
@@ -12,6 +12,7 @@
 #include "cudaq/algorithms/draw.h"
 #include "cudaq/operators/matrix.h"
 #include "nvqir/Gates.h"
+#include <algorithm>
 #include <iostream>
 
 namespace cudaq::contrib {
@@ -100,45 +101,266 @@ expand_gate_to_system(const complex_matrix &gate, std::size_t num_qudits,
   return result;
 }
 
+namespace detail {
+
+/// @brief A gate of a trace: its row-major matrix on the targets, where
+/// `targets[0]` is the most significant bit of the matrix index, and its
+/// control qubits.
+struct unitary_gate {
+  std::vector<std::complex<double>> matrix;
+  std::vector<std::size_t> controls;
+  std::vector<std::size_t> targets;
+};
+
+/// @brief The amplitude groups of a (possibly controlled) gate on a
+/// `num_qubits` state, in which qubit `q` maps to bit `num_qubits - 1 - q` of
+/// the amplitude index. A group is the set of amplitudes that only differ in
+/// the target bits, with all control bits set; the gate matrix acts on each
+/// group independently.
+struct gate_layout {
+  /// Offset of each local (matrix) index within a group.
+  std::vector<std::size_t> offsets;
+  /// First amplitude index of each group.
+  std::vector<std::size_t> bases;
+
+  gate_layout(std::size_t num_qubits, const unitary_gate &gate) {
+    const std::size_t num_targets = gate.targets.size();
+    auto bit_of = [&](std::size_t q) { return num_qubits - 1 - q; };
+
+    std::size_t control_mask = 0;
+    std::vector<std::size_t> positions;
+    positions.reserve(gate.controls.size() + num_targets);
+    for (auto c : gate.controls) {
+      control_mask |= 1ULL << bit_of(c);
+      positions.push_back(bit_of(c));
+    }
+    for (auto t : gate.targets)
+      positions.push_back(bit_of(t));
+    std::sort(positions.begin(), positions.end());
+
+    offsets.assign(1ULL << num_targets, 0);
+    for (std::size_t r = 0; r < offsets.size(); ++r)
+      for (std::size_t j = 0; j < num_targets; ++j)
+        if (r & (1ULL << (num_targets - 1 - j)))
+          offsets[r] |= 1ULL << bit_of(gate.targets[j]);
+
+    // The group number with a zero bit inserted at every gate position, and
+    // the control bits set.
+    bases.resize((1ULL << num_qubits) >> positions.size());
+    for (std::size_t g = 0; g < bases.size(); ++g) {
+      std::size_t base = g;
+      for (auto p : positions) {
+        const std::size_t low = (1ULL << p) - 1;
+        base = ((base & ~low) << 1) | (base & low);
+      }
+      bases[g] = base | control_mask;
+    }
+  }
+};
+
+/// @brief Left-multiply the column-major matrix `u`, made of `num_columns`
+/// columns of dimension `2^num_qubits`, by a (possibly controlled) gate, in
+/// place.
+///
+/// Every column is updated as a state vector: the small gate matrix is applied
+/// to each amplitude group of the `gate_layout`. The cost is
+/// `O(num_columns * 2^n * 2^k)` for a gate on `k` targets, rather than the
+/// `O(num_columns * 4^n)` of a dense product with the gate expanded to the
+/// whole system. The groups of all columns are distributed over OpenMP
+/// threads.
+inline void apply_gate_to_columns(std::complex<double> *u,
+                                  std::size_t num_qubits,
+                                  std::size_t num_columns,
+                                  const unitary_gate &gate) {
+  const std::size_t dim = 1ULL << num_qubits;
+  const std::size_t local_dim = 1ULL << gate.targets.size();
+  const gate_layout layout(num_qubits, gate);
+  const auto &offsets = layout.offsets;
+  const auto &bases = layout.bases;
+
+  const std::int64_t num_groups = bases.size();
+  const std::int64_t num_tasks = num_groups * num_columns;
+#if defined(_OPENMP)
+#pragma omp parallel if (num_columns * dim >= (1ULL << 14))
+#endif
+  {
+    std::vector<std::complex<double>> in(local_dim);
+#if defined(_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (std::int64_t task = 0; task < num_tasks; ++task) {
+      auto *column = u + (task / num_groups) * dim;
+      const auto base = bases[task % num_groups];
+      bool is_zero = true;
+      for (std::size_t r = 0; r < local_dim; ++r) {
+        in[r] = column[base | offsets[r]];
+        is_zero = is_zero && in[r] == 0.0;
+      }
+      // The unitary is sparse until the circuit spreads it out.
+      if (is_zero)
+        continue;
+      for (std::size_t r = 0; r < local_dim; ++r) {
+        const auto *row = gate.matrix.data() + r * local_dim;
+        double re = 0, im = 0;
+        // Multiply on the real and imaginary parts, which, unlike
+        // `std::complex` products, vectorizes without NaN recovery.
+        for (std::size_t s = 0; s < local_dim; ++s) {
+          re += row[s].real() * in[s].real() - row[s].imag() * in[s].imag();
+          im += row[s].real() * in[s].imag() + row[s].imag() * in[s].real();
+        }
+        column[base | offsets[r]] = {re, im};
+      }
+    }
+  }
+}
+
+/// @brief Return `<a| G |b>` for two `2^num_qubits`-dimensional state vectors,
+/// where `G` applies the gate matrix to the amplitude groups of the
+/// `gate_layout` and is zero elsewhere. For the derivative of a controlled
+/// gate's matrix, that is the derivative of the full controlled gate.
+inline std::complex<double> gate_inner_product(const std::complex<double> *a,
+                                               const std::complex<double> *b,
+                                               std::size_t num_qubits,
+                                               const unitary_gate &gate) {
+  const std::size_t local_dim = 1ULL << gate.targets.size();
+  const gate_layout layout(num_qubits, gate);
+  const auto &offsets = layout.offsets;
+  const auto &bases = layout.bases;
+
+  const std::int64_t num_groups = bases.size();
+  double sum_re = 0, sum_im = 0;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : sum_re, sum_im)                         \
+    if ((1ULL << num_qubits) >= (1ULL << 14))
+#endif
+  for (std::int64_t g = 0; g < num_groups; ++g) {
+    const auto base = bases[g];
+    for (std::size_t r = 0; r < local_dim; ++r) {
+      const auto *row = gate.matrix.data() + r * local_dim;
+      double re = 0, im = 0;
+      for (std::size_t s = 0; s < local_dim; ++s) {
+        const auto in = b[base | offsets[s]];
+        re += row[s].real() * in.real() - row[s].imag() * in.imag();
+        im += row[s].real() * in.imag() + row[s].imag() * in.real();
+      }
+      // conj(a) * (re + i im)
+      const auto out = a[base | offsets[r]];
+      sum_re += out.real() * re + out.imag() * im;
+      sum_im += out.real() * im - out.imag() * re;
+    }
+  }
+  return {sum_re, sum_im};
+}
+
+/// @brief Fuse runs of consecutive gates that together act on at most
+/// `max_qubits` qubits into a single dense gate on those qubits, so that the
+/// system unitary is swept once per run rather than once per gate.
+inline std::vector<unitary_gate> fuse_gates(std::vector<unitary_gate> gates,
+                                            std::size_t max_qubits) {
+  std::vector<unitary_gate> fused;
+  std::vector<unitary_gate> run;
+  std::vector<std::size_t> run_qubits;
+
+  auto flush = [&]() {
+    if (run.size() == 1)
+      fused.push_back(std::move(run.front()));
+    else if (!run.empty()) {
+      // Build the matrix of the run on its own qubits, in local indices.
+      const std::size_t num_local = run_qubits.size();
+      const std::size_t local_dim = 1ULL << num_local;
+      auto local = [&](std::size_t q) {
+        return static_cast<std::size_t>(
+            std::find(run_qubits.begin(), run_qubits.end(), q) -
+            run_qubits.begin());
+      };
+      std::vector<std::complex<double>> block(local_dim * local_dim);
+      for (std::size_t i = 0; i < local_dim; ++i)
+        block[i * local_dim + i] = 1.0;
+      for (auto &gate : run) {
+        for (auto &c : gate.controls)
+          c = local(c);
+        for (auto &t : gate.targets)
+          t = local(t);
+        apply_gate_to_columns(block.data(), num_local, local_dim, gate);
+      }
+      // The block is column-major, gate matrices are row-major.
+      unitary_gate result{std::vector<std::complex<double>>(block.size()),
+                          {},
+                          run_qubits};
+      for (std::size_t r = 0; r < local_dim; ++r)
+        for (std::size_t c = 0; c < local_dim; ++c)
+          result.matrix[r * local_dim + c] = block[c * local_dim + r];
+      fused.push_back(std::move(result));
+    }
+    run.clear();
+    run_qubits.clear();
+  };
+
+  for (auto &gate : gates) {
+    auto qubits = run_qubits;
+    for (const auto *list : {&gate.controls, &gate.targets})
+      for (auto q : *list)
+        if (std::find(qubits.begin(), qubits.end(), q) == qubits.end())
+          qubits.push_back(q);
+    if (qubits.size() > max_qubits) {
+      flush();
+      qubits.clear();
+      for (const auto *list : {&gate.controls, &gate.targets})
+        qubits.insert(qubits.end(), list->begin(), list->end());
+      if (qubits.size() > max_qubits) {
+        fused.push_back(std::move(gate));
+        continue;
+      }
+    }
+    run_qubits = std::move(qubits);
+    run.push_back(std::move(gate));
+  }
+  flush();
+  return fused;
+}
+
+} // namespace detail
+
 /// @brief Construct the full system unitary from a Trace of quantum
 /// instructions.
+///
+/// Starting from the identity, every gate is applied in place to the columns
+/// of the unitary, which costs `O(4^n)` per gate. Unless `max_fused_qubits` is
+/// below 2, runs of consecutive gates spanning at most that many qubits are
+/// first fused into one gate.
 /// @param trace The Trace object recording the sequence of quantum operations.
+/// @param max_fused_qubits The maximum number of qubits of a fused gate.
 /// @returns A complex_matrix representing the overall unitary of the traced
 /// kernel.
-inline complex_matrix unitary_from_trace(const Trace &trace) {
-  auto num_qubits = trace.getNumQudits();
-  std::size_t dim = 1ULL << num_qubits;
-  complex_matrix U = complex_matrix::identity(dim);
+inline complex_matrix unitary_from_trace(const Trace &trace,
+                                         std::size_t max_fused_qubits = 2) {
+  const std::size_t num_qubits = trace.getNumQudits();
+  const std::size_t dim = 1ULL << num_qubits;
 
+  std::vector<detail::unitary_gate> gates;
   for (const auto &inst : trace) {
     auto gate_name = nvqir::getGateNameFromString(inst.name);
-    auto gate_vec = nvqir::getGateByName<double>(gate_name, inst.params);
-    std::size_t gate_dim = static_cast<std::size_t>(std::sqrt(gate_vec.size()));
-    complex_matrix gate(gate_vec, {gate_dim, gate_dim});
-
-    // If there are control qubits, build the controlled-unitary
-    if (!inst.controls.empty()) {
-      gate = make_controlled_unitary(gate, inst.controls.size());
-      gate_dim = gate.rows();
-    }
-
-    // Get vector of all qubit indices that this gate operates on
-    // The control qubits are expected to be at the start of the vector,
-    std::vector<std::size_t> inst_qubits;
-    inst_qubits.reserve(inst.controls.size() + inst.targets.size());
-    for (const auto &control : inst.controls) {
-      inst_qubits.push_back(control.id);
-    }
-    for (const auto &target : inst.targets) {
-      inst_qubits.push_back(target.id);
-    }
+    detail::unitary_gate gate{
+        nvqir::getGateByName<double>(gate_name, inst.params), {}, {}};
+    for (const auto &control : inst.controls)
+      gate.controls.push_back(control.id);
+    for (const auto &target : inst.targets)
+      gate.targets.push_back(target.id);
+    gates.push_back(std::move(gate));
+  }
+  if (max_fused_qubits >= 2)
+    gates = detail::fuse_gates(std::move(gates), max_fused_qubits);
 
-    // Expand gate to full system
-    auto full_gate = expand_gate_to_system(gate, num_qubits, inst_qubits);
+  complex_matrix U(dim, dim, /*set_zero=*/true,
+                   complex_matrix::order::column_major);
+  auto *u = U.get_data(complex_matrix::order::column_major);
+  for (std::size_t i = 0; i < dim; ++i)
+    u[i * dim + i] = 1.0;
+  for (const auto &gate : gates)
+    detail::apply_gate_to_columns(u, num_qubits, dim, gate);
 
-    // Left-multiply the system unitary
-    U = full_gate * U;
-  }
+  // Hand back the default (row-major) layout.
+  U.get_data(complex_matrix::order::row_major);
   return U;
 }
 
@@ -38,6 +38,26 @@ remote_vqe(cudaq::quantum_platform &platform, QuantumKernel &&kernel,
   return ctx.optResult.value_or(optimization_result{});
 }
 
+/// \brief Compute the VQE objective, the expected value of \p H, for the given
+/// kernel arguments. If the platform exposes more than one QPU, the terms of
+/// \p H are split among all of them and observed concurrently with
+/// `observe_async`, unless a noise model is set. That noise model only applies
+/// to QPU 0, so noisy objectives are observed there.
+template <typename QuantumKernel, typename... Args>
+static inline double observe_objective(QuantumKernel &kernel,
+                                       const cudaq::spin_op &H,
+                                       Args &&...args) {
+  auto &platform = cudaq::get_platform();
+  if (auto nQpus = platform.num_qpus(); nQpus > 1 && !platform.get_noise())
+    return details::distributeComputations(
+               [&](std::size_t i, const spin_op &op) {
+                 return observe_async(i, kernel, op, args...);
+               },
+               H, nQpus)
+        .expectation();
+  return cudaq::observe(kernel, H, std::forward<Args>(args)...);
+}
+
 static inline void print_arg_mapper_warning() {
   printf(
       "WARNING: Usage of ArgMapper type on this platform will result in "
@@ -114,7 +134,7 @@ optimization_result vqe(QuantumKernel &&kernel, cudaq::spin_op H,
 
   return optimizer.optimize(n_params, [&](const std::vector<double> &x,
                                           std::vector<double> &grad_vec) {
-    double e = cudaq::observe(kernel, H, x, args...);
+    double e = __internal__::observe_objective(kernel, H, x, args...);
     return e;
   });
 }
@@ -268,7 +288,7 @@ optimization_result vqe(QuantumKernel &&kernel, cudaq::gradient &gradient,
   }();
   return optimizer.optimize(n_params, [&](const std::vector<double> &x,
                                           std::vector<double> &grad_vec) {
-    double e = cudaq::observe(kernel, H, x, args...);
+    double e = __internal__::observe_objective(kernel, H, x, args...);
     if (requires_grad)
       newGrad->compute(x, grad_vec, H, e);
     return e;
@@ -349,7 +369,7 @@ optimization_result vqe(QuantumKernel &&kernel, cudaq::spin_op H,
     auto args = argsMapper(x);
     double energy = std::apply(
         [&](auto &&...arg) -> double {
-          return cudaq::observe(kernel, H, arg...);
+          return __internal__::observe_objective(kernel, H, arg...);
         },
         args);
     return energy;
@@ -483,7 +503,7 @@ optimization_result vqe(QuantumKernel &&kernel, cudaq::gradient &gradient,
     auto args = argsMapper(x);
     double energy = std::apply(
         [&](auto &&...arg) -> double {
-          return cudaq::observe(kernel, H, arg...);
+          return __internal__::observe_objective(kernel, H, arg...);
         },
         args);
     if (requiresGrad) {
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "algorithms/gradients/adjoint.h"
 #include "algorithms/gradients/central_difference.h"
 #include "algorithms/gradients/forward_difference.h"
 #include "algorithms/gradients/parameter_shift.h"
@@ -929,6 +929,15 @@ private:
   PROPERTY_SPECIFIC_TEMPLATE(product_op<T>::supports_inplace_mult)
   void insert(T &&other);
 
+  // multiplies the given operators, which must be in canonical order, into
+  // this product (from the right)
+  void multiply_by(const std::vector<HandlerTy> &other_operators);
+  void multiply_by(std::vector<HandlerTy> &&other_operators);
+
+  // key under which sum_op aggregates terms; identifies the same terms as
+  // get_term_id, but may use a more compact (not human-readable) encoding
+  std::string get_term_key() const;
+
   void aggregate_terms();
 
   template <typename... Args>
@@ -190,6 +190,107 @@ void product_op<spin_handler>::insert(T &&other) {
     this->operators.insert(pos, std::move(other));
 }
 
+template <typename HandlerTy>
+void product_op<HandlerTy>::multiply_by(
+    const std::vector<HandlerTy> &other_operators) {
+  for (HandlerTy op : other_operators)
+    this->insert(std::move(op));
+}
+
+template <typename HandlerTy>
+void product_op<HandlerTy>::multiply_by(
+    std::vector<HandlerTy> &&other_operators) {
+  for (auto &&op : other_operators)
+    this->insert(std::move(op));
+}
+
+template <>
+void product_op<spin_handler>::multiply_by(
+    const std::vector<spin_handler> &other_operators) {
+  // Both products act at most once on each degree and are sorted by degree,
+  // so their product is a linear merge. Each Pauli product on a shared degree
+  // XORs the op codes (bit 0 = Z, bit 1 = X) and contributes a phase i^k; we
+  // accumulate k and only update the coefficient once at the end.
+  // phase_exponent[lhs][rhs] for I = 0, Z = 1, X = 2, Y = 3
+  static constexpr unsigned phase_exponent[4][4] = {
+      {0, 0, 0, 0}, {0, 0, 1, 3}, {0, 3, 0, 1}, {0, 1, 3, 0}};
+  std::vector<spin_handler> merged;
+  merged.reserve(this->operators.size() + other_operators.size());
+  unsigned phase = 0;
+  auto it = this->operators.cbegin();
+  auto other_it = other_operators.cbegin();
+  while (it != this->operators.cend() && other_it != other_operators.cend()) {
+    if (operator_handler::canonical_order(it->degree, other_it->degree))
+      merged.push_back(*it++);
+    else if (operator_handler::canonical_order(other_it->degree, it->degree))
+      merged.push_back(*other_it++);
+    else {
+      phase += phase_exponent[it->op_code][other_it->op_code];
+      merged.push_back(
+          spin_handler(it->degree, it->op_code ^ other_it->op_code));
+      ++it;
+      ++other_it;
+    }
+  }
+  merged.insert(merged.end(), it, this->operators.cend());
+  merged.insert(merged.end(), other_it, other_operators.cend());
+  this->operators = std::move(merged);
+  static const std::complex<double> phases[4] = {
+      {1., 0.}, {0., 1.}, {-1., 0.}, {0., -1.}};
+  if (phase % 4 != 0)
+    this->coefficient *= phases[phase % 4];
+}
+
+template <>
+void product_op<spin_handler>::multiply_by(
+    std::vector<spin_handler> &&other_operators) {
+  this->multiply_by(static_cast<const std::vector<spin_handler> &>(
+      other_operators));
+}
+
+template <typename HandlerTy>
+std::string product_op<HandlerTy>::get_term_key() const {
+  return this->get_term_id();
+}
+
+template <>
+std::string product_op<spin_handler>::get_term_key() const {
+  // Building the term id requires formatting every degree; instead, we pack
+  // the term into bytes. Terms that act on (nearly) all degrees up to the
+  // largest one are stored as a mask with one nibble per degree, holding
+  // op_code + 1 if the term acts on that degree and 0 otherwise. Other terms
+  // are stored as a list of degree * 4 + op_code in LEB128 encoding. The first
+  // byte tags the encoding that is used, and we pick the shorter one, such
+  // that terms with up to 28 degrees fit into the small string buffer.
+  if (this->operators.empty())
+    return {};
+  std::size_t max_degree = 0;
+  std::size_t sparse_size = 1;
+  for (const auto &op : this->operators) {
+    max_degree = std::max(max_degree, op.degree);
+    for (auto value = op.degree << 2; value >= 0x80; value >>= 7)
+      ++sparse_size;
+    ++sparse_size;
+  }
+  const std::size_t dense_size = 1 + max_degree / 2 + 1;
+  std::string key;
+  if (dense_size <= sparse_size) {
+    key.assign(dense_size, '\0');
+    for (const auto &op : this->operators)
+      key[1 + op.degree / 2] |= (op.op_code + 1) << (4 * (op.degree % 2));
+  } else {
+    key.reserve(sparse_size);
+    key.push_back('\1');
+    for (const auto &op : this->operators) {
+      auto value = (op.degree << 2) | static_cast<std::size_t>(op.op_code);
+      for (; value >= 0x80; value >>= 7)
+        key.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      key.push_back(static_cast<char>(value));
+    }
+  }
+  return key;
+}
+
 template <typename HandlerTy>
 void product_op<HandlerTy>::aggregate_terms() {}
 
@@ -297,6 +398,14 @@ EvalTy product_op<HandlerTy>::transform(
                                                                                \
   template void product_op<HandlerTy>::insert(HandlerTy &&other);              \
                                                                                \
+  template void product_op<HandlerTy>::multiply_by(                            \
+      const std::vector<HandlerTy> &other_operators);                          \
+                                                                               \
+  template void product_op<HandlerTy>::multiply_by(                            \
+      std::vector<HandlerTy> &&other_operators);                               \
+                                                                               \
+  template std::string product_op<HandlerTy>::get_term_key() const;           \
+                                                                               \
   template void product_op<HandlerTy>::aggregate_terms(HandlerTy &&item1,      \
                                                        HandlerTy &&item2);     \
                                                                                \
@@ -305,7 +414,15 @@ EvalTy product_op<HandlerTy>::transform(
 
 #define INSTANTIATE_PRODUCT_PRIVATE_FRIEND_METHODS(HandlerTy)                  \
                                                                                \
-  template void product_op<HandlerTy>::insert(HandlerTy &&other);
+  template void product_op<HandlerTy>::insert(HandlerTy &&other);              \
+                                                                               \
+  template void product_op<HandlerTy>::multiply_by(                            \
+      const std::vector<HandlerTy> &other_operators);                          \
+                                                                               \
+  template void product_op<HandlerTy>::multiply_by(                            \
+      std::vector<HandlerTy> &&other_operators);                               \
+                                                                               \
+  template std::string product_op<HandlerTy>::get_term_key() const;
 
 #if !defined(__clang__)
 INSTANTIATE_PRODUCT_PRIVATE_METHODS(matrix_handler);
@@ -714,7 +831,7 @@ template <typename HandlerTy>
 bool product_op<HandlerTy>::operator==(
     const product_op<HandlerTy> &other) const {
   return this->coefficient == other.coefficient &&
-         this->get_term_id() == other.get_term_id();
+         this->get_term_key() == other.get_term_key();
 }
 
 #define INSTANTIATE_PRODUCT_COMPARISONS(HandlerTy)                             \
@@ -880,8 +997,7 @@ product_op<HandlerTy>::operator*(const product_op<HandlerTy> &other) const & {
   product_op<HandlerTy> prod(this->coefficient * other.coefficient,
                              this->operators,
                              this->operators.size() + other.operators.size());
-  for (HandlerTy op : other.operators)
-    prod.insert(std::move(op));
+  prod.multiply_by(other.operators);
   return prod;
 }
 
@@ -890,8 +1006,7 @@ product_op<HandlerTy>
 product_op<HandlerTy>::operator*(const product_op<HandlerTy> &other) && {
   this->coefficient *= other.coefficient;
   this->operators.reserve(this->operators.size() + other.operators.size());
-  for (HandlerTy op : other.operators)
-    this->insert(std::move(op));
+  this->multiply_by(other.operators);
   return std::move(*this);
 }
 
@@ -901,8 +1016,7 @@ product_op<HandlerTy>::operator*(product_op<HandlerTy> &&other) const & {
   product_op<HandlerTy> prod(this->coefficient * std::move(other.coefficient),
                              this->operators,
                              this->operators.size() + other.operators.size());
-  for (auto &&op : other.operators)
-    prod.insert(std::move(op));
+  prod.multiply_by(std::move(other.operators));
   return prod;
 }
 
@@ -911,8 +1025,7 @@ product_op<HandlerTy>
 product_op<HandlerTy>::operator*(product_op<HandlerTy> &&other) && {
   this->coefficient *= std::move(other.coefficient);
   this->operators.reserve(this->operators.size() + other.operators.size());
-  for (auto &&op : other.operators)
-    this->insert(std::move(op));
+  this->multiply_by(std::move(other.operators));
   return std::move(*this);
 }
 
@@ -1082,8 +1195,7 @@ product_op<HandlerTy> &
 product_op<HandlerTy>::operator*=(const product_op<HandlerTy> &other) {
   this->coefficient *= other.coefficient;
   this->operators.reserve(this->operators.size() + other.operators.size());
-  for (HandlerTy op : other.operators)
-    this->insert(std::move(op));
+  this->multiply_by(other.operators);
   return *this;
 }
 
@@ -1092,8 +1204,7 @@ product_op<HandlerTy> &
 product_op<HandlerTy>::operator*=(product_op<HandlerTy> &&other) {
   this->coefficient *= std::move(other.coefficient);
   this->operators.reserve(this->operators.size() + other.operators.size());
-  for (auto &&op : other.operators)
-    this->insert(std::move(op));
+  this->multiply_by(std::move(other.operators));
   return *this;
 }
 
@@ -1296,12 +1407,12 @@ void product_op<HandlerTy>::dump() const {
 
 template <typename HandlerTy>
 product_op<HandlerTy> &product_op<HandlerTy>::canonicalize() {
-  for (auto it = this->operators.begin(); it != this->operators.end();) {
-    if (*it == HandlerTy(it->degree))
-      it = this->operators.erase(it);
-    else
-      ++it;
-  }
+  this->operators.erase(
+      std::remove_if(this->operators.begin(), this->operators.end(),
+                     [](const HandlerTy &op) {
+                       return op == HandlerTy(op.degree);
+                     }),
+      this->operators.end());
   return *this;
 }
 
@@ -36,7 +36,7 @@ template <typename HandlerTy>
 void sum_op<HandlerTy>::insert(const product_op<HandlerTy> &other) {
   assert(!this->is_default);
   auto [it, inserted] =
-      this->term_map.try_emplace(other.get_term_id(), this->terms.size());
+      this->term_map.try_emplace(other.get_term_key(), this->terms.size());
   if (inserted) {
     this->coefficients.push_back(other.coefficient);
     this->terms.push_back(other.operators);
@@ -50,7 +50,7 @@ template <typename HandlerTy>
 void sum_op<HandlerTy>::insert(product_op<HandlerTy> &&other) {
   assert(!this->is_default);
   auto [it, inserted] =
-      this->term_map.try_emplace(other.get_term_id(), this->terms.size());
+      this->term_map.try_emplace(other.get_term_key(), this->terms.size());
   if (inserted) {
     this->coefficients.push_back(std::move(other.coefficient));
     this->terms.push_back(std::move(other.operators));
@@ -291,7 +291,7 @@ sum_op<HandlerTy>::sum_op(const sum_op<T> &other)
         product_op<T>(1., operators)); // coefficient does not matter
     this->term_map.insert(
         this->term_map.cend(),
-        std::make_pair(term.get_term_id(), this->terms.size()));
+        std::make_pair(term.get_term_key(), this->terms.size()));
     this->terms.push_back(std::move(term.operators));
   }
 }
@@ -312,7 +312,7 @@ sum_op<HandlerTy>::sum_op(const sum_op<T> &other,
                                behavior); // coefficient does not matter
     this->term_map.insert(
         this->term_map.cend(),
-        std::make_pair(term.get_term_id(), this->terms.size()));
+        std::make_pair(term.get_term_key(), this->terms.size()));
     this->terms.push_back(std::move(term.operators));
   }
 }
@@ -435,7 +435,7 @@ sum_op<HandlerTy>::operator=(const product_op<HandlerTy> &other) {
   this->terms.clear();
   this->coefficients.push_back(other.coefficient);
   this->term_map.insert(this->term_map.cend(),
-                        std::make_pair(other.get_term_id(), 0));
+                        std::make_pair(other.get_term_key(), 0));
   this->terms.push_back(other.operators);
   return *this;
 }
@@ -448,7 +448,7 @@ sum_op<HandlerTy> &sum_op<HandlerTy>::operator=(product_op<HandlerTy> &&other) {
   this->terms.clear();
   this->coefficients.push_back(std::move(other.coefficient));
   this->term_map.insert(this->term_map.cend(),
-                        std::make_pair(other.get_term_id(), 0));
+                        std::make_pair(other.get_term_key(), 0));
   this->terms.push_back(std::move(other.operators));
   return *this;
 }
@@ -774,8 +774,7 @@ sum_op<HandlerTy>::operator*(const product_op<HandlerTy> &other) const {
     auto max_size = this->terms[i].size() + other.operators.size();
     product_op<HandlerTy> prod(this->coefficients[i] * other.coefficient,
                                this->terms[i], max_size);
-    for (HandlerTy op : other.operators)
-      prod.insert(std::move(op));
+    prod.multiply_by(other.operators);
     sum.insert(std::move(prod));
   }
   return sum;
@@ -836,8 +835,7 @@ sum_op<HandlerTy>::operator*(const sum_op<HandlerTy> &other) const {
       auto max_size = this->terms[i].size() + other.terms[j].size();
       product_op<HandlerTy> prod(this->coefficients[i] * other.coefficients[j],
                                  this->terms[i], max_size);
-      for (HandlerTy op : other.terms[j])
-        prod.insert(std::move(op));
+      prod.multiply_by(other.terms[j]);
       sum.insert(std::move(prod));
     }
   }
@@ -1006,8 +1004,7 @@ sum_op<HandlerTy>::operator*=(const product_op<HandlerTy> &other) {
     auto max_size = this->terms[i].size() + other.operators.size();
     product_op<HandlerTy> prod(this->coefficients[i] * other.coefficient,
                                this->terms[i], max_size);
-    for (HandlerTy op : other.operators)
-      prod.insert(std::move(op));
+    prod.multiply_by(other.operators);
     sum.insert(std::move(prod));
   }
   *this = std::move(sum);
@@ -1055,8 +1052,7 @@ sum_op<HandlerTy>::operator*=(const sum_op<HandlerTy> &other) {
       auto max_size = this->terms[i].size() + other.terms[j].size();
       product_op<HandlerTy> prod(this->coefficients[i] * other.coefficients[j],
                                  this->terms[i], max_size);
-      for (HandlerTy op : other.terms[j])
-        prod.insert(std::move(op));
+      prod.multiply_by(other.terms[j]);
       sum.insert(std::move(prod));
     }
   }
@@ -2018,7 +2014,7 @@ sum_op<HandlerTy>::sum_op(const std::vector<std::vector<bool>> &bsf_terms,
     product_op<HandlerTy> prod(coeffs[this->terms.size()], std::move(ops));
     this->term_map.insert(
         this->term_map.cend(),
-        std::make_pair(prod.get_term_id(), this->terms.size()));
+        std::make_pair(prod.get_term_key(), this->terms.size()));
     this->terms.push_back(std::move(prod.operators));
     this->coefficients.push_back(std::move(prod.coefficient));
   }
@@ -10,11 +10,12 @@
 
 #include "common/SampleResult.h"
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
-#include <queue>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace cudaq {
 
@@ -24,36 +25,56 @@ namespace cudaq {
 /// instance being provided and set.
 using QuantumTask = std::function<void()>;
 
-/// The QuantumExecutionQueue provides a queue running on a
-/// separate thread from the main CUDA-Q host thread that clients
+/// The QuantumExecutionQueue provides a queue running on one or more
+/// separate threads from the main CUDA-Q host thread that clients
 /// can submit execution tasks to, and these tasks will be executed
 /// (asynchronously from the calling thread) in the order they are submitted.
+/// With a single worker thread (the default), each task completes before the
+/// next one starts. With more worker threads, tasks still start in submission
+/// order, but independent tasks run concurrently. Every worker thread gets its
+/// own (thread-local) simulator and execution manager instances.
 class QuantumExecutionQueue {
 public:
-  /// The Constructor
-  QuantumExecutionQueue();
+  /// The Constructor, starts `numWorkers` (at least one) worker threads.
+  QuantumExecutionQueue(std::size_t numWorkers = 1);
   /// The Destructor
   ~QuantumExecutionQueue();
 
-  /// Enqueue a Sampling task.
+  /// Enqueue a task. With more than one worker thread, the task may run
+  /// concurrently with tasks enqueued before or after it.
   void enqueue(QuantumTask &task);
 
-  /// Get id of the thread this queue executes on.
+  /// Enqueue a task that starts only after all previously enqueued tasks have
+  /// completed, and that completes before any later task starts. Use this for
+  /// tasks that depend on the effects of earlier tasks or that modify state
+  /// shared with other tasks (e.g., the noise model of the QPU).
+  void enqueueOrdered(QuantumTask &task);
+
+  /// Get id of the (first) thread this queue executes on.
   std::thread::id getExecutionThreadId() const;
 
+  /// Get the number of worker threads of this queue.
+  std::size_t getNumWorkers() const { return threads.size(); }
+
 protected:
   /// The mutex, used for locking when adding to the queue
   std::mutex lock;
 
-  /// The thread this queue executes on
-  std::thread thread;
+  /// The threads this queue executes on
+  std::vector<std::thread> threads;
 
-  /// The execution queue
-  std::queue<QuantumTask> queue;
+  /// The execution queue, the flag marks tasks that must run in order
+  std::deque<std::pair<QuantumTask, bool>> queue;
 
   /// The condition variable used for notifying listeners
   std::condition_variable cv;
 
+  /// The number of tasks that are currently executing
+  std::size_t numRunning = 0;
+
+  /// Is an ordered task currently executing?
+  bool orderedRunning = false;
+
   /// Should we quit this thread?
   bool quit = false;
 
@@ -10,8 +10,12 @@
 
 namespace cudaq {
 
-QuantumExecutionQueue::QuantumExecutionQueue() : lock() {
-  thread = std::thread(&QuantumExecutionQueue::handler, this);
+QuantumExecutionQueue::QuantumExecutionQueue(std::size_t numWorkers) : lock() {
+  if (numWorkers == 0)
+    numWorkers = 1;
+  threads.reserve(numWorkers);
+  for (std::size_t i = 0; i < numWorkers; ++i)
+    threads.emplace_back(&QuantumExecutionQueue::handler, this);
 }
 
 QuantumExecutionQueue::~QuantumExecutionQueue() {
@@ -19,40 +23,64 @@ QuantumExecutionQueue::~QuantumExecutionQueue() {
   quit = true;
   cv.notify_all();
   l.unlock();
-  if (thread.joinable()) {
-    thread.join();
-  }
+  for (auto &thread : threads)
+    if (thread.joinable())
+      thread.join();
 }
 
 void QuantumExecutionQueue::enqueue(QuantumTask &t) {
   std::unique_lock<std::mutex> l(lock);
-  queue.push(t);
+  queue.emplace_back(t, false);
+  cv.notify_one();
+  return;
+}
+
+void QuantumExecutionQueue::enqueueOrdered(QuantumTask &t) {
+  std::unique_lock<std::mutex> l(lock);
+  queue.emplace_back(t, true);
   cv.notify_one();
   return;
 }
 
 std::thread::id QuantumExecutionQueue::getExecutionThreadId() const {
-  return thread.get_id();
+  return threads.front().get_id();
 }
 
 void QuantumExecutionQueue::handler(void) {
   std::unique_lock<std::mutex> l(lock);
 
+  // Tasks start in submission order. An ordered task waits until all running
+  // tasks are done, and no other task starts while it is running.
+  auto canStart = [this] {
+    return queue.size() && !orderedRunning &&
+           (!queue.front().second || numRunning == 0);
+  };
+
   do {
-    // Wait until we have data or a quit signal
-    cv.wait(l, [this] { return (queue.size() || quit); });
+    // Wait until we can start a task or get a quit signal
+    cv.wait(l, [&] { return canStart() || quit; });
 
     // after wait, we own the lock
-    if (!quit && queue.size()) {
+    if (!quit && canStart()) {
 
-      auto op = std::move(queue.front());
-      queue.pop();
+      auto [op, ordered] = std::move(queue.front());
+      queue.pop_front();
+      ++numRunning;
+      orderedRunning = ordered;
 
       // unlock now that we're done messing with the queue
       l.unlock();
 
       op();
       l.lock();
+
+      --numRunning;
+      if (ordered)
+        orderedRunning = false;
+      // Tasks waiting for this one to finish, e.g. an ordered task at the
+      // front of the queue, may be able to start now.
+      if (!queue.empty())
+        cv.notify_all();
     }
   } while (!quit);
 }
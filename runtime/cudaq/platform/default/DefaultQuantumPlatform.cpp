@@ -7,6 +7,7 @@
  ******************************************************************************/
 
 #include "common/ExecutionContext.h"
+#include "common/FmtCore.h"
 #include "common/RuntimeTarget.h"
 #include "common/Timing.h"
 #include "cudaq/Support/TargetConfigYaml.h"
@@ -15,8 +16,13 @@
 #include "cudaq/qis/qubit_qis.h"
 #include "cudaq/runtime/logger/logger.h"
 #include "cudaq/utils/cudaq_utils.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <stdexcept>
+#include <thread>
 
 /// This file defines the default, library mode, quantum platform. Its goal is
 /// to create a single QPU that is added to the quantum_platform which delegates
@@ -24,17 +30,53 @@
 
 namespace {
 
+/// Environment variable that sets the number of worker threads that execute
+/// asynchronous tasks on the default QPU. Defaults to 1, i.e., tasks execute
+/// one after the other; 0 selects one worker per hardware thread.
+constexpr const char *asyncThreadsEnvVar = "CUDAQ_ASYNC_THREADS";
+
+std::size_t getNumAsyncThreads() {
+  auto *envVal = std::getenv(asyncThreadsEnvVar);
+  if (!envVal)
+    return 1;
+  const std::string valStr(envVal);
+  const char *nptr = valStr.data();
+  char *endptr = nullptr;
+  errno = 0; // reset errno to 0 before call
+  const auto numThreads = strtol(nptr, &endptr, 10);
+  if (nptr == endptr || errno != 0 || numThreads < 0)
+    throw std::runtime_error(fmt::format("Invalid {} setting. Expected a "
+                                         "non-negative integer. Got: {}",
+                                         asyncThreadsEnvVar, valStr));
+  if (numThreads == 0)
+    return std::max(1u, std::thread::hardware_concurrency());
+  return numThreads;
+}
+
 /// The DefaultQPU models a simulated QPU by specifically
 /// targeting the QIS ExecutionManager.
 class DefaultQPU : public cudaq::QPU {
 public:
-  DefaultQPU() = default;
+  DefaultQPU() {
+    // Every worker thread uses its own simulator instance, since simulators
+    // are created per thread (see `CircuitSimulator::clone`).
+    static const std::size_t numThreads = getNumAsyncThreads();
+    if (numThreads != 1) {
+      CUDAQ_INFO("Executing asynchronous tasks on {} threads.", numThreads);
+      execution_queue =
+          std::make_unique<cudaq::QuantumExecutionQueue>(numThreads);
+    }
+  }
   virtual ~DefaultQPU() = default;
 
   void enqueue(cudaq::QuantumTask &task) override {
     execution_queue->enqueue(task);
   }
 
+  void enqueueOrdered(cudaq::QuantumTask &task) override {
+    execution_queue->enqueueOrdered(task);
+  }
+
   cudaq::KernelThunkResultType
   launchKernel(const std::string &name, cudaq::KernelThunkType kernelFunc,
                void *args, std::uint64_t argsSize, std::uint64_t resultOffset,
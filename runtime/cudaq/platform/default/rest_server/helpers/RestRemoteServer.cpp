@@ -49,10 +49,23 @@
 #include "mlir/Target/LLVMIR/Export.h"
 #include "mlir/Tools/mlir-translate/Translation.h"
 #include "mlir/Transforms/Passes.h"
+#include <condition_variable>
 #include <cxxabi.h>
+#include <fcntl.h>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <signal.h>
+#include <spawn.h>
 #include <streambuf>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 34)
+#define CUDAQ_HAS_SPAWN_ADDCLOSEFROM
+#endif
+#endif
 
 extern "C" {
 void __nvqir__setCircuitSimulator(nvqir::CircuitSimulator *);
@@ -119,11 +132,268 @@ void invokeWrappedKernel(
   }
 }
 
+/// Write a length-prefixed message to \p fd. Returns false if the other end is
+/// closed.
+bool writeMessage(int fd, const std::string &message) {
+  const std::uint64_t size = message.size();
+  auto writeAll = [fd](const char *data, std::size_t count) {
+    while (count > 0) {
+      const auto written = ::write(fd, data, count);
+      if (written < 0 && errno == EINTR)
+        continue;
+      if (written <= 0)
+        return false;
+      data += written;
+      count -= written;
+    }
+    return true;
+  };
+  return writeAll(reinterpret_cast<const char *>(&size), sizeof(size)) &&
+         writeAll(message.data(), message.size());
+}
+
+/// Read a length-prefixed message from \p fd. Returns `std::nullopt` if the
+/// other end is closed.
+std::optional<std::string> readMessage(int fd) {
+  auto readAll = [fd](char *data, std::size_t count) {
+    while (count > 0) {
+      const auto bytesRead = ::read(fd, data, count);
+      if (bytesRead < 0 && errno == EINTR)
+        continue;
+      if (bytesRead <= 0)
+        return false;
+      data += bytesRead;
+      count -= bytesRead;
+    }
+    return true;
+  };
+  std::uint64_t size = 0;
+  if (!readAll(reinterpret_cast<char *>(&size), sizeof(size)))
+    return std::nullopt;
+  std::string message(size, '\0');
+  if (!readAll(message.data(), size))
+    return std::nullopt;
+  return message;
+}
+
+/// Pool of worker processes, each handling one request at a time with its own
+/// runtime (MLIR context, JIT and simulator), so that requests of concurrent
+/// clients run in parallel and in isolation.
+///
+/// The workers are instances of this executable started in worker mode, which
+/// read requests from `requestFd` and write responses to `responseFd`.
+/// Requests wait for an idle worker, up to a maximum number of queued requests
+/// beyond which they are rejected. A worker that exits while handling a
+/// request, e.g., on a crash or a watchdog timeout, only fails that request,
+/// and is restarted for the next one.
+class WorkerPool {
+public:
+  static constexpr int requestFd = 3;
+  static constexpr int responseFd = 4;
+
+  WorkerPool(std::vector<std::string> workerArgv, std::size_t numWorkers,
+             std::size_t maxQueuedRequests)
+      : m_workerArgv(std::move(workerArgv)),
+        m_maxPending(numWorkers + maxQueuedRequests), m_workers(numWorkers) {
+    // Writing to a worker that has exited must fail rather than raise SIGPIPE.
+    ::signal(SIGPIPE, SIG_IGN);
+    for (std::size_t i = 0; i < m_workers.size(); ++i) {
+      spawn(m_workers[i]);
+      m_idle.push_back(i);
+    }
+    CUDAQ_INFO("Started {} worker processes.", m_workers.size());
+  }
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  ~WorkerPool() {
+    // Workers exit when their request pipe is closed.
+    for (auto &worker : m_workers) {
+      closeFd(worker.toWorker);
+      closeFd(worker.fromWorker);
+    }
+    for (auto &worker : m_workers)
+      if (worker.pid > 0)
+        ::waitpid(worker.pid, nullptr, 0);
+  }
+
+  /// Handle \p request on the next idle worker and return its response, or
+  /// `std::nullopt` if the request queue is full.
+  std::optional<std::string> process(const std::string &request) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_pending >= m_maxPending)
+      return std::nullopt;
+    ++m_pending;
+    m_idleCV.wait(lock, [this] { return !m_idle.empty(); });
+    const auto index = m_idle.back();
+    m_idle.pop_back();
+    lock.unlock();
+
+    auto release = llvm::make_scope_exit([&] {
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_idle.push_back(index);
+        --m_pending;
+      }
+      m_idleCV.notify_one();
+    });
+
+    auto &worker = m_workers[index];
+    // A worker may also have exited while idle, e.g., if it was killed.
+    if (worker.pid > 0 &&
+        ::waitpid(worker.pid, nullptr, WNOHANG) == worker.pid) {
+      closeFd(worker.toWorker);
+      closeFd(worker.fromWorker);
+      worker.pid = -1;
+    }
+    if (worker.pid < 0)
+      spawn(worker);
+    std::optional<std::string> response;
+    if (writeMessage(worker.toWorker, request))
+      response = readMessage(worker.fromWorker);
+    if (!response) {
+      terminate(worker);
+      throw std::runtime_error(
+          "The worker process handling the request exited unexpectedly.");
+    }
+    return response;
+  }
+
+  /// Return the number of requests running on a worker and the number of
+  /// requests waiting for one.
+  std::pair<std::size_t, std::size_t> load() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    const auto running = m_workers.size() - m_idle.size();
+    return {running, m_pending - running};
+  }
+
+private:
+  struct Worker {
+    pid_t pid = -1;
+    int toWorker = -1;
+    int fromWorker = -1;
+  };
+
+  static void closeFd(int &fd) {
+    if (fd >= 0)
+      ::close(fd);
+    fd = -1;
+  }
+
+  /// Create a close-on-exec pipe whose ends do not collide with the file
+  /// descriptors that a worker is started with.
+  static void createPipe(int (&fds)[2]) {
+    int raw[2];
+    if (::pipe(raw) != 0)
+      throw std::runtime_error(
+          fmt::format("Failed to create a pipe: {}", std::strerror(errno)));
+    for (int i = 0; i < 2; ++i) {
+      fds[i] = ::fcntl(raw[i], F_DUPFD_CLOEXEC, responseFd + 1);
+      ::close(raw[i]);
+    }
+    if (fds[0] < 0 || fds[1] < 0) {
+      closeFd(fds[0]);
+      closeFd(fds[1]);
+      throw std::runtime_error(
+          fmt::format("Failed to create a pipe: {}", std::strerror(errno)));
+    }
+  }
+
+  /// Keep a worker from inheriting any file descriptor beyond its standard
+  /// streams and pipes. The sockets of the HTTP server are not close-on-exec,
+  /// and a worker restarted while they are open would otherwise hold on to
+  /// them, e.g., keeping the port bound after the server exits.
+  static void closeInheritedFds(posix_spawn_file_actions_t &actions) {
+#ifdef CUDAQ_HAS_SPAWN_ADDCLOSEFROM
+    posix_spawn_file_actions_addclosefrom_np(&actions, responseFd + 1);
+#else
+    // Without `closefrom` spawn actions, mark the descriptors open in this
+    // process close-on-exec, which does not affect this process since it
+    // does not execute any other program.
+    std::error_code ec;
+    for (const auto &entry :
+         std::filesystem::directory_iterator("/dev/fd", ec)) {
+      const int fd = std::atoi(entry.path().filename().c_str());
+      if (fd <= responseFd)
+        continue;
+      const int flags = ::fcntl(fd, F_GETFD);
+      if (flags >= 0 && !(flags & FD_CLOEXEC))
+        ::fcntl(fd, F_SETFD, flags | FD_CLOEXEC);
+    }
+#endif
+  }
+
+  void spawn(Worker &worker) {
+    int toWorker[2], fromWorker[2];
+    createPipe(toWorker);
+    try {
+      createPipe(fromWorker);
+    } catch (...) {
+      closeFd(toWorker[0]);
+      closeFd(toWorker[1]);
+      throw;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, toWorker[0], requestFd);
+    posix_spawn_file_actions_adddup2(&actions, fromWorker[1], responseFd);
+    closeInheritedFds(actions);
+    std::vector<char *> argv;
+    for (auto &arg : m_workerArgv)
+      argv.push_back(arg.data());
+    argv.push_back(nullptr);
+    pid_t pid = -1;
+    const int error = ::posix_spawn(&pid, argv[0], &actions, nullptr,
+                                    argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    closeFd(toWorker[0]);
+    closeFd(fromWorker[1]);
+    if (error != 0) {
+      closeFd(toWorker[1]);
+      closeFd(fromWorker[0]);
+      throw std::runtime_error(fmt::format(
+          "Failed to start a worker process: {}", std::strerror(error)));
+    }
+    worker = Worker{pid, toWorker[1], fromWorker[0]};
+  }
+
+  static void terminate(Worker &worker) {
+    closeFd(worker.toWorker);
+    closeFd(worker.fromWorker);
+    if (worker.pid > 0) {
+      ::kill(worker.pid, SIGKILL);
+      ::waitpid(worker.pid, nullptr, 0);
+    }
+    worker.pid = -1;
+  }
+
+  std::vector<std::string> m_workerArgv;
+  std::size_t m_maxPending;
+  // Each worker is only accessed by the thread that took it from `m_idle`.
+  std::vector<Worker> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_idleCV;
+  std::vector<std::size_t> m_idle;
+  std::size_t m_pending = 0;
+};
+
 class RemoteRestRuntimeServer : public cudaq::RemoteRuntimeServer {
   int m_port = -1;
   std::unique_ptr<cudaq::RestServer> m_server;
   std::unique_ptr<MLIRContext> m_mlirContext;
   bool m_hasMpi = false;
+  // Server subtype, used to start worker processes of the same type.
+  std::string m_serverType = "rest";
+  // Number of worker processes handling requests concurrently. With a single
+  // worker, requests are handled in this process.
+  std::size_t m_numWorkers = 1;
+  // Number of requests that can wait for a worker before being rejected.
+  std::size_t m_maxQueuedRequests = 64;
+  // Whether this process is a worker, serving the requests of its parent.
+  bool m_isWorker = false;
+  std::unique_ptr<WorkerPool> m_workerPool;
   struct CodeTransformInfo {
     cudaq::CodeFormat format;
     std::vector<std::string> passes;
@@ -171,6 +441,22 @@ public:
 
   virtual void
   init(const std::unordered_map<std::string, std::string> &configs) override {
+    const auto typeIter = configs.find("type");
+    if (typeIter != configs.end())
+      m_serverType = typeIter->second;
+    const auto workersIter = configs.find("workers");
+    if (workersIter != configs.end())
+      m_numWorkers = std::max<std::size_t>(1, stoul(workersIter->second));
+    const auto maxQueuedIter = configs.find("max-queued-requests");
+    if (maxQueuedIter != configs.end())
+      m_maxQueuedRequests = stoul(maxQueuedIter->second);
+    m_isWorker = configs.count("worker") > 0;
+    if (m_isWorker) {
+      // Workers get their requests from the parent process, not over HTTP.
+      m_mlirContext = getOwningMLIRContext();
+      return;
+    }
+
     const auto portIter = configs.find("port");
     if (portIter != configs.end())
       m_port = stoi(portIter->second);
@@ -179,7 +465,17 @@ public:
     if (!portValid)
       throw std::runtime_error(
           "Invalid TCP/IP port requested. Valid range: [1024, 65535].");
-    m_server = std::make_unique<cudaq::RestServer>(m_port);
+    m_hasMpi = cudaq::mpi::is_initialized();
+    // Each worker process has its own runtime, hence servers running on
+    // multiple MPI ranks and one-shot servers handle their requests in this
+    // process.
+    if ((m_hasMpi && cudaq::mpi::num_ranks() > 1) || exitAfterJob)
+      m_numWorkers = 1;
+    // Requests waiting for a worker each occupy a server thread; keep one more
+    // thread to reject the requests that overflow the queue.
+    m_server = std::make_unique<cudaq::RestServer>(
+        m_port, "cudaq",
+        m_numWorkers > 1 ? m_numWorkers + m_maxQueuedRequests + 1 : 1);
     m_server->addRoute(
         cudaq::RestServer::Method::GET, "/",
         [](const std::string &reqBody,
@@ -189,11 +485,51 @@ public:
           return json();
         });
 
+    // Load of the worker pool, e.g., for clients to wait for a free worker.
+    m_server->addRoute(
+        cudaq::RestServer::Method::GET, "/workers",
+        [&](const std::string &reqBody,
+            const std::unordered_multimap<std::string, std::string> &headers) {
+          json resultJson;
+          resultJson["workers"] = m_numWorkers;
+          resultJson["running"] = 0;
+          resultJson["queued"] = 0;
+          if (m_workerPool) {
+            const auto [running, queued] = m_workerPool->load();
+            resultJson["running"] = running;
+            resultJson["queued"] = queued;
+          }
+          return resultJson;
+        });
+
     // New simulation request.
     m_server->addRoute(
         cudaq::RestServer::Method::POST, "/job",
         [&](const std::string &reqBody,
             const std::unordered_multimap<std::string, std::string> &headers) {
+          if (m_workerPool) {
+            for (const auto &[k, v] : headers)
+              CUDAQ_INFO("Request Header: {} : {}", k, v);
+            try {
+              const auto response = m_workerPool->process(reqBody);
+              if (!response) {
+                json resultJson;
+                resultJson["status"] = "Server busy";
+                resultJson["errorMessage"] = fmt::format(
+                    "Too many pending requests (limit: {} running and {} "
+                    "queued). Please retry later.",
+                    m_numWorkers, m_maxQueuedRequests);
+                return resultJson;
+              }
+              return json::parse(*response);
+            } catch (std::exception &e) {
+              json resultJson;
+              resultJson["status"] = "Failed to process incoming request";
+              resultJson["errorMessage"] = e.what();
+              return resultJson;
+            }
+          }
+
           requestStart = std::chrono::high_resolution_clock::now();
           auto shutdownAfterHandlingRequest = llvm::make_scope_exit([&] {
             if (this->exitAfterJob)
@@ -211,12 +547,23 @@ public:
 
           return resultJs;
         });
-    m_mlirContext = getOwningMLIRContext();
-    m_hasMpi = cudaq::mpi::is_initialized();
+    // Requests are forwarded to the workers, which have their own context.
+    if (m_numWorkers == 1)
+      m_mlirContext = getOwningMLIRContext();
   }
 
   // Start the server.
   virtual void start() override {
+    if (m_isWorker) {
+      // Handle the requests of the parent process until it closes the pipe.
+      while (auto request = readMessage(WorkerPool::requestFd)) {
+        requestStart = std::chrono::high_resolution_clock::now();
+        const auto resultJs = processRequest(*request);
+        if (!writeMessage(WorkerPool::responseFd, resultJs.dump()))
+          break;
+      }
+      return;
+    }
     if (!m_server)
       throw std::runtime_error(
           "Fatal error: attempt to start the server before initialization. "
@@ -224,7 +571,13 @@ public:
     if (!m_hasMpi || cudaq::mpi::rank() == 0) {
       // Only run this app on Rank 0;
       // the rest will wait for a broadcast.
+      if (m_numWorkers > 1)
+        m_workerPool = std::make_unique<WorkerPool>(
+            std::vector<std::string>{"/proc/self/exe",
+                                     "--type=" + m_serverType, "--worker"},
+            m_numWorkers, m_maxQueuedRequests);
       m_server->start();
+      m_workerPool.reset();
     } else if (m_hasMpi) {
       for (;;) {
         std::string jsonRequestBody;
@@ -239,7 +592,10 @@ public:
   }
 
   // Stop the server.
-  virtual void stop() override { m_server->stop(); }
+  virtual void stop() override {
+    if (m_server)
+      m_server->stop();
+  }
 
   virtual void handleVQERequest(std::size_t reqId,
                                 cudaq::ExecutionContext &io_context,
@@ -623,8 +979,8 @@ protected:
     });
 
     try {
-      // IMPORTANT: This assumes the REST server handles incoming requests
-      // sequentially.
+      // IMPORTANT: This assumes that each process handles its requests
+      // sequentially (see `WorkerPool` for concurrent requests).
       static std::size_t g_requestCounter = 0;
       auto requestJson = json::parse(reqBody);
       cudaq::RestRequest request(requestJson);
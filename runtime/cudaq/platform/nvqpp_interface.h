@@ -72,4 +72,10 @@ streamlinedLaunchModule(const std::string &kernelName, mlir::ModuleOp moduleOp,
     const std::string &kernelName, mlir::ModuleOp moduleOp,
     const std::vector<void *> &rawArgs, bool isEntryPoint);
 
+// Launch a kernel compiled by `streamlinedSpecializeModule`. No MLIR is
+// involved, so repeated launches of the same compiled kernel are cheap.
+[[nodiscard]] KernelThunkResultType
+streamlinedLaunchCompiledModule(const CompiledModule &compiled,
+                                const std::vector<void *> &rawArgs);
+
 } // namespace cudaq
@@ -7,8 +7,10 @@
  ******************************************************************************/
 
 #include "qpu.h"
+#include "common/Environment.h"
 #include "mlir/IR/BuiltinOps.h"
 #include <cstring>
+#include <map>
 
 using namespace cudaq_internal::compiler;
 
@@ -19,8 +21,8 @@ CUDAQ_INSTANTIATE_REGISTRY(cudaq::ModuleLauncher::RegistryType)
 /// Handles argument marshaling via `argsCreator` (if not fully specialized) and
 /// result buffer allocation.
 cudaq::KernelThunkResultType
-launchCompiledModule(const cudaq::CompiledModule &compiled,
-                     const std::vector<void *> &rawArgs) {
+cudaq::QPU::launchCompiledModule(const CompiledModule &compiled,
+                                 const std::vector<void *> &rawArgs) {
   auto funcPtr = compiled.getJit()->getFn();
   const auto &resultInfo = compiled.getResultInfo();
   if (!compiled.isFullySpecialized()) {
@@ -28,7 +30,7 @@ launchCompiledModule(const cudaq::CompiledModule &compiled,
     auto argsCreator = compiled.getArgsCreator();
     void *buff = nullptr;
     argsCreator(static_cast<const void *>(rawArgs.data()), &buff);
-    reinterpret_cast<cudaq::KernelThunkResultType (*)(void *, bool)>(funcPtr)(
+    reinterpret_cast<KernelThunkResultType (*)(void *, bool)>(funcPtr)(
         buff, /*client_server=*/false);
     // If the kernel has a result, copy it from the packed buffer into
     // rawArgs.back() (where the caller expects to find it).
@@ -44,8 +46,8 @@ launchCompiledModule(const cudaq::CompiledModule &compiled,
     // Fully specialized with result: rawArgs.back() is the pre-allocated
     // result buffer; pass it directly to the thunk.
     void *buff = const_cast<void *>(rawArgs.back());
-    return reinterpret_cast<cudaq::KernelThunkResultType (*)(void *, bool)>(
-        funcPtr)(buff, /*client_server=*/false);
+    return reinterpret_cast<KernelThunkResultType (*)(void *, bool)>(funcPtr)(
+        buff, /*client_server=*/false);
   }
   // Fully specialized, no result.
   funcPtr();
@@ -77,3 +79,79 @@ cudaq::QPU::specializeModule(const std::string &name, mlir::ModuleOp module,
   ScopedTraceWithContext(cudaq::TIMING_LAUNCH, "QPU::specializeModule", name);
   return launcher->compileModule(name, module, rawArgs, isEntryPoint);
 }
+
+bool cudaq::QPU::shouldGroupObserveTerms(const ExecutionContext &context) {
+  if (context.shots == 0 || context.shots == static_cast<std::size_t>(-1))
+    return false;
+  return cudaq::getEnvBool(observeGroupingEnvVar, false);
+}
+
+void cudaq::QPU::handleGroupedObservation(ExecutionContext &context) const {
+  const cudaq::spin_op &H = context.spin.value();
+
+  // Greedy first-fit partitioning: a term joins the first group in which, on
+  // every qubit, it either acts with the same Pauli as the group or one of the
+  // two acts trivially. Heavier terms are placed first as they are the most
+  // constrained.
+  struct Group {
+    std::map<std::size_t, cudaq::pauli> basis;
+    cudaq::spin_op terms = cudaq::spin_op::empty();
+  };
+  std::vector<Group> groups;
+  double sum = 0.0;
+
+  std::vector<cudaq::spin_op_term> terms;
+  terms.reserve(H.num_terms());
+  for (const auto &term : H) {
+    if (term.is_identity())
+      sum += term.evaluate_coefficient().real();
+    else
+      terms.push_back(term);
+  }
+  std::stable_sort(terms.begin(), terms.end(), [](auto &a, auto &b) {
+    return a.num_ops() > b.num_ops();
+  });
+
+  for (const auto &term : terms) {
+    auto fits = [&term](const Group &group) {
+      for (const auto &op : term) {
+        auto iter = group.basis.find(op.target());
+        if (iter != group.basis.end() && iter->second != op.as_pauli())
+          return false;
+      }
+      return true;
+    };
+    auto iter = std::find_if(groups.begin(), groups.end(), fits);
+    if (iter == groups.end())
+      iter = groups.emplace(groups.end());
+    for (const auto &op : term)
+      if (op.as_pauli() != cudaq::pauli::I)
+        iter->basis.emplace(op.target(), op.as_pauli());
+    iter->terms += term;
+  }
+
+  CUDAQ_INFO("Measuring {} spin_op terms in {} qubit-wise commuting groups.",
+             terms.size(), groups.size());
+
+  std::vector<cudaq::ExecutionResult> results;
+  results.reserve(terms.size());
+  for (const auto &group : groups) {
+    // The backend measures all terms of the group from the same shots and
+    // reports one result per term, keyed by the term id. A group of a single
+    // term is measured as a plain term, whose result is in the global
+    // register.
+    auto [exp, data] = cudaq::measure(group.terms);
+    const bool singleTerm = group.terms.num_terms() == 1;
+    for (const auto &term : group.terms) {
+      const auto termId = term.get_term_id();
+      const auto &registerName =
+          singleTerm ? cudaq::GlobalRegisterName : termId;
+      const double termExp = data.expectation(registerName);
+      results.emplace_back(data.to_map(registerName), termId, termExp);
+      sum += term.evaluate_coefficient().real() * termExp;
+    }
+  }
+
+  context.expectationValue = sum;
+  context.result = cudaq::sample_result(sum, results);
+}
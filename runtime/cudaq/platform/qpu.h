@@ -83,6 +83,8 @@ protected:
         auto [exp, data] = cudaq::measure(H);
         context.expectationValue = exp;
         context.result = data;
+      } else if (shouldGroupObserveTerms(context)) {
+        handleGroupedObservation(context);
       } else {
 
         // Loop over each term and compute coeff * <term>
@@ -104,6 +106,22 @@ protected:
     }
   }
 
+  /// @brief Environment variable that opts into measuring the terms of the
+  /// observed `spin_op` in qubit-wise commuting groups, i.e., with one basis
+  /// change and one sampling pass per group rather than per term.
+  static constexpr const char observeGroupingEnvVar[] =
+      "CUDAQ_OBSERVE_GROUP_TERMS";
+
+  /// @brief Return true if the terms of the observed `spin_op` should be
+  /// measured in qubit-wise commuting groups. This only applies to shot-based
+  /// observation; exact expectation values are computed per term.
+  static bool shouldGroupObserveTerms(const ExecutionContext &context);
+
+  /// @brief Partition the terms of the observed `spin_op` into qubit-wise
+  /// commuting groups and compute the expectation value of every term from
+  /// the bit strings sampled for its group.
+  void handleGroupedObservation(ExecutionContext &context) const;
+
 public:
   /// The constructor, initializes the execution queue
   QPU() : execution_queue(std::make_unique<QuantumExecutionQueue>()) {}
@@ -159,6 +177,11 @@ public:
   virtual void
   enqueue(QuantumTask &task) = 0; //{ execution_queue->enqueue(task); }
 
+  /// Enqueue a quantum task that must not run concurrently with, or out of
+  /// order with respect to, other tasks on this QPU. This only differs from
+  /// `enqueue` for QPUs whose execution queue has multiple worker threads.
+  virtual void enqueueOrdered(QuantumTask &task) { enqueue(task); }
+
   /// @brief Configure the execution context for this QPU.
   virtual void configureExecutionContext(ExecutionContext &context) const {}
 
@@ -201,6 +224,12 @@ public:
   specializeModule(const std::string &name, mlir::ModuleOp module,
                    const std::vector<void *> &rawArgs, bool isEntryPoint);
 
+  /// Execute a kernel previously compiled by `specializeModule` with the given
+  /// arguments. The compiled module may be launched any number of times.
+  [[nodiscard]] virtual KernelThunkResultType
+  launchCompiledModule(const CompiledModule &compiled,
+                       const std::vector<void *> &rawArgs);
+
   /// @brief Notify the QPU that a new random seed value is set.
   /// By default do nothing, let subclasses override.
   virtual void onRandomSeedSet(std::size_t seed) {}
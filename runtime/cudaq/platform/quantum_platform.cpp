@@ -86,22 +86,35 @@ void quantum_platform::reset_noise(std::size_t qpu_id) {
 
 std::future<sample_result>
 quantum_platform::enqueueAsyncTask(const std::size_t qpu_id,
-                                   KernelExecutionTask &task) {
+                                   KernelExecutionTask &task, bool ordered) {
   std::promise<sample_result> promise;
   auto f = promise.get_future();
   QuantumTask wrapped = detail::make_copyable_function(
       [p = std::move(promise), t = task]() mutable {
-        auto counts = t();
-        p.set_value(counts);
+        // Report a failed execution, e.g., a request rejected by a remote
+        // server, through the future rather than on the QPU thread.
+        try {
+          auto counts = t();
+          p.set_value(counts);
+        } catch (...) {
+          p.set_exception(std::current_exception());
+        }
       });
 
-  platformQPUs[qpu_id]->enqueue(wrapped);
+  if (ordered)
+    platformQPUs[qpu_id]->enqueueOrdered(wrapped);
+  else
+    platformQPUs[qpu_id]->enqueue(wrapped);
   return f;
 }
 
 void quantum_platform::enqueueAsyncTask(const std::size_t qpu_id,
-                                        std::function<void()> &f) {
-  platformQPUs[qpu_id]->enqueue(f);
+                                        std::function<void()> &f,
+                                        bool ordered) {
+  if (ordered)
+    platformQPUs[qpu_id]->enqueueOrdered(f);
+  else
+    platformQPUs[qpu_id]->enqueue(f);
 }
 
 void quantum_platform::validateQpuId(std::size_t qpuId) const {
@@ -239,6 +252,15 @@ CompiledModule quantum_platform::specializeModule(
   return qpu->specializeModule(kernelName, module, rawArgs, isEntryPoint);
 }
 
+KernelThunkResultType
+quantum_platform::launchCompiledModule(const CompiledModule &compiled,
+                                       const std::vector<void *> &rawArgs,
+                                       std::size_t qpu_id) {
+  validateQpuId(qpu_id);
+  auto &qpu = platformQPUs[qpu_id];
+  return qpu->launchCompiledModule(compiled, rawArgs);
+}
+
 void quantum_platform::onRandomSeedSet(std::size_t seed) {
   // Send on the notification to all QPUs.
   for (auto &qpu : platformQPUs)
@@ -344,6 +366,17 @@ cudaq::CompiledModule cudaq::streamlinedSpecializeModule(
                                    isEntryPoint);
 }
 
+cudaq::KernelThunkResultType
+cudaq::streamlinedLaunchCompiledModule(const CompiledModule &compiled,
+                                       const std::vector<void *> &rawArgs) {
+  ScopedTraceWithContext("streamlinedLaunchCompiledModule", compiled.getName(),
+                         rawArgs.size());
+
+  auto &platform = *getQuantumPlatformInternal();
+  std::size_t qpu_id = getCurrentQpuId();
+  return platform.launchCompiledModule(compiled, rawArgs, qpu_id);
+}
+
 cudaq::KernelThunkResultType
 cudaq::hybridLaunchKernel(const char *kernelName, cudaq::KernelThunkType kernel,
                           void *args, std::uint64_t argsSize,
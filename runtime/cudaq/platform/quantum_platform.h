@@ -181,12 +181,16 @@ public:
   /// @brief End the current execution on this platform.
   void endExecution();
 
-  /// Enqueue an asynchronous sampling task.
+  /// Enqueue an asynchronous sampling task. If `ordered` is true, the task
+  /// does not run concurrently with other tasks on the QPU, e.g., because it
+  /// sets the noise model of the QPU.
   std::future<sample_result> enqueueAsyncTask(const std::size_t qpu_id,
-                                              KernelExecutionTask &t);
+                                              KernelExecutionTask &t,
+                                              bool ordered = false);
 
   /// @brief Enqueue a general task that runs on the specified QPU
-  void enqueueAsyncTask(const std::size_t qpu_id, std::function<void()> &f);
+  void enqueueAsyncTask(const std::size_t qpu_id, std::function<void()> &f,
+                        bool ordered = false);
 
   /// @brief Launch a VQE operation on the platform.
   void launchVQE(const std::string kernelName, const void *kernelArgs,
@@ -212,6 +216,12 @@ public:
                    const std::vector<void *> &rawArgs, std::size_t qpu_id,
                    bool isEntryPoint);
 
+  // This method launches a kernel that has already been compiled by
+  // `specializeModule`.
+  [[nodiscard]] KernelThunkResultType
+  launchCompiledModule(const CompiledModule &compiled,
+                       const std::vector<void *> &rawArgs, std::size_t qpu_id);
+
   /// List all available platforms
   static std::vector<std::string> list_platforms();
 
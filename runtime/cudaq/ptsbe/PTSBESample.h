@@ -317,7 +317,7 @@ runSamplingAsyncPTSBE(KernelFunctor &&wrappedKernel, quantum_platform &platform,
         }
       });
 
-  platform.enqueueAsyncTask(qpu_id, task);
+  platform.enqueueAsyncTask(qpu_id, task, /*ordered=*/hasNoise);
   return future;
 }
 
@@ -8,11 +8,22 @@
 
 #include "PTSBESamplerImpl.h"
 #include "common/Environment.h"
+#include "common/FmtCore.h"
+#include "cudaq/algorithms/broadcast.h"
+#include "cudaq/platform/QuantumExecutionQueue.h"
 #include "cudaq/runtime/logger/logger.h"
 #include "cudaq/simulators.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <exception>
+#include <future>
+#include <memory>
 #include <numeric>
+#include <optional>
 #include <span>
 #include <stdexcept>
+#include <thread>
 
 namespace cudaq::ptsbe {
 
@@ -166,13 +177,282 @@ aggregateResults(const std::vector<cudaq::sample_result> &results) {
   return cudaq::sample_result{std::move(er)};
 }
 
+namespace {
+/// Finalize and tear down the execution context and deallocate qubits.
+/// finalizeExecutionContext must precede deallocateQubits because
+/// CircuitSimulatorBase::deallocateQubits is a no-op while a context is set.
+void teardown(nvqir::CircuitSimulator *sim, cudaq::ExecutionContext &ctx,
+              std::size_t nQubits) {
+  sim->finalizeExecutionContext(ctx);
+  cudaq::detail::resetExecutionContext();
+  std::vector<std::size_t> qubitIds(nQubits);
+  std::iota(qubitIds.begin(), qubitIds.end(), 0);
+  sim->deallocateQubits(qubitIds);
+}
+
+/// Worker threads running blocks of trajectories. The threads persist across
+/// calls, so that each keeps its cloned simulator instead of creating one per
+/// call. Blocks beyond the number of hardware threads wait for a free worker.
+/// The queue is never destroyed, so that no worker (and simulator) is torn
+/// down during static destruction.
+cudaq::QuantumExecutionQueue &getWorkerQueue() {
+  static auto *queue = new cudaq::QuantumExecutionQueue(
+      std::max(1u, std::thread::hardware_concurrency()));
+  return *queue;
+}
+
+constexpr const char *numThreadsEnvVar = "CUDAQ_PTSBE_NUM_THREADS";
+constexpr const char *maxCheckpointsEnvVar = "CUDAQ_PTSBE_MAX_CHECKPOINTS";
+constexpr std::size_t defaultMaxCheckpoints = 4;
+
+/// Read a non-negative integer setting from the environment.
+std::size_t getSizeFromEnv(const char *envVar, std::size_t defaultValue) {
+  auto *value = std::getenv(envVar);
+  if (!value)
+    return defaultValue;
+  const std::string valueStr(value);
+  const char *nptr = valueStr.data();
+  char *endptr = nullptr;
+  errno = 0; // reset errno to 0 before call
+  const auto result = strtol(nptr, &endptr, 10);
+  if (nptr == endptr || errno != 0 || result < 0)
+    throw std::runtime_error(
+        fmt::format("Invalid {} setting. Expected a non-negative integer. "
+                    "Got: {}",
+                    envVar, valueStr));
+  return result;
+}
+
+/// The error (non-identity) selections of a trajectory, in circuit order.
+/// Identity selections leave the state unchanged, so two trajectories evolve
+/// identically until their first differing error selection.
+using ErrorList = std::vector<const cudaq::KrausSelection *>;
+
+ErrorList getErrors(const cudaq::KrausTrajectory &trajectory) {
+  ErrorList errors;
+  for (const auto &sel : trajectory.kraus_selections)
+    if (sel.is_error)
+      errors.push_back(&sel);
+  return errors;
+}
+
+bool sameError(const cudaq::KrausSelection *a, const cudaq::KrausSelection *b) {
+  return a->circuit_location == b->circuit_location &&
+         a->kraus_operator_index == b->kraus_operator_index;
+}
+
+/// Order trajectories so that those sharing the longest error prefix are
+/// adjacent: lexicographically on (location, Kraus index) of their errors,
+/// where running out of errors sorts last.
+bool errorOrder(const ErrorList &a, const ErrorList &b) {
+  for (std::size_t i = 0; i < std::min(a.size(), b.size()); ++i) {
+    if (a[i]->circuit_location != b[i]->circuit_location)
+      return a[i]->circuit_location < b[i]->circuit_location;
+    if (a[i]->kraus_operator_index != b[i]->kraus_operator_index)
+      return a[i]->kraus_operator_index < b[i]->kraus_operator_index;
+  }
+  return a.size() > b.size();
+}
+
+/// Return the trace position up to which (exclusive) trajectories with the
+/// given errors go through the same states.
+std::size_t branchPosition(const ErrorList &a, const ErrorList &b,
+                           std::size_t traceSize) {
+  std::size_t i = 0;
+  while (i < a.size() && i < b.size() && sameError(a[i], b[i]))
+    ++i;
+  std::size_t position = traceSize;
+  if (i < a.size())
+    position = std::min(position, a[i]->circuit_location);
+  if (i < b.size())
+    position = std::min(position, b[i]->circuit_location);
+  return position;
+}
+
+/// The trajectories to simulate, in execution order, and the data shared by
+/// the threads simulating them.
+template <typename ScalarType>
+struct TrajectoryPlan {
+  const PTSBatch &batch;
+  /// Simulator task of each Gate instruction of the trace, converted once.
+  std::vector<std::optional<GateTask<ScalarType>>> gateTasks;
+  /// Error selections of each trajectory of the batch.
+  std::vector<ErrorList> errors;
+  /// Indices (into the batch) of the trajectories with shots, sorted so that
+  /// trajectories with a common prefix are adjacent.
+  std::vector<std::size_t> order;
+  /// `branch[k]` is the branch position of `order[k - 1]` and `order[k]`.
+  std::vector<std::size_t> branch;
+  std::size_t maxCheckpoints = 0;
+
+  TrajectoryPlan(const PTSBatch &batch, std::size_t maxCheckpoints)
+      : batch(batch), maxCheckpoints(maxCheckpoints) {
+    gateTasks.resize(batch.trace.size());
+    for (std::size_t i = 0; i < batch.trace.size(); ++i)
+      if (batch.trace[i].type == TraceInstructionType::Gate)
+        gateTasks[i].emplace(convertToSimulatorTask<ScalarType>(batch.trace[i]));
+
+    errors.reserve(batch.trajectories.size());
+    for (std::size_t t = 0; t < batch.trajectories.size(); ++t) {
+      const auto &traj = batch.trajectories[t];
+      for (const auto &sel : traj.kraus_selections)
+        if (sel.circuit_location >= batch.trace.size())
+          throw std::runtime_error(
+              "Invalid circuit_location: " +
+              std::to_string(sel.circuit_location) +
+              " >= " + std::to_string(batch.trace.size()));
+      errors.push_back(getErrors(traj));
+      if (traj.num_shots > 0)
+        order.push_back(t);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::size_t a, std::size_t b) {
+                       return errorOrder(errors[a], errors[b]);
+                     });
+    branch.resize(order.size(), 0);
+    for (std::size_t k = 1; k < order.size(); ++k)
+      branch[k] = branchPosition(errors[order[k - 1]], errors[order[k]],
+                                 batch.trace.size());
+  }
+};
+
+/// Simulate and sample the trajectories `plan.order[begin, end)` in order.
+///
+/// Each trajectory starts from the deepest saved state it shares with the
+/// previous one, rather than from |0>. While simulating a trajectory, the
+/// states at the positions where the following trajectories branch off are
+/// saved, up to `plan.maxCheckpoints` of them, if the simulator supports
+/// state checkpoints.
+template <typename ScalarType>
+void runTrajectories(nvqir::CircuitSimulatorBase<ScalarType> &simulator,
+                     const TrajectoryPlan<ScalarType> &plan, std::size_t begin,
+                     std::size_t end,
+                     std::vector<cudaq::sample_result> &results) {
+  const auto &batch = plan.batch;
+  const std::size_t traceSize = batch.trace.size();
+  using StateBuffer = std::vector<std::complex<ScalarType>>;
+  struct Checkpoint {
+    std::size_t position;
+    StateBuffer state;
+  };
+  // Saved states along the current path, by increasing position, and
+  // buffers of discarded checkpoints for reuse.
+  std::vector<Checkpoint> checkpoints;
+  std::vector<StateBuffer> spareBuffers;
+  bool canCheckpoint = plan.maxCheckpoints > 0;
+  std::size_t reusedInstructions = 0;
+
+  const std::size_t numTrajectories = end - begin;
+  // Log progress at ~10% intervals (at least every 100 trajectories)
+  const std::size_t progressInterval = std::max<std::size_t>(
+      1, std::min<std::size_t>(numTrajectories / 10, 100));
+
+  std::vector<std::size_t> savePositions;
+  for (std::size_t k = begin; k < end; ++k) {
+    const auto ti = plan.order[k];
+    const auto &traj = batch.trajectories[ti];
+    const auto &errors = plan.errors[ti];
+
+    // Restart from the deepest checkpoint shared with the previous
+    // trajectory.
+    const std::size_t shared = k == begin ? 0 : plan.branch[k];
+    while (!checkpoints.empty() && checkpoints.back().position > shared) {
+      spareBuffers.push_back(std::move(checkpoints.back().state));
+      checkpoints.pop_back();
+    }
+    std::size_t start = 0;
+    if (checkpoints.empty()) {
+      simulator.setToZeroState();
+    } else {
+      simulator.restoreState(checkpoints.back().state);
+      start = checkpoints.back().position;
+      reusedInstructions += start;
+    }
+
+    // Positions where the following trajectories branch off this one, beyond
+    // the restored position, in increasing order.
+    savePositions.clear();
+    if (canCheckpoint) {
+      std::size_t position = traceSize;
+      for (std::size_t next = k + 1;
+           next < end && checkpoints.size() + savePositions.size() <
+                             plan.maxCheckpoints;
+           ++next) {
+        position = std::min(position, plan.branch[next]);
+        if (position <= start)
+          break;
+        if (position < traceSize &&
+            (savePositions.empty() || position < savePositions.back()))
+          savePositions.push_back(position);
+      }
+      std::reverse(savePositions.begin(), savePositions.end());
+    }
+
+    auto error = std::lower_bound(
+        errors.begin(), errors.end(), start,
+        [](const cudaq::KrausSelection *sel, std::size_t position) {
+          return sel->circuit_location < position;
+        });
+    auto save = savePositions.begin();
+    for (std::size_t i = start; i < traceSize; ++i) {
+      if (save != savePositions.end() && *save == i) {
+        StateBuffer buffer;
+        if (!spareBuffers.empty()) {
+          buffer = std::move(spareBuffers.back());
+          spareBuffers.pop_back();
+        }
+        if (simulator.checkpointState(buffer)) {
+          checkpoints.push_back({i, std::move(buffer)});
+        } else {
+          canCheckpoint = false;
+          save = savePositions.end();
+        }
+        if (save != savePositions.end())
+          ++save;
+      }
+      if (plan.gateTasks[i])
+        simulator.applyGate(*plan.gateTasks[i]);
+      while (error != errors.end() && (*error)->circuit_location == i) {
+        simulator.applyGate(
+            krausSelectionToTask<ScalarType>(**error, batch.trace[i]));
+        ++error;
+      }
+    }
+    simulator.flushGateQueue();
+
+    auto execResult =
+        simulator.sample(batch.measureQubits, static_cast<int>(traj.num_shots),
+                         batch.includeSequentialData);
+
+    // Keep the counts (and shot records), in whichever form the simulator
+    // produced them, but not its precomputed expectation value.
+    execResult.expectationValue.reset();
+    if (!batch.includeSequentialData) {
+      execResult.sequentialData.clear();
+      execResult.packedSequentialData.clear();
+    }
+    results[ti] = cudaq::sample_result{std::move(execResult)};
+
+    if ((k - begin + 1) % progressInterval == 0)
+      cudaq::info("[ptsbe] Trajectory progress: {}/{} ({} shots)",
+                  k - begin + 1, numTrajectories, traj.num_shots);
+  }
+
+  if (reusedInstructions > 0)
+    cudaq::info("[ptsbe] Reused {} trace instructions from saved states over "
+                "{} trajectories",
+                reusedInstructions, numTrajectories);
+}
+} // namespace
+
 template <typename ScalarType>
 std::vector<cudaq::sample_result>
 samplePTSBEGeneric(nvqir::CircuitSimulatorBase<ScalarType> &simulator,
                    const PTSBatch &batch) {
   ScopedTraceWithContext("ptsbe::samplePTSBEGeneric",
                          batch.trajectories.size());
-  if (!cudaq::getExecutionContext())
+  auto *executionContext = cudaq::getExecutionContext();
+  if (!executionContext)
     throw std::runtime_error(
         "samplePTSBEGeneric requires ExecutionContext to be set. "
         "Use cudaq::detail::setExecutionContext() before invoking.");
@@ -187,44 +467,97 @@ samplePTSBEGeneric(nvqir::CircuitSimulatorBase<ScalarType> &simulator,
   if (batch.measureQubits.empty())
     return {};
 
-  std::vector<cudaq::sample_result> results;
-  results.reserve(batch.trajectories.size());
-
-  const std::size_t numTrajectories = batch.trajectories.size();
-  // Log progress at ~10% intervals (at least every 100 trajectories)
-  const std::size_t progressInterval = std::max<std::size_t>(
-      1, std::min<std::size_t>(numTrajectories / 10, 100));
+  const TrajectoryPlan<ScalarType> plan(
+      batch, getSizeFromEnv(maxCheckpointsEnvVar, defaultMaxCheckpoints));
+
+  // Trajectories without shots keep an empty result.
+  std::vector<cudaq::sample_result> results(
+      batch.trajectories.size(),
+      cudaq::sample_result{cudaq::ExecutionResult{cudaq::CountsDictionary{}}});
+
+  // Only simulators that keep their state in host memory (and so support
+  // checkpoints) are cloned onto worker threads.
+  std::size_t numThreads = getSizeFromEnv(numThreadsEnvVar, 1);
+  if (numThreads == 0)
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<std::complex<ScalarType>> probe;
+  numThreads = std::min(numThreads, plan.order.size());
+  if (numThreads > 1 && !simulator.checkpointState(probe))
+    numThreads = 1;
+  probe = {};
+
+  if (numThreads == 1) {
+    runTrajectories(simulator, plan, 0, plan.order.size(), results);
+    return results;
+  }
 
-  for (std::size_t ti = 0; ti < numTrajectories; ++ti) {
-    const auto &traj = batch.trajectories[ti];
-    if (traj.num_shots == 0) {
-      results.push_back(cudaq::sample_result{
-          cudaq::ExecutionResult{cudaq::CountsDictionary{}}});
-      continue;
+  // Split the trajectories into contiguous blocks, so that each thread still
+  // reuses the prefixes within its block, and run each block on a simulator
+  // cloned for its worker thread. The calling thread runs the first block on
+  // the current simulator.
+  cudaq::info("[ptsbe] Running {} trajectories on {} threads",
+              plan.order.size(), numThreads);
+  const std::size_t blockSize =
+      (plan.order.size() + numThreads - 1) / numThreads;
+  const std::size_t nQubits = numQubits(batch.trace);
+  const std::string contextName = executionContext->name;
+  // Worker simulators are seeded from the global seed (if set), so that
+  // threaded results are reproducible.
+  const std::size_t seed = cudaq::get_random_seed();
+  std::vector<std::future<void>> blocks;
+  for (std::size_t w = 1; w < numThreads; ++w) {
+    const std::size_t begin = std::min(w * blockSize, plan.order.size());
+    const std::size_t end = std::min(begin + blockSize, plan.order.size());
+    if (begin == end)
+      break;
+    auto promise = std::make_shared<std::promise<void>>();
+    blocks.push_back(promise->get_future());
+    cudaq::QuantumTask task = [&, promise, w, begin, end]() {
+      try {
+        // The clone is the thread-local instance of the simulator class on
+        // this worker thread, reused by later calls.
+        auto *sim = dynamic_cast<nvqir::CircuitSimulatorBase<ScalarType> *>(
+            simulator.clone());
+        if (!sim)
+          throw std::runtime_error(
+              "Failed to clone the simulator for a PTSBE worker thread");
+        if (seed != 0)
+          sim->setRandomSeed(seed + w);
+        cudaq::ExecutionContext ctx(contextName, totalShots);
+        cudaq::detail::setExecutionContext(&ctx);
+        sim->configureExecutionContext(ctx);
+        sim->allocateQubits(nQubits);
+        try {
+          runTrajectories(*sim, plan, begin, end, results);
+        } catch (...) {
+          teardown(sim, ctx, nQubits);
+          throw;
+        }
+        teardown(sim, ctx, nQubits);
+        promise->set_value();
+      } catch (...) {
+        promise->set_exception(std::current_exception());
+      }
+    };
+    getWorkerQueue().enqueue(task);
+  }
+  std::exception_ptr error;
+  try {
+    runTrajectories(simulator, plan, 0, std::min(blockSize, plan.order.size()),
+                    results);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  for (auto &block : blocks) {
+    try {
+      block.get();
+    } catch (...) {
+      if (!error)
+        error = std::current_exception();
     }
-
-    simulator.setToZeroState();
-
-    auto mergedTasks =
-        cudaq::ptsbe::mergeTasksWithTrajectory<ScalarType>(batch.trace, traj);
-
-    for (const auto &task : mergedTasks)
-      simulator.applyGate(task);
-    simulator.flushGateQueue();
-
-    auto execResult =
-        simulator.sample(batch.measureQubits, static_cast<int>(traj.num_shots),
-                         batch.includeSequentialData);
-
-    cudaq::ExecutionResult er{execResult.counts};
-    if (batch.includeSequentialData)
-      er.sequentialData = std::move(execResult.sequentialData);
-    results.push_back(cudaq::sample_result{std::move(er)});
-
-    if ((ti + 1) % progressInterval == 0)
-      cudaq::info("[ptsbe] Trajectory progress: {}/{} ({} shots)", ti + 1,
-                  numTrajectories, traj.num_shots);
   }
+  if (error)
+    std::rethrow_exception(error);
 
   return results;
 }
@@ -263,18 +596,6 @@ std::vector<cudaq::sample_result> dispatchPTSBE(SimulatorType &sim,
   return samplePTSBEGeneric(sim, batch);
 }
 
-/// Finalize and tear down the execution context and deallocate qubits.
-/// finalizeExecutionContext must precede deallocateQubits because
-/// CircuitSimulatorBase::deallocateQubits is a no-op while a context is set.
-void teardown(nvqir::CircuitSimulator *sim, cudaq::ExecutionContext &ctx,
-              std::size_t nQubits) {
-  sim->finalizeExecutionContext(ctx);
-  cudaq::detail::resetExecutionContext();
-  std::vector<std::size_t> qubitIds(nQubits);
-  std::iota(qubitIds.begin(), qubitIds.end(), 0);
-  sim->deallocateQubits(qubitIds);
-}
-
 } // namespace
 
 std::vector<cudaq::sample_result> samplePTSBE(const PTSBatch &batch) {
@@ -437,11 +437,11 @@ cudaq::CompiledModule Compiler::runPassPipeline(
   // other passes).
   std::optional<cudaq::Resources> resourceCounts;
   if (executionContext && executionContext->name == "resource-count") {
+    // If the static counting fails, the resource counter simulator counts all
+    // of the kernel.
     auto result = cudaq::opt::countResourcesFromIR(moduleOp);
-    if (failed(result))
-      throw std::runtime_error(
-          "Could not successfully apply resource count preprocess.");
-    resourceCounts = std::move(*result);
+    if (succeeded(result))
+      resourceCounts = std::move(*result);
   }
 
   auto mapping_reorder_idx = extractMappingReorderIdx(moduleOp, epFunc);
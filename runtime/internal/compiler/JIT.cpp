@@ -7,6 +7,7 @@
  ******************************************************************************/
 
 #include "cudaq_internal/compiler/JIT.h"
+#include "cudaq_internal/compiler/JITCache.h"
 #include "common/CompiledModule.h"
 #include "common/Environment.h"
 #include "common/Timing.h"
@@ -19,6 +20,8 @@
 #include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
 #include "cudaq/Verifier/QIRLLVMIRDialect.h"
 #include "cudaq/runtime/logger/logger.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
 #include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
 #include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
@@ -27,6 +30,7 @@
 #include "llvm/IRReader/IRReader.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
@@ -123,6 +127,19 @@ cudaq_internal::compiler::createWrappedKernel(std::string_view irString,
   ExecutionEngine::setupTargetTriple(llvmModule.get());
   auto dataLayout = llvmModule->getDataLayout();
 
+  // With an on-disk object cache, the module identifier is the cache key.
+  auto *objectCache = getJITObjectCache();
+  if (objectCache) {
+    llvm::MD5 hash;
+    hash.update(irString);
+    hash.update(entryPointFn);
+    hash.update(llvmModule->getTargetTriple());
+    hash.update(LLVM_VERSION_STRING);
+    llvm::MD5::MD5Result digest;
+    hash.final(digest);
+    llvmModule->setModuleIdentifier(digest.digest().str());
+  }
+
   // Create the object layer
   auto objectLinkingLayerCreator = [&](llvm::orc::ExecutionSession &session,
                                        const llvm::Triple &tt) {
@@ -135,10 +152,17 @@ cudaq_internal::compiler::createWrappedKernel(std::string_view irString,
   };
 
   // Create the LLJIT with the object link layer
-  auto jit = llvm::cantFail(
-      llvm::orc::LLJITBuilder()
-          .setObjectLinkingLayerCreator(objectLinkingLayerCreator)
-          .create());
+  llvm::orc::LLJITBuilder jitBuilder;
+  jitBuilder.setObjectLinkingLayerCreator(objectLinkingLayerCreator);
+  if (objectCache)
+    jitBuilder.setCompileFunctionCreator(
+        [objectCache](llvm::orc::JITTargetMachineBuilder jtmb)
+            -> llvm::Expected<
+                std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
+          return std::make_unique<llvm::orc::ConcurrentIRCompiler>(
+              std::move(jtmb), objectCache);
+        });
+  auto jit = llvm::cantFail(jitBuilder.create());
 
   // Add a ThreadSafemodule to the engine and return.
   llvm::orc::ThreadSafeModule tsm(std::move(llvmModule), std::move(ctx));
@@ -165,6 +189,24 @@ cudaq_internal::compiler::createWrappedKernel(std::string_view irString,
 }
 
 namespace {
+/// Digest of the lowered module and the codegen translation, used as the key
+/// of the in-process JIT cache. Since the module has already been through the
+/// target pass pipeline and argument synthesis, its text captures the
+/// pipeline, the target configuration and the synthesized arguments.
+std::string getJITCacheKey(ModuleOp moduleOp, llvm::StringRef convertTo) {
+  std::string moduleStr;
+  {
+    llvm::raw_string_ostream os(moduleStr);
+    moduleOp.print(os);
+  }
+  llvm::MD5 hash;
+  hash.update(moduleStr);
+  hash.update(convertTo);
+  llvm::MD5::MD5Result digest;
+  hash.final(digest);
+  return digest.digest().str().str();
+}
+
 void insertSetupAndCleanupOperations(Operation *module) {
   OpBuilder modBuilder(module);
   auto *context = module->getContext();
@@ -247,6 +289,14 @@ cudaq_internal::compiler::createJITEngine(ModuleOp &moduleOp,
   // The "fast" instruction selection compilation algorithm is actually very
   // slow for large quantum circuits. Disable that here.
   ScopedTraceWithContext(cudaq::TIMING_JIT, "createJITEngine");
+  auto &cache = JITCache::get();
+  std::string cacheKey;
+  if (cache.getCapacity() > 0) {
+    cacheKey = getJITCacheKey(moduleOp, convertTo);
+    if (auto engine = cache.lookup(cacheKey))
+      return *engine;
+  }
+
   const char *argv[] = {"", "-fast-isel=0", nullptr};
   llvm::cl::ParseCommandLineOptions(2, argv);
 
@@ -336,7 +386,10 @@ cudaq_internal::compiler::createJITEngine(ModuleOp &moduleOp,
 
   auto jitOrError = ExecutionEngine::create(moduleOp, opts);
   assert(!!jitOrError && "ExecutionEngine creation failed.");
-  return JitEngine(std::move(jitOrError.get()));
+  JitEngine engine(std::move(jitOrError.get()));
+  if (!cacheKey.empty())
+    cache.insert(cacheKey, engine);
+  return engine;
 }
 
 class cudaq::JitEngine::Impl : public cudaq::JitEngine::Base {
@@ -0,0 +1,213 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "cudaq_internal/compiler/JITCache.h"
+#include "common/FmtCore.h"
+#include "common/Timing.h"
+#include "cudaq/runtime/logger/logger.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <stdexcept>
+
+using namespace cudaq_internal::compiler;
+
+namespace {
+constexpr const char *cacheSizeEnvVar = "CUDAQ_JIT_CACHE_SIZE";
+constexpr const char *cacheDirEnvVar = "CUDAQ_JIT_CACHE_DIR";
+constexpr std::size_t defaultCacheSize = 32;
+
+/// Object cache that persists the objects emitted by an `LLJIT` in a
+/// directory, so that later processes can skip code generation for the same
+/// LLVM module. Writes go through a temporary file and a rename, so
+/// concurrent processes sharing the directory never observe partial objects.
+class JITObjectCache : public llvm::ObjectCache {
+public:
+  explicit JITObjectCache(std::string directory)
+      : directory(std::move(directory)) {}
+
+  void notifyObjectCompiled(const llvm::Module *module,
+                            llvm::MemoryBufferRef object) override {
+    auto path = getPath(module);
+    if (path.empty())
+      return;
+    llvm::SmallString<256> tmpPath(path);
+    tmpPath += ".tmp" + std::to_string(llvm::sys::Process::getProcessId());
+    std::error_code ec;
+    {
+      llvm::raw_fd_ostream os(tmpPath, ec, llvm::sys::fs::OF_None);
+      if (ec) {
+        CUDAQ_INFO("Could not write JIT object cache file {}: {}",
+                   tmpPath.str().str(), ec.message());
+        return;
+      }
+      os << object.getBuffer();
+    }
+    if (auto ec = llvm::sys::fs::rename(tmpPath, path)) {
+      CUDAQ_INFO("Could not write JIT object cache file {}: {}", path,
+                 ec.message());
+      llvm::sys::fs::remove(tmpPath);
+    }
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer>
+  getObject(const llvm::Module *module) override {
+    auto path = getPath(module);
+    if (path.empty())
+      return nullptr;
+    // Not requiring a null terminator lets large objects be memory-mapped.
+    auto buffer = llvm::MemoryBuffer::getFile(path, /*IsText=*/false,
+                                              /*RequiresNullTerminator=*/false);
+    const bool hit = static_cast<bool>(buffer);
+    const std::size_t count = hit ? ++hits : ++misses;
+    if (cudaq::isTimingTagEnabled(cudaq::TIMING_JIT_CACHE))
+      cudaq::log("[tag={}] JIT object cache {} for {} ({} {})",
+                 cudaq::TIMING_JIT_CACHE, hit ? "hit" : "miss",
+                 module->getModuleIdentifier(), count,
+                 hit ? "hits" : "misses");
+    if (!hit)
+      return nullptr;
+    return std::move(*buffer);
+  }
+
+private:
+  std::string getPath(const llvm::Module *module) const {
+    const auto &id = module->getModuleIdentifier();
+    if (id.empty())
+      return {};
+    llvm::SmallString<256> path(directory);
+    llvm::sys::path::append(path, id + ".o");
+    return path.str().str();
+  }
+
+  std::string directory;
+  std::atomic<std::size_t> hits = 0;
+  std::atomic<std::size_t> misses = 0;
+};
+} // namespace
+
+JITCache::JITCache() : capacity(defaultCacheSize) {
+  if (auto *sizeEnvVar = std::getenv(cacheSizeEnvVar)) {
+    const std::string sizeStr(sizeEnvVar);
+    const char *nptr = sizeStr.data();
+    char *endptr = nullptr;
+    errno = 0; // reset errno to 0 before call
+    const auto size = strtol(nptr, &endptr, 10);
+    if (nptr == endptr || errno != 0 || size < 0)
+      throw std::runtime_error(
+          fmt::format("Invalid {} setting. Expected a non-negative "
+                      "integer. Got: {}",
+                      cacheSizeEnvVar, sizeStr));
+    capacity = size;
+    CUDAQ_INFO("Setting JIT cache size to {}.", capacity);
+  }
+}
+
+JITCache &JITCache::get() {
+  static JITCache cache;
+  return cache;
+}
+
+std::optional<cudaq::JitEngine> JITCache::lookup(const std::string &key) {
+  std::optional<cudaq::JitEngine> engine;
+  std::size_t count = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity == 0)
+      return std::nullopt;
+    auto iter = index.find(key);
+    if (iter != index.end()) {
+      entries.splice(entries.begin(), entries, iter->second);
+      engine = iter->second->second;
+      count = ++hits;
+    } else {
+      count = ++misses;
+    }
+  }
+  if (cudaq::isTimingTagEnabled(cudaq::TIMING_JIT_CACHE))
+    cudaq::log("[tag={}] JIT cache {} for {} ({} {})", cudaq::TIMING_JIT_CACHE,
+               engine ? "hit" : "miss", key, count,
+               engine ? "hits" : "misses");
+  return engine;
+}
+
+void JITCache::insert(const std::string &key, cudaq::JitEngine engine) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (capacity == 0)
+    return;
+  auto iter = index.find(key);
+  if (iter != index.end()) {
+    iter->second->second = std::move(engine);
+    entries.splice(entries.begin(), entries, iter->second);
+    return;
+  }
+  entries.emplace_front(key, std::move(engine));
+  index.emplace(key, entries.begin());
+  evict();
+}
+
+void JITCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  entries.clear();
+  index.clear();
+  hits = 0;
+  misses = 0;
+}
+
+std::size_t JITCache::getCapacity() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return capacity;
+}
+
+void JITCache::setCapacity(std::size_t newCapacity) {
+  std::lock_guard<std::mutex> lock(mutex);
+  capacity = newCapacity;
+  evict();
+}
+
+std::size_t JITCache::getHits() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return hits;
+}
+
+std::size_t JITCache::getMisses() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return misses;
+}
+
+void JITCache::evict() {
+  while (entries.size() > capacity) {
+    index.erase(entries.back().first);
+    entries.pop_back();
+  }
+}
+
+llvm::ObjectCache *cudaq_internal::compiler::getJITObjectCache() {
+  static std::unique_ptr<JITObjectCache> cache = []() {
+    std::unique_ptr<JITObjectCache> result;
+    auto *dirEnvVar = std::getenv(cacheDirEnvVar);
+    if (!dirEnvVar || std::string(dirEnvVar).empty())
+      return result;
+    if (auto ec = llvm::sys::fs::create_directories(dirEnvVar)) {
+      CUDAQ_WARN("Could not create JIT object cache directory {}: {}",
+                 dirEnvVar, ec.message());
+      return result;
+    }
+    CUDAQ_INFO("Using JIT object cache directory {}.", dirEnvVar);
+    result = std::make_unique<JITObjectCache>(dirEnvVar);
+    return result;
+  }();
+  return cache.get();
+}
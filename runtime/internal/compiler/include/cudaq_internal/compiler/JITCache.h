@@ -0,0 +1,78 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#pragma once
+
+#include "common/CompiledModule.h"
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace llvm {
+class ObjectCache;
+} // namespace llvm
+
+namespace cudaq_internal::compiler {
+
+/// In-process, least-recently-used cache of JIT engines.
+///
+/// Entries are keyed on a digest of the fully lowered module (which already
+/// reflects the pass pipeline, the target configuration and any synthesized
+/// kernel arguments) and of the codegen translation. Relaunching a kernel
+/// whose lowered IR did not change reuses the engine instead of re-running the
+/// QIR lowering and LLVM code generation.
+///
+/// The capacity is read from `CUDAQ_JIT_CACHE_SIZE` (number of engines, 0
+/// disables the cache). Hits and misses are reported when timing tag
+/// `cudaq::TIMING_JIT_CACHE` is enabled.
+class JITCache {
+public:
+  /// @brief Return the process-wide cache.
+  static JITCache &get();
+
+  /// @brief Return the engine stored under `key`, if any, and mark it as most
+  /// recently used.
+  std::optional<cudaq::JitEngine> lookup(const std::string &key);
+
+  /// @brief Store `engine` under `key`, evicting the least recently used
+  /// engine if the cache is full.
+  void insert(const std::string &key, cudaq::JitEngine engine);
+
+  /// @brief Drop all cached engines and reset the counters.
+  void clear();
+
+  std::size_t getCapacity() const;
+  void setCapacity(std::size_t newCapacity);
+
+  std::size_t getHits() const;
+  std::size_t getMisses() const;
+
+private:
+  JITCache();
+  void evict();
+
+  using Entry = std::pair<std::string, cudaq::JitEngine>;
+  /// Most recently used engine first.
+  std::list<Entry> entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index;
+  std::size_t capacity = 0;
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  mutable std::mutex mutex;
+};
+
+/// @brief Return the on-disk object cache for `LLJIT` instances, or null if
+/// `CUDAQ_JIT_CACHE_DIR` is not set. Objects are stored as
+/// `<CUDAQ_JIT_CACHE_DIR>/<module identifier>.o` and memory-mapped on load, so
+/// modules handed to a JIT using this cache must carry a content digest as
+/// their identifier.
+llvm::ObjectCache *getJITObjectCache();
+
+} // namespace cudaq_internal::compiler
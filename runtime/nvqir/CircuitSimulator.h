@@ -9,6 +9,8 @@
 #pragma once
 
 #include "Gates.h"
+#include "PauliExpectation.h"
+#include "SimulatorProfile.h"
 #include "common/Environment.h"
 #include "common/ExecutionContext.h"
 #include "common/NoiseModel.h"
@@ -20,11 +22,14 @@
 #include "cudaq/algorithms/policy_dispatch.h"
 #include "cudaq/host_config.h"
 #include "cudaq/runtime/logger/logger.h"
+#include <algorithm>
 #include <concepts>
 #include <cstdarg>
 #include <cstddef>
 #include <iostream>
+#include <map>
 #include <queue>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -101,6 +106,10 @@ protected:
   /// @brief Statistics collected over the life of the simulator.
   SummaryData summaryData;
 
+  /// @brief Per-gate timing histograms and trace events, collected over the
+  /// life of the simulator when the `TIMING_PROFILE` tag is enabled.
+  SimulatorProfile profile;
+
   /// @brief An "opt-in" way for simulators to tell the base class that they are
   /// capable of buffering sample results across multiple invocations of the
   /// sample() function.
@@ -162,6 +171,15 @@ public:
   /// https://arxiv.org/pdf/2407.13826.
   virtual void generateMSM() {}
 
+  /// @brief For simulators that support it, annotate the executed circuit
+  /// with the detectors and observables of the execution context, and
+  /// generate its detector error model and detection event samples, as
+  /// described by `cudaq::detector_sample_options`.
+  virtual void generateDetectorSamples() {
+    throw std::runtime_error(
+        "Detector sampling is not supported by this simulator backend.");
+  }
+
   /// @brief Apply exp(-i theta PauliTensorProd) to the underlying state.
   /// This must be provided by subclasses.
   virtual void applyExpPauli(double theta,
@@ -442,18 +460,63 @@ public:
   /// operation, a set of possible control qubit indices, and a set of target
   /// indices.
   struct GateApplicationTask {
-    const std::string operationName;
-    const std::vector<std::complex<ScalarType>> matrix;
-    const std::vector<std::size_t> controls;
-    const std::vector<std::size_t> targets;
-    const std::vector<ScalarType> parameters;
+    std::string operationName;
+    /// @brief The interned `operationName`, GateName::Custom for operations
+    /// that are not CUDA-Q gates.
+    GateName opcode = GateName::Custom;
+    std::vector<std::complex<ScalarType>> matrix;
+    std::vector<std::size_t> controls;
+    std::vector<std::size_t> targets;
+    std::vector<ScalarType> parameters;
+    GateApplicationTask() = default;
     GateApplicationTask(const std::string &name,
                         const std::vector<std::complex<ScalarType>> &m,
                         const std::vector<std::size_t> &c,
                         const std::vector<std::size_t> &t,
                         const std::vector<ScalarType> &params)
-        : operationName(name), matrix(m), controls(c), targets(t),
-          parameters(params) {}
+        : operationName(name), opcode(getGateNameOrCustom(name)), matrix(m),
+          controls(c), targets(t), parameters(params) {}
+  };
+
+  /// @brief First-in first-out queue of gate tasks, stored in a ring of
+  /// reusable slots. A popped slot keeps its string and vector capacity, so
+  /// once the ring has grown to the deepest queue seen, enqueuing a gate
+  /// overwrites a slot in place instead of allocating.
+  class GateQueue {
+  public:
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    GateApplicationTask &front() { return slots[head]; }
+
+    void pop() {
+      head = count == 1 ? 0 : (head + 1) % slots.size();
+      --count;
+    }
+
+    /// @brief Drop all queued tasks, keeping the slots for reuse.
+    void clear() {
+      head = 0;
+      count = 0;
+    }
+
+    void push(const GateApplicationTask &task) { nextSlot() = task; }
+
+    /// @brief Append a slot to the queue and return it. The caller must
+    /// overwrite every field, since the slot may hold a previous task.
+    GateApplicationTask &nextSlot() {
+      if (count == slots.size()) {
+        // Unwrap the ring so that the queued tasks stay in order.
+        std::rotate(slots.begin(), slots.begin() + head, slots.end());
+        head = 0;
+        slots.resize(std::max<std::size_t>(16, 2 * slots.size()));
+      }
+      return slots[(head + count++) % slots.size()];
+    }
+
+  private:
+    std::vector<GateApplicationTask> slots;
+    std::size_t head = 0;
+    std::size_t count = 0;
   };
 
 private:
@@ -501,7 +564,11 @@ protected:
       "CUDAQ_OBSERVE_FROM_SAMPLING";
 
   /// @brief The current queue of operations to execute
-  std::queue<GateApplicationTask> gateQueue;
+  GateQueue gateQueue;
+
+  /// @brief Scratch buffer for the gate parameters passed to
+  /// applyNoiseChannel() by single-precision simulators.
+  std::vector<double> noiseParams;
 
   /// @brief Get the name of the current circuit being executed.
   std::string getCircuitName() const { return currentCircuitName; }
@@ -535,6 +602,15 @@ protected:
   /// This is subclass specific.
   virtual void addQubitToState() = 0;
 
+  /// @brief Return the size of the simulation state in bytes, for profiling.
+  /// By default, this is the size of a state vector for state vector
+  /// simulators, and unknown (0) otherwise.
+  virtual std::size_t getStateMemoryBytes() const {
+    if (!isStateVectorSimulator())
+      return 0;
+    return stateDimension * sizeof(std::complex<ScalarType>);
+  }
+
   /// @brief Subclass specific part of deallocateState().
   /// It will be invoked by deallocateState()
   virtual void deallocateStateImpl() = 0;
@@ -542,8 +618,9 @@ protected:
   /// @brief Reset the qubit state back to dim = 0.
   void deallocateState() {
     deallocateStateImpl();
-    auto empty = std::queue<GateApplicationTask>{};
-    std::swap(gateQueue, empty);
+    if (profile.enabled)
+      profile.recordMemory(0);
+    gateQueue.clear();
     nQubitsAllocated = 0;
     stateDimension = 0;
   }
@@ -612,9 +689,9 @@ protected:
   /// @brief Utility function that returns a string-view of the current
   /// quantum instruction, intended for logging purposes.
   std::string gateToString(const std::string_view gateName,
-                           const std::vector<std::size_t> &controls,
-                           const std::vector<ScalarType> &parameters,
-                           const std::vector<std::size_t> &targets) {
+                           std::span<const std::size_t> controls,
+                           std::span<const ScalarType> parameters,
+                           std::span<const std::size_t> targets) {
     std::string angleStr = "";
     if (!parameters.empty()) {
       angleStr = std::to_string(parameters[0]);
@@ -666,7 +743,7 @@ protected:
   /// recorded for sampling. Used to decide whether a gate application
   /// should trigger a sampling flush (only needed when the gate operates
   /// on a qubit that was already measured, i.e. mid-circuit measurement).
-  bool operatesOnMeasuredQubit(const std::vector<std::size_t> &qubits) const {
+  bool operatesOnMeasuredQubit(std::span<const std::size_t> qubits) const {
     for (auto q : qubits)
       if (std::find(sampleQubits.begin(), sampleQubits.end(), q) !=
           sampleQubits.end())
@@ -681,6 +758,7 @@ protected:
     if (force && supportsBufferedSample &&
         executionContext->explicitMeasurements) {
       int nShots = getNumShotsToExec();
+      ProfileScope sampleScope(profile, ProfileCategory::sample, "sample");
       if (!sampleQubits.empty()) {
         // We have a few more qubits to be sampled. Call sample on the subclass,
         // but there is no need to save the results this time.
@@ -712,7 +790,10 @@ protected:
                sampleQubits);
 
     // Ask the subtype to sample the current state
-    auto execResult = sample(sampleQubits, getNumShotsToExec());
+    auto execResult = [&] {
+      ProfileScope sampleScope(profile, ProfileCategory::sample, "sample");
+      return sample(sampleQubits, getNumShotsToExec());
+    }();
 
     // Warn if there are named measurement registers beyond `__global__`
     if (!executionContext->warnedNamedMeasurements &&
@@ -731,6 +812,7 @@ protected:
       internalResult.append(execResult, executionContext->explicitMeasurements);
     } else {
 
+      execResult.unpack();
       for (auto &[regName, qubits] : registerNameToMeasuredQubit) {
         // Measurements are sorted according to qubit allocation order
         std::sort(qubits.begin(), qubits.end());
@@ -765,11 +847,38 @@ protected:
   }
 
   /// @brief Add a new gate application task to the queue
-  void enqueueGate(const std::string name,
-                   const std::vector<std::complex<ScalarType>> &matrix,
-                   const std::vector<std::size_t> &controls,
-                   const std::vector<std::size_t> &targets,
-                   const std::vector<ScalarType> &params) {
+  void enqueueGate(const std::string_view name,
+                   std::span<const std::complex<ScalarType>> matrix,
+                   std::span<const std::size_t> controls,
+                   std::span<const std::size_t> targets,
+                   std::span<const ScalarType> params) {
+    if (auto *task = beginGateTask(getGateNameOrCustom(name), name, controls,
+                                   targets, params)) {
+      task->matrix.assign(matrix.begin(), matrix.end());
+      logGateTask(*task);
+    }
+  }
+
+  /// @brief Add a new gate application task for a CUDA-Q gate to the queue.
+  /// The gate matrix is written straight into the queue slot.
+  void enqueueGate(GateName opcode, const std::string_view name,
+                   std::span<const std::size_t> controls,
+                   std::span<const std::size_t> targets,
+                   std::span<const ScalarType> params) {
+    if (auto *task = beginGateTask(opcode, name, controls, targets, params)) {
+      fillGateByName<ScalarType>(opcode, params, task->matrix);
+      logGateTask(*task);
+    }
+  }
+
+  /// @brief Fill the next gate queue slot with everything but the matrix and
+  /// return it, or record the gate in the kernel trace and return nullptr in
+  /// tracer mode.
+  GateApplicationTask *beginGateTask(GateName opcode,
+                                     const std::string_view name,
+                                     std::span<const std::size_t> controls,
+                                     std::span<const std::size_t> targets,
+                                     std::span<const ScalarType> params) {
     if (cudaq::isInTracerMode()) {
       std::vector<cudaq::QuditInfo> controlsInfo, targetsInfo;
       for (auto &c : controls)
@@ -777,19 +886,23 @@ protected:
       for (auto &t : targets)
         targetsInfo.emplace_back(2, t);
 
-      std::vector<double> anglesProcessed;
-      if constexpr (std::is_same_v<ScalarType, double>)
-        anglesProcessed = params;
-      else {
-        for (auto &a : params)
-          anglesProcessed.push_back(static_cast<ScalarType>(a));
-      }
-
+      std::vector<double> anglesProcessed(params.begin(), params.end());
       cudaq::getExecutionContext()->kernelTrace.appendInstruction(
           name, anglesProcessed, controlsInfo, targetsInfo);
-      return;
+      return nullptr;
     }
 
+    auto &task = gateQueue.nextSlot();
+    task.operationName.assign(name);
+    task.opcode = opcode;
+    task.controls.assign(controls.begin(), controls.end());
+    task.targets.assign(targets.begin(), targets.end());
+    task.parameters.assign(params.begin(), params.end());
+    return &task;
+  }
+
+  /// @brief Log the matrix of a newly queued gate task, if requested.
+  void logGateTask(const GateApplicationTask &task) {
     // Use static variables to reduce the number of calls to cudaq::getEnvBool
     // since this is a frequently called piece of code, and we don't expect it
     // to change in the middle of a run.
@@ -800,10 +913,9 @@ protected:
       z_env_var_checked = true;
     }
     if (z_matrix_logging)
-      cudaq::log("{}: matrix={}, controls={}, targets={}, params={}", name,
-                 matrix, controls, targets, params);
-
-    gateQueue.emplace(name, matrix, controls, targets, params);
+      cudaq::log("{}: matrix={}, controls={}, targets={}, params={}",
+                 task.operationName, task.matrix, task.controls, task.targets,
+                 task.parameters);
   }
 
   /// @brief Provide a base-class method that can be invoked
@@ -822,6 +934,7 @@ protected:
   /// application tasks.
   void flushGateQueueImpl() override {
     auto executionContext = cudaq::getExecutionContext();
+    ProfileScope flushScope(profile, ProfileCategory::flush, "flush");
 
     while (!gateQueue.empty()) {
       auto &next = gateQueue.front();
@@ -830,23 +943,29 @@ protected:
             next.controls.size(), next.targets.size(), stateDimension,
             stateDimension * sizeof(std::complex<ScalarType>));
       try {
+        ProfileScope gateScope(profile, ProfileCategory::gate,
+                               next.operationName);
         applyGate(next);
       } catch (std::exception &e) {
-        while (!gateQueue.empty())
-          gateQueue.pop();
+        gateQueue.clear();
         throw std::runtime_error(std::string("Exception in applyGate: ") +
                                  e.what());
       } catch (...) {
-        while (!gateQueue.empty())
-          gateQueue.pop();
+        gateQueue.clear();
         throw std::runtime_error("Unknown exception in applyGate");
       }
       if (executionContext && executionContext->noiseModel &&
           !executionContext->noiseModel->empty()) {
-        std::vector<double> params(next.parameters.begin(),
-                                   next.parameters.end());
-        applyNoiseChannel(next.operationName, next.controls, next.targets,
-                          params);
+        ProfileScope noiseScope(profile, ProfileCategory::noise,
+                                next.operationName);
+        if constexpr (std::is_same_v<ScalarType, double>) {
+          applyNoiseChannel(next.operationName, next.controls, next.targets,
+                            next.parameters);
+        } else {
+          noiseParams.assign(next.parameters.begin(), next.parameters.end());
+          applyNoiseChannel(next.operationName, next.controls, next.targets,
+                            noiseParams);
+        }
       }
       gateQueue.pop();
     }
@@ -865,6 +984,61 @@ protected:
     return cudaq::getEnvBool(observeSamplingEnvVar, defaultConfig);
   }
 
+  /// @brief Compute the expected value of `op` directly from the amplitudes
+  /// of a CPU-resident state, one Pauli term at a time, without building the
+  /// matrix of `op`. `data` holds `stateDimension` amplitudes, or a
+  /// column-major `stateDimension` x `stateDimension` density matrix if
+  /// `isDensityMatrix` is set. Qubit `q` maps to bit `q` of the amplitude
+  /// index, which is the layout of the CPU simulator states whatever
+  /// `getQubitOrdering()` says about the gate matrices. The expectation value
+  /// of each term is recorded under its term id, so that
+  /// `observe_result::expectation(term)` works as for sampling-based observe.
+  cudaq::observe_result
+  observeFromAmplitudes(const cudaq::spin_op &op,
+                        const std::complex<ScalarType> *data,
+                        bool isDensityMatrix) {
+    const std::size_t numQubits = std::log2(stateDimension);
+    std::vector<nvqir::kernels::PauliMask> terms;
+    terms.reserve(op.num_terms());
+    for (const auto &term : op) {
+      nvqir::kernels::PauliMask mask;
+      for (const auto &p : term) {
+        auto pauli = p.as_pauli();
+        if (pauli == cudaq::pauli::I)
+          continue;
+        const std::size_t target = p.target();
+        if (target >= numQubits)
+          throw std::runtime_error(
+              "Cannot observe a spin_op on qubit " + std::to_string(target) +
+              " of a state of " + std::to_string(numQubits) + " qubits.");
+        const std::size_t bit = 1ULL << target;
+        if (pauli != cudaq::pauli::Z)
+          mask.xMask |= bit;
+        if (pauli != cudaq::pauli::X)
+          mask.zMask |= bit;
+        if (pauli == cudaq::pauli::Y)
+          ++mask.numY;
+      }
+      terms.push_back(mask);
+    }
+
+    const auto values = nvqir::kernels::pauliExpectations(
+        data, stateDimension, terms, isDensityMatrix);
+    double ee = 0.0;
+    std::vector<cudaq::ExecutionResult> results;
+    results.reserve(values.size() + 1);
+    std::size_t t = 0;
+    for (const auto &term : op) {
+      ee += (term.evaluate_coefficient() * values[t]).real();
+      results.emplace_back(cudaq::CountsDictionary{}, term.get_term_id(),
+                           values[t].real());
+      ++t;
+    }
+    results.emplace_back(cudaq::CountsDictionary{}, op.to_string(), ee);
+
+    return cudaq::observe_result(ee, op, cudaq::sample_result(results));
+  }
+
   bool isSinglePrecision() const override {
     return std::is_same_v<ScalarType, float>;
   }
@@ -887,6 +1061,23 @@ public:
         "The current backend does not support noise modeling.");
   }
 
+  /// @brief Copy the current state (after flushing the gate queue) into
+  /// `checkpoint`, reusing its allocation, so that `restoreState` can later
+  /// return to it. Return false if this simulator does not support state
+  /// checkpoints, which is the default.
+  virtual bool
+  checkpointState(std::vector<std::complex<ScalarType>> &checkpoint) {
+    return false;
+  }
+
+  /// @brief Replace the current state with one saved by `checkpointState`
+  /// for the same number of qubits.
+  virtual void
+  restoreState(const std::vector<std::complex<ScalarType>> &checkpoint) {
+    throw std::runtime_error(
+        "This CircuitSimulator does not support state checkpoints.");
+  }
+
   /// @brief Compute the expected value of the given spin op
   /// with respect to the current state, <psi | H | psi>.
   cudaq::observe_result observe(const cudaq::spin_op &term) override {
@@ -980,8 +1171,7 @@ public:
     if (getNumQubits() == 0) {
       if (cudaq::isInBatchMode() && !cudaq::isLastBatch()) {
         setToZeroState();
-        auto empty = std::queue<GateApplicationTask>{};
-        std::swap(gateQueue, empty);
+        gateQueue.clear();
       } else {
         deallocateState();
       }
@@ -1081,6 +1271,10 @@ protected:
     if (context.name == "msm") {
       generateMSM();
     }
+
+    if (context.name == "detector_sample") {
+      generateDetectorSamples();
+    }
   }
 
 public:
@@ -1098,8 +1292,7 @@ public:
       CUDAQ_INFO("In batch mode currently, resetting simulator state to |0>");
       // Do not deallocate the state, but reset it to |0> to be reused
       setToZeroState();
-      auto empty = std::queue<GateApplicationTask>{};
-      std::swap(gateQueue, empty);
+      gateQueue.clear();
     } else {
       CUDAQ_INFO("Deallocating simulator state.");
       // all qubits deallocated,
@@ -1179,31 +1372,32 @@ public:
   }
 
   template <typename QuantumOperation>
-  void enqueueQuantumOperation(const std::vector<ScalarType> &angles,
-                               const std::vector<std::size_t> &controls,
-                               const std::vector<std::size_t> &targets) {
+  void enqueueQuantumOperation(std::span<const ScalarType> angles,
+                               std::span<const std::size_t> controls,
+                               std::span<const std::size_t> targets) {
     if (operatesOnMeasuredQubit(controls) || operatesOnMeasuredQubit(targets))
       flushAnySamplingTasks();
     QuantumOperation gate;
     CUDAQ_INFO(gateToString(gate.name(), controls, angles, targets));
-    enqueueGate(gate.name(), gate.getGate(angles), controls, targets, angles);
+    enqueueGate(QuantumOperation::opcode, gate.name(), controls, targets,
+                angles);
   }
 
 #define CIRCUIT_SIMULATOR_ONE_QUBIT(NAME)                                      \
   using CircuitSimulator::NAME;                                                \
   void NAME(const std::vector<std::size_t> &controls,                          \
             const std::size_t qubitIdx) override {                             \
-    enqueueQuantumOperation<nvqir::NAME<ScalarType>>(                          \
-        {}, controls, std::vector<std::size_t>{qubitIdx});                     \
+    enqueueQuantumOperation<nvqir::NAME<ScalarType>>({}, controls,             \
+                                                     {&qubitIdx, 1});          \
   }
 
 #define CIRCUIT_SIMULATOR_ONE_QUBIT_ONE_PARAM(NAME)                            \
   using CircuitSimulator::NAME;                                                \
   void NAME(const double angle, const std::vector<std::size_t> &controls,      \
             const std::size_t qubitIdx) override {                             \
-    enqueueQuantumOperation<nvqir::NAME<ScalarType>>(                          \
-        {static_cast<ScalarType>(angle)}, controls,                            \
-        std::vector<std::size_t>{qubitIdx});                                   \
+    const ScalarType angles[] = {static_cast<ScalarType>(angle)};              \
+    enqueueQuantumOperation<nvqir::NAME<ScalarType>>(angles, controls,         \
+                                                     {&qubitIdx, 1});          \
   }
 
   /// @brief The X gate
@@ -1241,48 +1435,42 @@ public:
   void u2(const double phi, const double lambda,
           const std::vector<std::size_t> &controls,
           const std::size_t qubitIdx) override {
-    std::vector<ScalarType> tmp{static_cast<ScalarType>(phi),
-                                static_cast<ScalarType>(lambda)};
-
-    enqueueQuantumOperation<nvqir::u2<ScalarType>>(
-        tmp, controls, std::vector<std::size_t>{qubitIdx});
+    const ScalarType tmp[] = {static_cast<ScalarType>(phi),
+                              static_cast<ScalarType>(lambda)};
+    enqueueQuantumOperation<nvqir::u2<ScalarType>>(tmp, controls,
+                                                   {&qubitIdx, 1});
   }
 
   using CircuitSimulator::u3;
   void u3(const double theta, const double phi, const double lambda,
           const std::vector<std::size_t> &controls,
           const std::size_t qubitIdx) override {
-    std::vector<ScalarType> tmp{static_cast<ScalarType>(theta),
-                                static_cast<ScalarType>(phi),
-                                static_cast<ScalarType>(lambda)};
-    enqueueQuantumOperation<nvqir::u3<ScalarType>>(
-        tmp, controls, std::vector<std::size_t>{qubitIdx});
+    const ScalarType tmp[] = {static_cast<ScalarType>(theta),
+                              static_cast<ScalarType>(phi),
+                              static_cast<ScalarType>(lambda)};
+    enqueueQuantumOperation<nvqir::u3<ScalarType>>(tmp, controls,
+                                                   {&qubitIdx, 1});
   }
 
   using CircuitSimulator::phased_rx;
   void phased_rx(const double phi, const double lambda,
                  const std::vector<std::size_t> &controls,
                  const std::size_t qubitIdx) override {
-    std::vector<ScalarType> tmp{static_cast<ScalarType>(phi),
-                                static_cast<ScalarType>(lambda)};
-    enqueueQuantumOperation<nvqir::phased_rx<ScalarType>>(
-        tmp, controls, std::vector<std::size_t>{qubitIdx});
+    const ScalarType tmp[] = {static_cast<ScalarType>(phi),
+                              static_cast<ScalarType>(lambda)};
+    enqueueQuantumOperation<nvqir::phased_rx<ScalarType>>(tmp, controls,
+                                                          {&qubitIdx, 1});
   }
 
   using CircuitSimulator::swap;
   /// @brief Invoke a general multi-control swap gate
   void swap(const std::vector<std::size_t> &ctrlBits, const std::size_t srcIdx,
             const std::size_t tgtIdx) override {
-    if (operatesOnMeasuredQubit(ctrlBits) ||
-        operatesOnMeasuredQubit({srcIdx, tgtIdx}))
+    const std::size_t targets[] = {srcIdx, tgtIdx};
+    if (operatesOnMeasuredQubit(ctrlBits) || operatesOnMeasuredQubit(targets))
       flushAnySamplingTasks();
-    CUDAQ_INFO(gateToString("swap", ctrlBits, {}, {srcIdx, tgtIdx}));
-    std::vector<std::complex<ScalarType>> matrix{
-        {1.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0},
-        {1.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {1.0, 0.0}, {0.0, 0.0}, {0.0, 0.0},
-        {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {1.0, 0.0}};
-    enqueueGate("swap", matrix, ctrlBits,
-                std::vector<std::size_t>{srcIdx, tgtIdx}, {});
+    CUDAQ_INFO(gateToString("swap", ctrlBits, {}, targets));
+    enqueueGate(GateName::Swap, "swap", ctrlBits, targets, {});
   }
 
   bool mz(const std::size_t qubitIdx) override { return mz(qubitIdx, ""); }
@@ -1316,15 +1504,18 @@ public:
     // Apply measurement noise (if any)
     // Note: gate noises are applied during flushGateQueue
     if (executionContext && executionContext->noiseModel &&
-        !executionContext->noiseModel->empty())
+        !executionContext->noiseModel->empty()) {
+      ProfileScope noiseScope(profile, ProfileCategory::noise, "mz");
       applyNoiseChannel(/*gateName=*/"mz", /*controls=*/{},
                         /*targets=*/{qubitIdx}, /*params=*/{});
+    }
 
     // If sampling, just store the bit, do nothing else.
     if (handleBasicSampling(qubitIdx, registerName))
       return true;
 
     // Get the actual measurement from the subtype measureQubit implementation
+    ProfileScope measureScope(profile, ProfileCategory::measure, "mz");
     auto measureResult = measureQubit(qubitIdx);
 
     // Return the result
@@ -1349,9 +1540,7 @@ public:
     }
 
     if (op.num_terms() != 1)
-      // more than one term needs to be directly supported by the backend
-      throw std::runtime_error(
-          "measuring a sum of spin operators is not supported");
+      return measureQubitWiseCommutingTerms(op);
 
     CUDAQ_INFO("Measure {}", op.to_string());
     std::vector<std::size_t> qubitsToMeasure;
@@ -1389,7 +1578,10 @@ public:
       shots = executionContext->shots;
 
     // Sample and give the data to the context
-    cudaq::ExecutionResult result = sample(qubitsToMeasure, shots);
+    cudaq::ExecutionResult result = [&] {
+      ProfileScope sampleScope(profile, ProfileCategory::sample, "sample");
+      return sample(qubitsToMeasure, shots);
+    }();
     cudaq::SpinMeasureResult spinMeasureResult(
         result.expectationValue.value_or(0.0), result);
 
@@ -1405,6 +1597,94 @@ public:
     return spinMeasureResult;
   }
 
+protected:
+  /// @brief Measure every term of a sum of qubit-wise commuting spin operators
+  /// from a single batch of shots. A single basis change is applied for the
+  /// whole sum, the union of the qubits is sampled once, and the counts and
+  /// expectation value of each term are computed from the marginal of the
+  /// shared bit strings. The returned `sample_result` holds one
+  /// `ExecutionResult` per term, with the term id as register name.
+  cudaq::SpinMeasureResult
+  measureQubitWiseCommutingTerms(const cudaq::spin_op &op) {
+    auto executionContext = cudaq::getExecutionContext();
+
+    std::map<std::size_t, cudaq::pauli> basis;
+    for (const auto &term : op)
+      for (const auto &p : term) {
+        auto pauli = p.as_pauli();
+        if (pauli == cudaq::pauli::I)
+          continue;
+        auto [iter, inserted] = basis.emplace(p.target(), pauli);
+        if (!inserted && iter->second != pauli)
+          throw std::runtime_error(
+              "measuring a sum of spin operators is only supported if all "
+              "terms are qubit-wise commuting");
+      }
+
+    if (executionContext->shots == 0 ||
+        executionContext->shots == static_cast<std::size_t>(-1))
+      throw std::runtime_error("measuring a sum of spin operators requires "
+                               "a shot-based execution context");
+    const int shots = executionContext->shots;
+
+    CUDAQ_INFO("Measure {} qubit-wise commuting terms", op.num_terms());
+    std::vector<std::size_t> qubitsToMeasure;
+    for (auto &[target, pauli] : basis) {
+      qubitsToMeasure.push_back(target);
+      if (pauli == cudaq::pauli::Y)
+        rx(M_PI_2, target);
+      else if (pauli == cudaq::pauli::X)
+        h(target);
+    }
+    flushGateQueue();
+
+    cudaq::ExecutionResult shared =
+        sample(qubitsToMeasure, shots, /*includeSequentialData=*/false);
+    shared.unpack();
+
+    // Restore the state.
+    for (auto iter = basis.rbegin(); iter != basis.rend(); ++iter) {
+      if (iter->second == cudaq::pauli::Y)
+        rx(-M_PI_2, iter->first);
+      else if (iter->second == cudaq::pauli::X)
+        h(iter->first);
+    }
+    flushGateQueue();
+
+    double sum = 0.0;
+    std::vector<cudaq::ExecutionResult> termResults;
+    termResults.reserve(op.num_terms());
+    for (const auto &term : op) {
+      // Position of each of the term's qubits in the shared bit strings
+      // (qubitsToMeasure is sorted).
+      std::vector<std::size_t> positions;
+      for (const auto &p : term)
+        if (p.as_pauli() != cudaq::pauli::I)
+          positions.push_back(std::distance(
+              qubitsToMeasure.begin(),
+              std::lower_bound(qubitsToMeasure.begin(), qubitsToMeasure.end(),
+                               p.target())));
+
+      cudaq::CountsDictionary counts;
+      for (auto &[bits, count] : shared.counts) {
+        std::string marginal;
+        marginal.reserve(positions.size());
+        for (auto pos : positions)
+          marginal += bits[pos];
+        counts[marginal] += count;
+      }
+
+      double exp = 0.0;
+      for (auto &[bits, count] : counts)
+        exp += (cudaq::sample_result::has_even_parity(bits) ? 1.0 : -1.0) *
+               count / shots;
+      sum += term.evaluate_coefficient().real() * exp;
+      termResults.emplace_back(counts, term.get_term_id(), exp);
+    }
+
+    return cudaq::SpinMeasureResult(sum, cudaq::sample_result(termResults));
+  }
+
 private:
   template <std::invocable<std::size_t> Callable>
   std::vector<std::size_t> allocateQubitsInternal(std::size_t count,
@@ -1427,12 +1707,16 @@ private:
       if (!cudaq::isInTracerMode()) {
         // Tell the subtype to allocate more qubits
         try {
+          ProfileScope allocateScope(profile, ProfileCategory::allocate,
+                                     "allocate");
           allocateQubits(numAllocs);
         } catch (...) {
           nQubitsAllocated -= numAllocs;
           stateDimension = previousStateDimension;
           throw;
         }
+        if (profile.enabled)
+          profile.recordMemory(getStateMemoryBytes());
       }
 
       // May be that the state grows enough that we
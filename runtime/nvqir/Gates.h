@@ -17,6 +17,9 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <span>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace nvqir {
@@ -46,11 +49,14 @@ enum class GateName {
   U3,
   PhasedRx,
   Swap,
-  Id
+  Id,
+  /// Any operation not listed above, e.g. a custom unitary
+  Custom
 };
 
-/// @brief Given a string, return the corresponding GateName enum value.
-inline GateName getGateNameFromString(const std::string &name) {
+/// @brief Given a gate name, return the corresponding GateName enum value, or
+/// GateName::Custom if the name is not one of the CUDA-Q operations.
+inline GateName getGateNameOrCustom(std::string_view name) {
   if (name == "x")
     return GateName::X;
   else if (name == "y")
@@ -88,104 +94,150 @@ inline GateName getGateNameFromString(const std::string &name) {
   else if (name == "id")
     return GateName::Id;
 
+  return GateName::Custom;
+}
+
+/// @brief Given a string, return the corresponding GateName enum value.
+inline GateName getGateNameFromString(const std::string &name) {
+  auto gateName = getGateNameOrCustom(name);
+  if (gateName != GateName::Custom)
+    return gateName;
   throw std::runtime_error("Invalid gate name provided: " + name);
 }
-/// @brief Given the gate name (an element of the GateName enum),
-/// return the matrix data, optionally parameterized by a rotation angle.
+
+/// @brief Given the gate name (an element of the GateName enum), write the
+/// matrix data, optionally parameterized by a rotation angle, into `matrix`.
+/// The existing capacity of `matrix` is reused.
 template <typename Scalar>
-std::vector<std::complex<Scalar>>
-getGateByName(GateName name, const std::vector<Scalar> angles = {}) {
+void fillGateByName(GateName name, std::span<const Scalar> angles,
+                    std::vector<std::complex<Scalar>> &matrix) {
   Scalar two = 2.;
   switch (name) {
   case (GateName::X):
-    return {{0., 0.}, {1.0, 0.}, {1.0, 0.0}, {0., 0.}};
+    matrix.assign({{0., 0.}, {1.0, 0.}, {1.0, 0.0}, {0., 0.}});
+    return;
   case (GateName::Y):
-    return {{0., 0.}, {0.0, -1.0}, {0.0, 1.0}, {0., 0.}};
+    matrix.assign({{0., 0.}, {0.0, -1.0}, {0.0, 1.0}, {0., 0.}});
+    return;
   case (GateName::Z):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {-1., 0.}};
+    matrix.assign({{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {-1., 0.}});
+    return;
   case (GateName::H): {
     Scalar oneOverSqrt2 = 1 / std::sqrt(2.);
-    return {oneOverSqrt2, oneOverSqrt2, oneOverSqrt2, -oneOverSqrt2};
+    matrix.assign({oneOverSqrt2, oneOverSqrt2, oneOverSqrt2, -oneOverSqrt2});
+    return;
   }
   case (GateName::S):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {0., 1.}};
+    matrix.assign({{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {0., 1.}});
+    return;
   case (GateName::Sdg):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {0., -1.}};
+    matrix.assign({{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {0., -1.}});
+    return;
   case (GateName::T):
-    return {{1., 0.},
-            {0.0, 0.},
-            {0.0, 0.0},
-            std::exp(im<Scalar> * static_cast<Scalar>(M_PI_4))};
+    matrix.assign({{1., 0.},
+                   {0.0, 0.},
+                   {0.0, 0.0},
+                   std::exp(im<Scalar> * static_cast<Scalar>(M_PI_4))});
+    return;
   case (GateName::Tdg):
-    return {{1., 0.},
-            {0.0, 0.},
-            {0.0, 0.0},
-            std::exp(-im<Scalar> * static_cast<Scalar>(M_PI_4))};
+    matrix.assign({{1., 0.},
+                   {0.0, 0.},
+                   {0.0, 0.0},
+                   std::exp(-im<Scalar> * static_cast<Scalar>(M_PI_4))});
+    return;
   case (GateName::Rx): {
     auto angle = angles[0];
-    return {{std::cos(angle / two), 0.},
-            {0., -1 * std::sin(angle / two)},
-            {0, -1 * std::sin(angle / two)},
-            {std::cos(angle / two), 0.}};
+    matrix.assign({{std::cos(angle / two), 0.},
+                   {0., -1 * std::sin(angle / two)},
+                   {0, -1 * std::sin(angle / two)},
+                   {std::cos(angle / two), 0.}});
+    return;
   }
   case (GateName::Ry): {
     auto angle = angles[0];
-    return {std::cos(angle / two), -std::sin(angle / two),
-            std::sin(angle / two), std::cos(angle / two)};
+    matrix.assign({std::cos(angle / two), -std::sin(angle / two),
+                   std::sin(angle / two), std::cos(angle / two)});
+    return;
   }
   case (GateName::Rz): {
     auto angle = angles[0];
-    return {std::exp(-im<Scalar> * angle / two), 0, 0,
-            std::exp(im<Scalar> * angle / two)};
+    matrix.assign({std::exp(-im<Scalar> * angle / two), 0, 0,
+                   std::exp(im<Scalar> * angle / two)});
+    return;
   }
   case (GateName::R1):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, std::exp(im<Scalar> * angles[0])};
+    matrix.assign(
+        {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, std::exp(im<Scalar> * angles[0])});
+    return;
   case (GateName::U1):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, std::exp(im<Scalar> * angles[0])};
+    matrix.assign(
+        {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, std::exp(im<Scalar> * angles[0])});
+    return;
   case (GateName::U2): {
     Scalar oneOverSqrt2 = 1 / std::sqrt(2.);
     auto phi = angles[0];
     auto lambda = angles[1];
-    return {{oneOverSqrt2, 0.},
-            -oneOverSqrt2 * std::exp(lambda * nvqir::im<Scalar>),
-            oneOverSqrt2 * std::exp(nvqir::im<Scalar> * phi),
-            oneOverSqrt2 * std::exp(nvqir::im<Scalar> * (phi + lambda))};
+    matrix.assign({{oneOverSqrt2, 0.},
+                   -oneOverSqrt2 * std::exp(lambda * nvqir::im<Scalar>),
+                   oneOverSqrt2 * std::exp(nvqir::im<Scalar> * phi),
+                   oneOverSqrt2 *
+                       std::exp(nvqir::im<Scalar> * (phi + lambda))});
+    return;
   }
   case (GateName::U3): {
     auto theta = angles[0];
     auto phi = angles[1];
     auto lambda = angles[2];
-    return {{std::cos(theta / 2), 0.},
-            -std::exp(nvqir::im<Scalar> * lambda) * std::sin(theta / 2),
-            std::exp(nvqir::im<Scalar> * phi) * std::sin(theta / 2),
-            std::exp(nvqir::im<Scalar> * (phi + lambda)) * std::cos(theta / 2)};
+    matrix.assign({{std::cos(theta / 2), 0.},
+                   -std::exp(nvqir::im<Scalar> * lambda) * std::sin(theta / 2),
+                   std::exp(nvqir::im<Scalar> * phi) * std::sin(theta / 2),
+                   std::exp(nvqir::im<Scalar> * (phi + lambda)) *
+                       std::cos(theta / 2)});
+    return;
   }
   case (GateName::PhasedRx): {
     Scalar two = 2.;
     auto phi = angles[0];
     auto lambda = angles[1];
-    return {{std::cos(phi / two), 0.},
-            -nvqir::im<Scalar> * std::exp(-nvqir::im<Scalar> * lambda) *
-                std::complex<Scalar>{std::sin(phi / two), 0.},
-            -nvqir::im<Scalar> * std::exp(nvqir::im<Scalar> * lambda) *
-                std::sin(phi / two),
-            std::cos(phi / two)};
+    matrix.assign({{std::cos(phi / two), 0.},
+                   -nvqir::im<Scalar> * std::exp(-nvqir::im<Scalar> * lambda) *
+                       std::complex<Scalar>{std::sin(phi / two), 0.},
+                   -nvqir::im<Scalar> * std::exp(nvqir::im<Scalar> * lambda) *
+                       std::sin(phi / two),
+                   std::cos(phi / two)});
+    return;
   }
   case (GateName::Swap): {
     // The swap gate is a 4x4 matrix
-    return {1., 0., 0., 0., 0., 0., 1., 0., 0., 1., 0., 0., 0., 0., 0., 1.};
+    matrix.assign(
+        {1., 0., 0., 0., 0., 0., 1., 0., 0., 1., 0., 0., 0., 0., 0., 1.});
+    return;
   }
   case (GateName::Id):
-    return {{1., 0.}, {0., 0.}, {0., 0.}, {1., 0.}};
+    matrix.assign({{1., 0.}, {0., 0.}, {0., 0.}, {1., 0.}});
+    return;
+  case (GateName::Custom):
+    break;
   }
 
   throw std::runtime_error("Invalid gate provided to getGateByName.");
 }
 
+/// @brief Given the gate name (an element of the GateName enum),
+/// return the matrix data, optionally parameterized by a rotation angle.
+template <typename Scalar>
+std::vector<std::complex<Scalar>>
+getGateByName(GateName name, const std::vector<Scalar> angles = {}) {
+  std::vector<std::complex<Scalar>> matrix;
+  fillGateByName<Scalar>(name, angles, matrix);
+  return matrix;
+}
+
 /// @brief The X operation as a type. Can instantiate and request
 /// its matrix data.
 template <typename ScalarType = double>
 struct x {
+  static constexpr GateName opcode = GateName::X;
   auto getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::X);
   }
@@ -195,6 +247,7 @@ struct x {
 /// The Y Gate
 template <typename ScalarType = double>
 struct y {
+  static constexpr GateName opcode = GateName::Y;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::Y);
@@ -205,6 +258,7 @@ struct y {
 /// The Z Gate
 template <typename ScalarType = double>
 struct z {
+  static constexpr GateName opcode = GateName::Z;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::Z);
@@ -215,6 +269,7 @@ struct z {
 /// The Hadamard Gate
 template <typename ScalarType = double>
 struct h {
+  static constexpr GateName opcode = GateName::H;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::H);
@@ -225,6 +280,7 @@ struct h {
 /// The S Gate
 template <typename ScalarType = double>
 struct s {
+  static constexpr GateName opcode = GateName::S;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::S);
@@ -235,6 +291,7 @@ struct s {
 /// The T Gate
 template <typename ScalarType = double>
 struct t {
+  static constexpr GateName opcode = GateName::T;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::T);
@@ -245,6 +302,7 @@ struct t {
 /// The `Sdg` (S†) Gate
 template <typename ScalarType = double>
 struct sdg {
+  static constexpr GateName opcode = GateName::Sdg;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::Sdg);
@@ -255,6 +313,7 @@ struct sdg {
 /// The `Tdg` (T†) Gate
 template <typename ScalarType = double>
 struct tdg {
+  static constexpr GateName opcode = GateName::Tdg;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::Tdg);
@@ -265,6 +324,7 @@ struct tdg {
 /// The RX Rotation Gate
 template <typename ScalarType = double>
 struct rx {
+  static constexpr GateName opcode = GateName::Rx;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::Rx, {angles[0]});
   }
@@ -274,6 +334,7 @@ struct rx {
 /// The RY Rotation Gate
 template <typename ScalarType = double>
 struct ry {
+  static constexpr GateName opcode = GateName::Ry;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::Ry, {angles[0]});
   }
@@ -283,6 +344,7 @@ struct ry {
 /// The RZ Rotation Gate
 template <typename ScalarType = double>
 struct rz {
+  static constexpr GateName opcode = GateName::Rz;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::Rz, {angles[0]});
   }
@@ -292,6 +354,7 @@ struct rz {
 /// @brief The R1 operation as a type. Arbitrary rotation about |1>
 template <typename ScalarType = double>
 struct r1 {
+  static constexpr GateName opcode = GateName::R1;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::R1, {angles[0]});
   }
@@ -302,6 +365,7 @@ struct r1 {
 /// (IBMs version)
 template <typename ScalarType = double>
 struct u1 {
+  static constexpr GateName opcode = GateName::U1;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::U1, {angles[0]});
   }
@@ -310,6 +374,7 @@ struct u1 {
 
 template <typename ScalarType = double>
 struct u2 {
+  static constexpr GateName opcode = GateName::U2;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::U2, {angles[0], angles[1]});
   }
@@ -318,6 +383,7 @@ struct u2 {
 
 template <typename ScalarType = double>
 struct u3 {
+  static constexpr GateName opcode = GateName::U3;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::U3,
                                      {angles[0], angles[1], angles[2]});
@@ -327,6 +393,7 @@ struct u3 {
 
 template <typename ScalarType = double>
 struct phased_rx {
+  static constexpr GateName opcode = GateName::PhasedRx;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::PhasedRx,
                                      {angles[0], angles[1]});
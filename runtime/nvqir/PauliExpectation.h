@@ -0,0 +1,125 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Exact expectation values of Pauli strings on CPU state vectors and density
+/// matrices, computed from the bit masks of each string without building the
+/// operator matrix.
+///
+/// A Pauli string is `i^numY X^xMask Z^zMask`, with the Y positions set in
+/// both masks, so that `P|j> = i^numY (-1)^popcount(j & zMask) |j ^ xMask>`.
+/// Bit `b` of a mask refers to bit `b` of the amplitude index.
+namespace nvqir::kernels {
+
+/// @brief States smaller than this are reduced on the calling thread. When a
+/// sum has several terms, such states are instead distributed term by term.
+constexpr std::size_t ParallelExpectationThreshold = 1ULL << 14;
+
+/// @brief A Pauli string, encoded as bit masks.
+struct PauliMask {
+  std::size_t xMask = 0;
+  std::size_t zMask = 0;
+  std::size_t numY = 0;
+};
+
+/// @brief Return `i^numY`.
+inline std::complex<double> pauliPhase(std::size_t numY) {
+  static const std::complex<double> phases[4] = {
+      {1.0, 0.0}, {0.0, 1.0}, {-1.0, 0.0}, {0.0, -1.0}};
+  return phases[numY % 4];
+}
+
+/// @brief Return `<psi|P|psi>` for the state vector `sv` of dimension `dim`,
+/// without the coefficient of `P`.
+template <typename ScalarType>
+std::complex<double> pauliExpectation(const std::complex<ScalarType> *sv,
+                                      std::size_t dim, const PauliMask &p,
+                                      bool parallel) {
+  const std::size_t x = p.xMask, z = p.zMask;
+  double re = 0.0, im = 0.0;
+  const std::int64_t count = dim;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : re, im) if (parallel)
+#endif
+  for (std::int64_t i = 0; i < count; ++i) {
+    const std::size_t j = i;
+    // conj(psi[j ^ x]) * psi[j]
+    const double aRe = sv[j ^ x].real(), aIm = sv[j ^ x].imag();
+    const double bRe = sv[j].real(), bIm = sv[j].imag();
+    const double vRe = aRe * bRe + aIm * bIm;
+    const double vIm = aRe * bIm - aIm * bRe;
+    if (__builtin_parityll(j & z)) {
+      re -= vRe;
+      im -= vIm;
+    } else {
+      re += vRe;
+      im += vIm;
+    }
+  }
+  return pauliPhase(p.numY) * std::complex<double>(re, im);
+}
+
+/// @brief Return `Tr(P rho)` for the column-major density matrix `rho` of
+/// dimension `dim` x `dim`, without the coefficient of `P`. Only the `dim`
+/// entries `rho[j, j ^ xMask]` contribute.
+template <typename ScalarType>
+std::complex<double>
+pauliExpectationDensityMatrix(const std::complex<ScalarType> *rho,
+                              std::size_t dim, const PauliMask &p,
+                              bool parallel) {
+  const std::size_t x = p.xMask, z = p.zMask;
+  double re = 0.0, im = 0.0;
+  const std::int64_t count = dim;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : re, im) if (parallel)
+#endif
+  for (std::int64_t i = 0; i < count; ++i) {
+    const std::size_t j = i;
+    const std::complex<ScalarType> v = rho[j + (j ^ x) * dim];
+    if (__builtin_parityll(j & z)) {
+      re -= v.real();
+      im -= v.imag();
+    } else {
+      re += v.real();
+      im += v.imag();
+    }
+  }
+  return pauliPhase(p.numY) * std::complex<double>(re, im);
+}
+
+/// @brief Return the expectation value of each of the given Pauli strings.
+/// `data` is a state vector, or a column-major density matrix if
+/// `isDensityMatrix` is set.
+template <typename ScalarType>
+std::vector<std::complex<double>>
+pauliExpectations(const std::complex<ScalarType> *data, std::size_t dim,
+                  const std::vector<PauliMask> &terms, bool isDensityMatrix) {
+  std::vector<std::complex<double>> results(terms.size());
+  const bool parallelOverAmplitudes = dim >= ParallelExpectationThreshold;
+  const std::int64_t numTerms = terms.size();
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(dynamic)                                     \
+    if (!parallelOverAmplitudes && numTerms > 1)
+#endif
+  for (std::int64_t t = 0; t < numTerms; ++t) {
+    results[t] =
+        isDensityMatrix
+            ? pauliExpectationDensityMatrix(data, dim, terms[t],
+                                            parallelOverAmplitudes)
+            : pauliExpectation(data, dim, terms[t], parallelOverAmplitudes);
+  }
+  return results;
+}
+
+} // namespace nvqir::kernels
@@ -0,0 +1,311 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "common/Timing.h"
+#include "cudaq/runtime/logger/logger.h"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace nvqir {
+
+/// @brief The kind of work a profiled simulator interval was spent on.
+enum class ProfileCategory : std::uint8_t {
+  gate,
+  flush,
+  noise,
+  measure,
+  sample,
+  allocate
+};
+
+/// @brief Per-simulator performance counters, enabled with the
+/// `cudaq::TIMING_PROFILE` timing tag (`CUDAQ_TIMING_TAGS=12`).
+///
+/// Every profiled interval is accumulated into a timing histogram keyed on
+/// its category and name (e.g., the gate name), and the first
+/// `maxTraceEvents` intervals are also kept as trace events. The state memory
+/// high-water mark is tracked as a counter. When the profile is destroyed,
+/// a summary of the histograms is logged and the trace is written in the
+/// Chrome trace event format, which loads in `chrome://tracing` and Perfetto,
+/// to `<prefix>.<pid>.<lane>.json`. The prefix is read from
+/// `CUDAQ_PROFILE_FILE` (default `cudaq_profile`), and each simulator
+/// instance gets its own lane so that files of concurrent simulators can be
+/// told apart. When disabled, profiling costs a predictable branch per
+/// interval.
+class SimulatorProfile {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief Duration statistics of one category and name. Bucket `b` of the
+  /// histogram counts the intervals with a duration in `[2^(b-1), 2^b)` ns.
+  struct Histogram {
+    ProfileCategory category;
+    std::string name;
+    std::size_t count = 0;
+    std::uint64_t totalNs = 0;
+    std::uint64_t minNs = UINT64_MAX;
+    std::uint64_t maxNs = 0;
+    std::array<std::size_t, 64> buckets{};
+
+    /// @brief Return an upper bound of the given quantile (in [0, 1]) of the
+    /// durations, with the resolution of the histogram buckets.
+    std::uint64_t quantileNs(double q) const {
+      const auto rank = static_cast<std::size_t>(q * count);
+      std::size_t seen = 0;
+      for (std::size_t b = 0; b < buckets.size(); ++b) {
+        seen += buckets[b];
+        if (seen > rank)
+          return std::min<std::uint64_t>(maxNs,
+                                         b == 0 ? 0 : (1ULL << b) - 1);
+      }
+      return maxNs;
+    }
+  };
+
+  static constexpr std::size_t maxTraceEvents = 1 << 20;
+
+  bool enabled = false;
+  std::string name;
+
+  SimulatorProfile()
+      : enabled(cudaq::isTimingTagEnabled(cudaq::TIMING_PROFILE)),
+        lane(nextLane()) {}
+  SimulatorProfile(const SimulatorProfile &) = delete;
+  SimulatorProfile &operator=(const SimulatorProfile &) = delete;
+
+  ~SimulatorProfile() {
+    if (!enabled || histograms.empty())
+      return;
+    logSummary();
+    const char *prefix = std::getenv("CUDAQ_PROFILE_FILE");
+    const std::string fileName =
+        std::string(prefix && *prefix ? prefix : "cudaq_profile") + "." +
+        std::to_string(::getpid()) + "." + std::to_string(lane) + ".json";
+    std::ofstream out(fileName);
+    if (!out) {
+      CUDAQ_WARN("Could not write simulator profile to {}.", fileName);
+      return;
+    }
+    writeChromeTrace(out);
+    cudaq::log("CircuitSimulator '{}' profile written to {}", name, fileName);
+  }
+
+  /// @brief Record an interval of the given category and name.
+  void record(ProfileCategory category, std::string_view intervalName,
+              Clock::time_point start, Clock::time_point end) {
+    const auto durationNs = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count());
+    const auto id = histogramId(category, intervalName);
+    auto &histogram = histograms[id];
+    ++histogram.count;
+    histogram.totalNs += durationNs;
+    histogram.minNs = std::min(histogram.minNs, durationNs);
+    histogram.maxNs = std::max(histogram.maxNs, durationNs);
+    ++histogram.buckets[std::min<std::size_t>(std::bit_width(durationNs),
+                                              histogram.buckets.size() - 1)];
+    if (events.size() < maxTraceEvents)
+      events.push_back({id, sinceEpochNs(start), durationNs});
+    else
+      ++droppedEvents;
+  }
+
+  /// @brief Record the current size of the simulation state, in bytes.
+  void recordMemory(std::size_t bytes) {
+    if (bytes == currentBytes)
+      return;
+    currentBytes = bytes;
+    highWaterBytes = std::max(highWaterBytes, bytes);
+    if (memoryEvents.size() < maxTraceEvents)
+      memoryEvents.push_back({sinceEpochNs(Clock::now()), bytes});
+  }
+
+  /// @brief Return the histograms, in order of first occurrence.
+  const std::vector<Histogram> &getHistograms() const { return histograms; }
+
+  /// @brief Return the largest state size recorded, in bytes.
+  std::size_t getMemoryHighWaterMark() const { return highWaterBytes; }
+
+  /// @brief Write the recorded intervals and memory counter as a JSON trace
+  /// in the Chrome trace event format.
+  void writeChromeTrace(std::ostream &os) const {
+    const auto pid = ::getpid();
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+       << ",\"tid\":" << lane << ",\"args\":{\"name\":";
+    writeJsonString(os, name.empty() ? "simulator" : name);
+    os << "}}";
+    for (const auto &event : events) {
+      const auto &histogram = histograms[event.histogram];
+      os << ",\n{\"name\":";
+      writeJsonString(os, histogram.name);
+      os << ",\"cat\":\"" << categoryName(histogram.category)
+         << "\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << lane
+         << ",\"ts\":" << toMicroseconds(event.startNs)
+         << ",\"dur\":" << toMicroseconds(event.durationNs) << "}";
+    }
+    for (const auto &event : memoryEvents)
+      os << ",\n{\"name\":\"state memory\",\"ph\":\"C\",\"pid\":" << pid
+         << ",\"tid\":" << lane << ",\"ts\":" << toMicroseconds(event.timeNs)
+         << ",\"args\":{\"bytes\":" << event.bytes << "}}";
+    os << "],\"otherData\":{\"droppedEvents\":" << droppedEvents
+       << ",\"memoryHighWaterBytes\":" << highWaterBytes << "}}\n";
+  }
+
+  static constexpr const char *categoryName(ProfileCategory category) {
+    switch (category) {
+    case ProfileCategory::gate:
+      return "gate";
+    case ProfileCategory::flush:
+      return "flush";
+    case ProfileCategory::noise:
+      return "noise";
+    case ProfileCategory::measure:
+      return "measure";
+    case ProfileCategory::sample:
+      return "sample";
+    case ProfileCategory::allocate:
+      return "allocate";
+    }
+    return "unknown";
+  }
+
+private:
+  struct TraceEvent {
+    std::uint32_t histogram;
+    std::uint64_t startNs;
+    std::uint64_t durationNs;
+  };
+
+  struct MemoryEvent {
+    std::uint64_t timeNs;
+    std::size_t bytes;
+  };
+
+  /// @brief Transparent hash so that lookups by `std::string_view` do not
+  /// allocate.
+  struct NameHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const {
+      return std::hash<std::string_view>{}(s);
+    }
+  };
+
+  using NameMap =
+      std::unordered_map<std::string, std::uint32_t, NameHash, std::equal_to<>>;
+
+  std::uint32_t histogramId(ProfileCategory category,
+                            std::string_view intervalName) {
+    auto &ids = histogramIds[static_cast<std::size_t>(category)];
+    auto iter = ids.find(intervalName);
+    if (iter != ids.end())
+      return iter->second;
+    const auto id = static_cast<std::uint32_t>(histograms.size());
+    histograms.push_back({category, std::string(intervalName)});
+    ids.emplace(std::string(intervalName), id);
+    return id;
+  }
+
+  void logSummary() const {
+    cudaq::log("CircuitSimulator '{}' Profile [tag={}]:", name,
+               cudaq::TIMING_PROFILE);
+    for (const auto &h : histograms)
+      cudaq::log("{}:{} count = {}, total = {:.3f} ms, mean = {:.3f} us, "
+                 "min = {:.3f} us, p50 < {:.3f} us, p99 < {:.3f} us, "
+                 "max = {:.3f} us",
+                 categoryName(h.category), h.name, h.count, h.totalNs / 1e6,
+                 h.totalNs / 1e3 / h.count, h.minNs / 1e3,
+                 h.quantileNs(0.5) / 1e3, h.quantileNs(0.99) / 1e3,
+                 h.maxNs / 1e3);
+    cudaq::log("State memory high-water mark (MB) = {:.3f}",
+               highWaterBytes / 1e6);
+    if (droppedEvents)
+      cudaq::log("Trace events dropped = {}", droppedEvents);
+  }
+
+  static double toMicroseconds(std::uint64_t ns) { return ns / 1e3; }
+
+  /// @brief Nanoseconds since a process-wide epoch, so that traces of
+  /// different simulators line up.
+  static std::uint64_t sinceEpochNs(Clock::time_point t) {
+    static const Clock::time_point epoch = Clock::now();
+    return t < epoch ? 0
+                     : std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           t - epoch)
+                           .count();
+  }
+
+  static std::size_t nextLane() {
+    static std::atomic<std::size_t> lanes{0};
+    return lanes++;
+  }
+
+  static void writeJsonString(std::ostream &os, std::string_view s) {
+    static constexpr char hex[] = "0123456789abcdef";
+    os << '"';
+    for (char c : s) {
+      if (c == '"' || c == '\\')
+        os << '\\' << c;
+      else if (static_cast<unsigned char>(c) < 0x20)
+        os << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+      else
+        os << c;
+    }
+    os << '"';
+  }
+
+  std::size_t lane;
+  std::vector<Histogram> histograms;
+  std::array<NameMap, 6> histogramIds;
+  std::vector<TraceEvent> events;
+  std::vector<MemoryEvent> memoryEvents;
+  std::size_t droppedEvents = 0;
+  std::size_t currentBytes = 0;
+  std::size_t highWaterBytes = 0;
+};
+
+/// @brief Record the lifetime of this object as an interval of the profile,
+/// if the profile is enabled. The name must outlive the scope.
+class ProfileScope {
+public:
+  ProfileScope(SimulatorProfile &profile, ProfileCategory category,
+               std::string_view name)
+      : profile(profile.enabled ? &profile : nullptr), category(category),
+        name(name) {
+    if (this->profile)
+      start = SimulatorProfile::Clock::now();
+  }
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+  ~ProfileScope() {
+    if (profile)
+      profile->record(category, name, start, SimulatorProfile::Clock::now());
+  }
+
+private:
+  SimulatorProfile *profile;
+  ProfileCategory category;
+  std::string_view name;
+  SimulatorProfile::Clock::time_point start;
+};
+
+} // namespace nvqir
@@ -44,6 +44,7 @@ protected:
   using nvqir::CircuitSimulatorBase<ScalarType>::previousStateDimension;
   using nvqir::CircuitSimulatorBase<ScalarType>::shouldObserveFromSampling;
   using nvqir::CircuitSimulatorBase<ScalarType>::summaryData;
+  using nvqir::CircuitSimulatorBase<ScalarType>::profile;
 
   /// @brief The statevector that cuStateVec manipulates on the GPU
   void *deviceStateVector = nullptr;
@@ -404,6 +405,7 @@ public:
     // Populate the correct name so it is printed correctly during
     // deconstructor.
     summaryData.name = name();
+    profile.name = name();
 
     HANDLE_CUDA_ERROR(cudaFree(0));
     randomEngine = std::mt19937(randomDevice());
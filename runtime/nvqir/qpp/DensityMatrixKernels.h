@@ -0,0 +1,164 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "StateVectorKernels.h"
+#include <bit>
+
+/// In-place kernels for CPU density matrices.
+///
+/// A density matrix of dimension `dim` is stored column-major, so element
+/// (r, c) is at index `r + c * dim` and qubit `q` maps to bit `q` of both `r`
+/// and `c`. Viewed as a vector of dimension `dim * dim`, the row bits are the
+/// low half and the column bits the high half of the element index.
+///
+/// Superoperators are row-major matrices acting on the (row, column) pair of
+/// local indices of `k` qubits, with the row index as the most significant
+/// half: `S[(r * L + c) * L * L + (r' * L + c')]` for `L = 2^k`. A Kraus
+/// channel {K_i} has the superoperator sum_i K_i (x) conj(K_i).
+namespace nvqir::kernels {
+
+/// @brief Apply a (possibly controlled) unitary gate to the density matrix in
+/// place, `rho -> U rho U^dagger`, as two passes of the state vector kernels:
+/// `U` on the row bits, then `conj(U)` on the column bits.
+template <typename ScalarType>
+void applyGateToDensityMatrix(std::complex<ScalarType> *rho, std::size_t dim,
+                              const std::complex<ScalarType> *matrix,
+                              const std::vector<std::size_t> &controls,
+                              const std::vector<std::size_t> &targets) {
+  const std::size_t numQubits = std::countr_zero(dim);
+  applyGate(rho, dim * dim, matrix, controls, targets);
+
+  const std::size_t matrixSize = 1ULL << (2 * targets.size());
+  std::vector<std::complex<ScalarType>> conjugate(matrixSize);
+  for (std::size_t i = 0; i < matrixSize; ++i)
+    conjugate[i] = std::conj(matrix[i]);
+  std::vector<std::size_t> columnControls(controls), columnTargets(targets);
+  for (auto &c : columnControls)
+    c += numQubits;
+  for (auto &t : columnTargets)
+    t += numQubits;
+  applyGate(rho, dim * dim, conjugate.data(), columnControls, columnTargets);
+}
+
+/// @brief Add the superoperator `K (x) conj(K)` of the row-major
+/// `localDim x localDim` operator `K` to `superop`.
+template <typename ScalarType>
+void addToSuperoperator(std::vector<std::complex<ScalarType>> &superop,
+                        const std::complex<ScalarType> *op,
+                        std::size_t localDim) {
+  const std::size_t superDim = localDim * localDim;
+  superop.resize(superDim * superDim);
+  for (std::size_t r = 0; r < localDim; ++r)
+    for (std::size_t c = 0; c < localDim; ++c)
+      for (std::size_t rp = 0; rp < localDim; ++rp)
+        for (std::size_t cp = 0; cp < localDim; ++cp)
+          superop[(r * localDim + c) * superDim + (rp * localDim + cp)] +=
+              cmul(op[r * localDim + rp], std::conj(op[c * localDim + cp]));
+}
+
+/// @brief Return the row-major product `a * b` of two square matrices of
+/// dimension `n`.
+template <typename ScalarType>
+std::vector<std::complex<ScalarType>>
+multiplySquare(const std::vector<std::complex<ScalarType>> &a,
+               const std::vector<std::complex<ScalarType>> &b, std::size_t n) {
+  std::vector<std::complex<ScalarType>> product(n * n);
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t k = 0; k < n; ++k) {
+      const auto aik = a[i * n + k];
+      for (std::size_t j = 0; j < n; ++j)
+        product[i * n + j] += cmul(aik, b[k * n + j]);
+    }
+  return product;
+}
+
+/// @brief Return the full matrix of a gate on `numControls` controls followed
+/// by the targets of the row-major `matrix`, i.e. the identity except for the
+/// block where every control bit is set.
+template <typename ScalarType>
+std::vector<std::complex<ScalarType>>
+controlledGateMatrix(const std::complex<ScalarType> *matrix,
+                     std::size_t numControls, std::size_t numTargets) {
+  const std::size_t targetDim = 1ULL << numTargets;
+  const std::size_t dim = targetDim << numControls;
+  std::vector<std::complex<ScalarType>> full(dim * dim);
+  const std::size_t blockStart = dim - targetDim;
+  for (std::size_t i = 0; i < blockStart; ++i)
+    full[i * dim + i] = 1;
+  for (std::size_t r = 0; r < targetDim; ++r)
+    for (std::size_t c = 0; c < targetDim; ++c)
+      full[(blockStart + r) * dim + blockStart + c] = matrix[r * targetDim + c];
+  return full;
+}
+
+/// @brief Apply the superoperator on `qubits` to the Hermitian density matrix
+/// in place, in a single pass. Since the result is Hermitian as well, only the
+/// blocks on or above the diagonal are computed, and the blocks below are set
+/// to their conjugate transpose. Threads split the work by column block, and
+/// each column block only writes to itself and to the mirrored blocks of
+/// lower column blocks' rows, so no two threads touch the same element.
+template <typename ScalarType>
+void applySuperoperator(std::complex<ScalarType> *rho, std::size_t dim,
+                        const std::complex<ScalarType> *superop,
+                        const std::vector<std::size_t> &qubits) {
+  using ComplexType = std::complex<ScalarType>;
+  const GateLayout layout({}, qubits);
+  const std::size_t numTargets = qubits.size();
+  const std::size_t localDim = 1ULL << numTargets;
+  const std::size_t superDim = localDim * localDim;
+  std::vector<std::size_t> offsets(localDim, 0);
+  for (std::size_t r = 0; r < localDim; ++r)
+    for (std::size_t j = 0; j < numTargets; ++j)
+      if (r & (1ULL << (numTargets - 1 - j)))
+        offsets[r] |= (1ULL << qubits[j]);
+
+  const std::int64_t numBlocks = layout.numGroups(dim);
+#if defined(_OPENMP)
+#pragma omp parallel if (dim * dim >= ParallelDimensionThreshold)
+#endif
+  {
+    std::vector<ComplexType> in(superDim), out(superDim);
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic, 1)
+#endif
+    for (std::int64_t b = 0; b < numBlocks; ++b) {
+      const std::size_t colBase = layout.base(b);
+      for (std::int64_t a = 0; a <= b; ++a) {
+        const std::size_t rowBase = layout.base(a);
+        for (std::size_t j = 0; j < localDim; ++j) {
+          const ComplexType *column = rho + (colBase | offsets[j]) * dim;
+          for (std::size_t i = 0; i < localDim; ++i)
+            in[i * localDim + j] = column[rowBase | offsets[i]];
+        }
+        for (std::size_t s = 0; s < superDim; ++s) {
+          const ComplexType *row = superop + s * superDim;
+          ComplexType acc(0, 0);
+          for (std::size_t t = 0; t < superDim; ++t)
+            acc += cmul(row[t], in[t]);
+          out[s] = acc;
+        }
+        for (std::size_t j = 0; j < localDim; ++j) {
+          ComplexType *column = rho + (colBase | offsets[j]) * dim;
+          for (std::size_t i = 0; i < localDim; ++i)
+            column[rowBase | offsets[i]] = out[i * localDim + j];
+        }
+        if (a == b)
+          continue;
+        for (std::size_t i = 0; i < localDim; ++i) {
+          ComplexType *column = rho + (rowBase | offsets[i]) * dim;
+          for (std::size_t j = 0; j < localDim; ++j)
+            column[colBase | offsets[j]] = std::conj(out[i * localDim + j]);
+        }
+      }
+    }
+  }
+}
+
+} // namespace nvqir::kernels
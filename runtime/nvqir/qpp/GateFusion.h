@@ -0,0 +1,185 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "StateVectorKernels.h"
+#include <algorithm>
+
+namespace nvqir {
+
+/// @brief Greedy gate fusion for the CPU state-vector kernels.
+///
+/// Consecutive gates are accumulated into a dense block as long as the union
+/// of their qubits (controls included) has at most `maxQubits` elements. When
+/// the next gate does not fit, the block is applied to the state vector with a
+/// single pass and a new block is started. Blocks holding a single gate are
+/// applied with that gate's own (controlled, diagonal, ...) kernel. All
+/// buffers are reused between blocks, so steady-state fusion does not
+/// allocate.
+template <typename ScalarType>
+class GateFuser {
+public:
+  using ComplexType = std::complex<ScalarType>;
+
+  explicit GateFuser(std::size_t maxQubits) : maxQubits(maxQubits) {}
+
+  /// @brief Add a gate to the current block, first applying the block to `sv`
+  /// if the gate cannot be merged into it.
+  void push(ComplexType *sv, std::size_t dim,
+            const std::vector<ComplexType> &matrix,
+            const std::vector<std::size_t> &controls,
+            const std::vector<std::size_t> &targets) {
+    if (controls.size() + targets.size() > maxQubits) {
+      flush(sv, dim);
+      kernels::applyGate(sv, dim, matrix.data(), controls, targets);
+      return;
+    }
+
+    if (numGates == 0) {
+      firstMatrix.assign(matrix.begin(), matrix.end());
+      firstControls.assign(controls.begin(), controls.end());
+      firstTargets.assign(targets.begin(), targets.end());
+      qubits.assign(targets.begin(), targets.end());
+      qubits.insert(qubits.end(), controls.begin(), controls.end());
+      numGates = 1;
+      return;
+    }
+
+    std::size_t numNew = 0;
+    for (auto q : controls)
+      numNew += !contains(q);
+    for (auto q : targets)
+      numNew += !contains(q);
+    if (qubits.size() + numNew > maxQubits) {
+      flush(sv, dim);
+      push(sv, dim, matrix, controls, targets);
+      return;
+    }
+
+    if (numGates == 1) {
+      initializeBlock();
+      applyToBlock(firstMatrix, firstControls, firstTargets);
+    }
+    if (numNew > 0)
+      extendBlock(controls, targets);
+    applyToBlock(matrix, controls, targets);
+    ++numGates;
+  }
+
+  /// @brief Apply the pending block (if any) to `sv`.
+  void flush(ComplexType *sv, std::size_t dim) {
+    if (numGates == 1) {
+      kernels::applyGate(sv, dim, firstMatrix.data(), firstControls,
+                         firstTargets);
+    } else if (numGates > 1) {
+      // The block is stored column-major with local bit j standing for
+      // qubits[j]. The kernels want a row-major matrix with the most
+      // significant local bit first in the target list.
+      const std::size_t blockDim = 1ULL << qubits.size();
+      scratch.resize(blockDim * blockDim);
+      for (std::size_t c = 0; c < blockDim; ++c)
+        for (std::size_t r = 0; r < blockDim; ++r)
+          scratch[r * blockDim + c] = block[c * blockDim + r];
+      localTargets.assign(qubits.rbegin(), qubits.rend());
+      localControls.clear();
+      kernels::applyGate(sv, dim, scratch.data(), localControls, localTargets);
+    }
+    reset();
+  }
+
+  /// @brief Drop the pending block without applying it.
+  void reset() {
+    numGates = 0;
+    qubits.clear();
+  }
+
+private:
+  bool contains(std::size_t qubit) const {
+    return std::find(qubits.begin(), qubits.end(), qubit) != qubits.end();
+  }
+
+  std::size_t localIndex(std::size_t qubit) const {
+    return std::distance(qubits.begin(),
+                         std::find(qubits.begin(), qubits.end(), qubit));
+  }
+
+  /// @brief Start the block as the identity over the current qubits.
+  void initializeBlock() {
+    const std::size_t blockDim = 1ULL << qubits.size();
+    block.assign(blockDim * blockDim, ComplexType(0, 0));
+    for (std::size_t i = 0; i < blockDim; ++i)
+      block[i * blockDim + i] = ComplexType(1, 0);
+  }
+
+  /// @brief Add the gate's qubits that are not yet part of the block as new
+  /// most significant local bits, i.e. `block <- I (x) block`.
+  void extendBlock(const std::vector<std::size_t> &controls,
+                   const std::vector<std::size_t> &targets) {
+    const std::size_t oldDim = 1ULL << qubits.size();
+    for (auto q : targets)
+      if (!contains(q))
+        qubits.push_back(q);
+    for (auto q : controls)
+      if (!contains(q))
+        qubits.push_back(q);
+    const std::size_t newDim = 1ULL << qubits.size();
+    const std::size_t oldMask = oldDim - 1;
+
+    scratch.assign(newDim * newDim, ComplexType(0, 0));
+    for (std::size_t c = 0; c < newDim; ++c)
+      for (std::size_t r = 0; r < newDim; ++r)
+        if ((r & ~oldMask) == (c & ~oldMask))
+          scratch[c * newDim + r] =
+              block[(c & oldMask) * oldDim + (r & oldMask)];
+    block.swap(scratch);
+  }
+
+  /// @brief Left-multiply the block by the given gate, treating every column
+  /// of the block as a small state vector.
+  void applyToBlock(const std::vector<ComplexType> &matrix,
+                    const std::vector<std::size_t> &controls,
+                    const std::vector<std::size_t> &targets) {
+    localControls.clear();
+    for (auto q : controls)
+      localControls.push_back(localIndex(q));
+    localTargets.clear();
+    for (auto q : targets)
+      localTargets.push_back(localIndex(q));
+
+    const std::size_t blockDim = 1ULL << qubits.size();
+    for (std::size_t c = 0; c < blockDim; ++c)
+      kernels::applyGate(block.data() + c * blockDim, blockDim, matrix.data(),
+                         localControls, localTargets);
+  }
+
+  /// @brief Largest number of qubits a fused block may span.
+  std::size_t maxQubits;
+
+  /// @brief Number of gates accumulated in the current block.
+  std::size_t numGates = 0;
+
+  /// @brief Qubits spanned by the current block; local bit j is qubits[j].
+  std::vector<std::size_t> qubits;
+
+  /// @brief The first gate of the block, kept as is so that single-gate blocks
+  /// do not pay for a dense matrix.
+  std::vector<ComplexType> firstMatrix;
+  std::vector<std::size_t> firstControls;
+  std::vector<std::size_t> firstTargets;
+
+  /// @brief The fused block matrix (column-major), valid if numGates > 1.
+  std::vector<ComplexType> block;
+
+  /// Reusable scratch buffers.
+  std::vector<ComplexType> scratch;
+  std::vector<std::size_t> localControls;
+  std::vector<std::size_t> localTargets;
+};
+
+} // namespace nvqir
@@ -6,11 +6,17 @@
  * the terms of the Apache License 2.0 which accompanies this distribution.    *
  ******************************************************************************/
 
+#include "DensityMatrixKernels.h"
+#include "GateFusion.h"
+#include "StateBuffer.h"
+#include "StateVectorKernels.h"
 #include "common/FmtCore.h"
 #include "nvqir/CircuitSimulator.h"
 #include "nvqir/Gates.h"
 
 #include <bit>
+#include <cerrno>
+#include <cstdlib>
 #include <iostream>
 #include <qpp.h>
 #include <set>
@@ -129,8 +135,37 @@ struct QppState : public cudaq::SimulationState {
 template <typename StateType>
 class QppCircuitSimulator : public nvqir::CircuitSimulatorBase<double> {
 protected:
-  /// The QPP state representation (qpp::ket or qpp::cmat)
-  StateType state;
+  static constexpr bool isStateVector = std::is_same_v<StateType, qpp::ket>;
+
+  /// The QPP state representation. The state vector is a view of the first
+  /// `stateDimension` amplitudes of `stateBuffer`, the density matrix owns its
+  /// storage.
+  using StateStorage =
+      std::conditional_t<isStateVector, Eigen::Map<qpp::ket>, StateType>;
+  StateStorage state = emptyState();
+
+  /// @brief Pooled memory of the state vector, which is reused across kernel
+  /// launches. Unused for the density matrix.
+  StateBuffer stateBuffer;
+
+  /// @brief Environment variable that sets the maximum number of qubits a
+  /// fused gate block may span. Values below 2 disable gate fusion.
+  static constexpr const char fusionMaxQubitsEnvVar[] =
+      "CUDAQ_FUSION_MAX_QUBITS";
+
+  /// @brief Default maximum fused block size for the state-vector simulator.
+  static constexpr std::size_t defaultFusionMaxQubits = 2;
+
+  /// @brief Largest fused block size that can be requested. A fused block is a
+  /// dense 2^k x 2^k matrix, which quickly gets too large to be worth it.
+  static constexpr long maxFusionMaxQubits = 8;
+
+  /// @brief Gate fusion stage used when flushing the gate queue of the
+  /// state-vector simulator.
+  GateFuser<double> gateFuser{defaultFusionMaxQubits};
+
+  /// @brief Whether or not gate fusion is enabled.
+  bool fusionEnabled = true;
 
   /// @brief Convert internal qubit index to Q++ qubit index.
   ///
@@ -190,6 +225,64 @@ protected:
         const_cast<std::complex<double> *>(data.data()), nRows, nRows);
   }
 
+  static StateStorage emptyState() {
+    if constexpr (isStateVector)
+      return StateStorage(nullptr, 0);
+    else
+      return StateStorage();
+  }
+
+  /// @brief Point the state vector at the first `dim` amplitudes of the state
+  /// buffer.
+  void mapState(std::size_t dim) {
+    static_assert(isStateVector);
+    new (&state) StateStorage(stateBuffer.data<std::complex<double>>(), dim);
+  }
+
+  /// @brief Allocate a state vector of dimension `dim` from the buffer pool,
+  /// set to a copy of `data`, or to |0> if null.
+  void allocateStateVector(std::size_t dim, const std::complex<double> *data) {
+    constexpr std::size_t amplitudeBytes = sizeof(std::complex<double>);
+    stateBuffer = StateBufferPool::get().acquire(dim * amplitudeBytes);
+    mapState(dim);
+    if (data) {
+      std::copy_n(data, dim, state.data());
+      return;
+    }
+    stateBuffer.zero(0, dim * amplitudeBytes);
+    state(0) = 1.0;
+  }
+
+  /// @brief Grow the state vector in place to the Kronecker product of the
+  /// `factor`-dimensional `data` (|0> if null) with the current state. The new
+  /// qubits are the most significant bits, so the current state stays where
+  /// it is as the first block of the grown state.
+  void growStateVector(std::size_t factor, const std::complex<double> *data) {
+    constexpr std::size_t amplitudeBytes = sizeof(std::complex<double>);
+    const std::size_t oldDim = state.size();
+    const std::size_t newDim = oldDim * factor;
+    stateBuffer.reserve(newDim * amplitudeBytes, oldDim * amplitudeBytes);
+    mapState(newDim);
+    if (!data) {
+      stateBuffer.zero(oldDim * amplitudeBytes,
+                       (newDim - oldDim) * amplitudeBytes);
+      return;
+    }
+    // Fill the blocks from the top down, so that the current state in block 0
+    // is scaled last.
+    auto *sv = state.data();
+    for (std::size_t block = factor; block-- > 0;) {
+      const auto coefficient = data[block];
+      auto *out = sv + block * oldDim;
+      const std::int64_t count = oldDim;
+#if defined(_OPENMP)
+#pragma omp parallel for simd if (oldDim >= kernels::ParallelDimensionThreshold)
+#endif
+      for (std::int64_t i = 0; i < count; ++i)
+        out[i] = kernels::cmul(coefficient, sv[i]);
+    }
+  }
+
   /// @brief Grow the state vector by one qubit.
   void addQubitToState() override { addQubitsToState(1); }
 
@@ -203,6 +296,15 @@ protected:
     auto *stateData = reinterpret_cast<std::complex<double> *>(
         const_cast<void *>(stateDataIn));
 
+    // The state vector is allocated from the pool and grown in place.
+    if constexpr (isStateVector) {
+      if (state.size() == 0)
+        allocateStateVector(stateDimension, stateData);
+      else
+        growStateVector(1ULL << qubitCount, stateData);
+      return;
+    }
+
     if (state.size() == 0) {
       // If this is the first time, allocate the state
       if (stateData == nullptr) {
@@ -232,43 +334,118 @@ protected:
       throw std::invalid_argument(
           "[QppCircuitSimulator] Incompatible state input");
 
-    if (state.size() == 0)
+    const auto dim = static_cast<std::size_t>(casted->state.size());
+    if constexpr (isStateVector) {
+      if (state.size() == 0)
+        allocateStateVector(dim, casted->state.data());
+      else
+        growStateVector(dim, casted->state.data());
+    } else if (state.size() == 0)
       state = casted->state;
     else
       state = qpp::kron(casted->state, state);
   }
 
-  /// @brief Reset the qubit state.
+  /// @brief Reset the qubit state. The state vector memory goes back to the
+  /// pool, to be reused by the next allocation.
   void deallocateStateImpl() override {
-    StateType tmp;
-    state = tmp;
+    if constexpr (isStateVector) {
+      new (&state) StateStorage(nullptr, 0);
+      StateBufferPool::get().release(std::move(stateBuffer));
+    } else {
+      StateType tmp;
+      state = tmp;
+    }
   }
 
   void applyGate(const GateApplicationTask &task) override {
-    auto matrix = toQppMatrix(task.matrix, task.targets.size());
-    // First, convert all of the qubit indices to big endian.
-    std::vector<std::size_t> controls;
-    for (auto index : task.controls) {
-      controls.push_back(convertQubitIndex(index));
-    }
-    std::vector<std::size_t> targets;
-    for (auto index : task.targets) {
-      targets.push_back(convertQubitIndex(index));
+    // Update the state in place, qubit q is bit q of the state index (of both
+    // the row and the column index for a density matrix).
+    if constexpr (std::is_same_v<StateType, qpp::ket>)
+      kernels::applyGate(state.data(), static_cast<std::size_t>(state.size()),
+                         task.matrix.data(), task.controls, task.targets);
+    else
+      kernels::applyGateToDensityMatrix(
+          state.data(), static_cast<std::size_t>(state.rows()),
+          task.matrix.data(), task.controls, task.targets);
+  }
+
+  /// @brief Flush the gate queue. For the state vector simulator, runs of
+  /// queued gates are fused into small dense blocks before being applied.
+  /// Gate noise has to be applied after each individual gate, hence fusion is
+  /// skipped when a noise model is set. Fusion is also skipped while profiling,
+  /// so that each gate kind gets its own timings.
+  void flushGateQueueImpl() override {
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      auto executionContext = cudaq::getExecutionContext();
+      const bool hasNoise = executionContext && executionContext->noiseModel &&
+                            !executionContext->noiseModel->empty();
+      if (fusionEnabled && !hasNoise && !profile.enabled &&
+          gateQueue.size() > 1) {
+        flushFusedGateQueue();
+        return;
+      }
     }
+    nvqir::CircuitSimulatorBase<double>::flushGateQueueImpl();
+  }
 
-    if (controls.empty()) {
-      state = qpp::apply(state, matrix, targets);
-      return;
+  /// @brief Drain the gate queue through the gate fusion stage.
+  void flushFusedGateQueue() {
+    const auto dim = static_cast<std::size_t>(state.size());
+    ProfileScope flushScope(profile, ProfileCategory::flush, "fused flush");
+    try {
+      while (!gateQueue.empty()) {
+        auto &next = gateQueue.front();
+        if (summaryData.enabled)
+          summaryData.svGateUpdate(
+              next.controls.size(), next.targets.size(), stateDimension,
+              stateDimension * sizeof(std::complex<double>));
+        gateFuser.push(state.data(), dim, next.matrix, next.controls,
+                       next.targets);
+        gateQueue.pop();
+      }
+      gateFuser.flush(state.data(), dim);
+    } catch (std::exception &e) {
+      while (!gateQueue.empty())
+        gateQueue.pop();
+      gateFuser.reset();
+      throw std::runtime_error(std::string("Exception in applyGate: ") +
+                               e.what());
+    } catch (...) {
+      while (!gateQueue.empty())
+        gateQueue.pop();
+      gateFuser.reset();
+      throw std::runtime_error("Unknown exception in applyGate");
     }
-    state = qpp::applyCTRL(state, matrix, controls, targets);
   }
 
   /// @brief Set the current state back to the |0> state.
   void setToZeroState() override {
-    state = qpp::ket::Zero(stateDimension);
+    if constexpr (isStateVector) {
+      constexpr std::size_t amplitudeBytes = sizeof(std::complex<double>);
+      stateBuffer.reserve(stateDimension * amplitudeBytes, 0);
+      mapState(stateDimension);
+      stateBuffer.zero(0, stateDimension * amplitudeBytes);
+    } else {
+      state = qpp::ket::Zero(stateDimension);
+    }
     state(0) = 1.0;
   }
 
+  bool checkpointState(
+      std::vector<std::complex<double>> &checkpoint) override {
+    flushGateQueue();
+    checkpoint.assign(state.data(), state.data() + state.size());
+    return true;
+  }
+
+  void restoreState(
+      const std::vector<std::complex<double>> &checkpoint) override {
+    assert(checkpoint.size() == static_cast<std::size_t>(state.size()) &&
+           "Checkpoint does not match the number of qubits");
+    std::copy(checkpoint.begin(), checkpoint.end(), state.data());
+  }
+
   /// @brief Measure the qubit and return the result. Collapse the
   /// state vector.
   bool measureQubit(const std::size_t index) override {
@@ -294,11 +471,33 @@ protected:
 
   QubitOrdering getQubitOrdering() const override { return QubitOrdering::msb; }
 
+  std::size_t getStateMemoryBytes() const override {
+    return state.size() * sizeof(std::complex<double>);
+  }
+
 public:
   QppCircuitSimulator() {
     // Populate the correct name so it is printed correctly during
     // deconstructor.
     summaryData.name = name();
+    profile.name = name();
+
+    if (auto *fusionEnvVar = std::getenv(fusionMaxQubitsEnvVar)) {
+      const std::string fusionStr(fusionEnvVar);
+      const char *nptr = fusionStr.data();
+      char *endptr = nullptr;
+      errno = 0; // reset errno to 0 before call
+      const auto maxQubits = strtol(nptr, &endptr, 10);
+      if (nptr == endptr || errno != 0 || maxQubits < 0 ||
+          maxQubits > maxFusionMaxQubits)
+        throw std::runtime_error(
+            fmt::format("Invalid {} setting. Expected an integer between 0 "
+                        "and {}. Got: {}",
+                        fusionMaxQubitsEnvVar, maxFusionMaxQubits, fusionStr));
+      fusionEnabled = maxQubits > 1;
+      gateFuser = GateFuser<double>(maxQubits);
+      CUDAQ_INFO("Setting max gate fusion size to {}.", maxQubits);
+    }
   }
   virtual ~QppCircuitSimulator() = default;
 
@@ -322,25 +521,10 @@ public:
     assert(cudaq::spin_op::canonicalize(op) == op);
     flushGateQueue();
 
-    // The op is on the following target bits.
-    auto targets = op.degrees();
-
-    // Get the matrix as an Eigen matrix
-    auto matrix = op.to_matrix();
-    qpp::cmat asEigen = matrix.as_eigen();
-
-    // Compute the expected value
-    double ee = 0.0;
-    if constexpr (std::is_same_v<StateType, qpp::ket>) {
-      qpp::ket k = qpp::apply(state, asEigen, targets, 2);
-      ee = state.dot(k).real();
-    } else {
-      ee = qpp::apply(asEigen, state, targets).trace().real();
-    }
-
-    return cudaq::observe_result(
-        ee, op,
-        cudaq::sample_result(cudaq::ExecutionResult({}, op.to_string(), ee)));
+    // Evaluate each Pauli term directly on the amplitudes (or the density
+    // matrix), rather than applying the dense matrix of the whole operator.
+    return observeFromAmplitudes(op, state.data(),
+                                 !std::is_same_v<StateType, qpp::ket>);
   }
 
   /// @brief Reset the qubit
@@ -368,43 +552,45 @@ public:
     }
 
     auto sampleResult = qpp::sample(shots, state, measuredBits, 2);
-    // Convert to what we expect
-    std::stringstream bitstream;
-    cudaq::ExecutionResult counts;
+    // Convert to what we expect, keeping the bit strings packed.
+    cudaq::PackedCounts counts(qubits.size());
+    cudaq::PackedBitStrings sequentialData(qubits.size());
+    if (includeSequentialData)
+      sequentialData.reserve(shots);
+    std::vector<std::uint64_t> record(counts.numWords());
 
     // Expectation value from the counts
     double expVal = 0.0;
-    for (auto [result, count] : sampleResult) {
-      // Push back each term in the vector of bits to the bitstring.
-      for (const auto &bit : result) {
-        bitstream << bit;
-      }
+    for (auto &[result, count] : sampleResult) {
+      std::fill(record.begin(), record.end(), 0);
+      for (std::size_t k = 0; k < result.size(); ++k)
+        if (result[k])
+          cudaq::PackedBitStrings::setBit(record.data(), k);
 
       // Add to the sample result
       // in mid-circ sampling mode this will append 1 bitstring
-      auto bitstring = bitstream.str();
+      counts.add(record.data(), count);
       if (includeSequentialData)
-        counts.appendResult(bitstring, count);
-      else
-        counts.counts[bitstring] += count;
-      auto par = cudaq::sample_result::has_even_parity(bitstring);
+        sequentialData.push_back(record.data(), count);
       auto p = count / (double)shots;
-      if (!par) {
+      if (!cudaq::PackedBitStrings::hasEvenParity(record.data(),
+                                                  record.size()))
         p = -p;
-      }
       expVal += p;
-      // Reset the state.
-      bitstream.str("");
-      bitstream.clear();
     }
 
-    counts.expectationValue = expVal;
-    return counts;
+    cudaq::ExecutionResult executionResult(std::move(counts),
+                                           std::move(sequentialData));
+    executionResult.expectationValue = expVal;
+    return executionResult;
   }
 
   std::unique_ptr<cudaq::SimulationState> getSimulationState() override {
     flushGateQueue();
-    return std::make_unique<QppState>(std::move(state));
+    if constexpr (isStateVector)
+      return std::make_unique<QppState>(qpp::ket(state));
+    else
+      return std::make_unique<QppState>(std::move(state));
   }
 
   std::unique_ptr<cudaq::SimulationState>
@@ -165,6 +165,192 @@ struct QppDmState : public cudaq::SimulationState {
 class QppNoiseCircuitSimulator : public nvqir::QppCircuitSimulator<qpp::cmat> {
 
 protected:
+  /// @brief Row-major superoperator acting on the density matrix elements of
+  /// a few qubits, see DensityMatrixKernels.h.
+  using Superoperator = std::vector<std::complex<double>>;
+
+  /// @brief Gates with noise on at most this many qubits (controls and
+  /// targets) are applied together with their noise as one superoperator.
+  /// Beyond that, the 16^n superoperator costs more than applying the gate on
+  /// its own.
+  static constexpr std::size_t maxFusedQubits = 2;
+
+  /// @brief Bound on the number of cached channel superoperators.
+  static constexpr std::size_t maxCachedSuperoperators = 1024;
+
+  /// @brief Superoperators of the channel lists resolved by the noise model,
+  /// keyed on the address of the (shared, immutable) list. Each entry holds on
+  /// to its list so that the address can not be reused while cached.
+  std::unordered_map<const std::vector<cudaq::kraus_channel> *,
+                     std::pair<cudaq::noise_model::channel_list, Superoperator>>
+      channelSuperoperators;
+
+  /// @brief Key of a gate folded into a channel superoperator: the channel
+  /// superoperator (an entry of `channelSuperoperators`), the number of
+  /// controls and the gate matrix.
+  struct FusedGateKey {
+    const Superoperator *channelSuperop;
+    std::size_t numControls;
+    std::vector<std::complex<double>> matrix;
+    bool operator==(const FusedGateKey &) const = default;
+  };
+
+  struct FusedGateKeyHash {
+    std::size_t operator()(const FusedGateKey &key) const {
+      std::size_t seed = std::hash<const void *>{}(key.channelSuperop);
+      auto combine = [&seed](std::size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+      };
+      combine(key.numControls);
+      for (const auto &element : key.matrix) {
+        combine(std::hash<double>{}(element.real()));
+        combine(std::hash<double>{}(element.imag()));
+      }
+      return seed;
+    }
+  };
+
+  /// @brief Superoperators of gates followed by their noise channels, so that
+  /// repeated noisy gates do not rebuild them. Cleared together with
+  /// `channelSuperoperators`, whose entries they refer to.
+  std::unordered_map<FusedGateKey, Superoperator, FusedGateKeyHash>
+      fusedSuperoperators;
+
+  /// @brief Return the superoperator of the Kraus channels applied in order,
+  /// or an empty superoperator if none of the channels has any operator.
+  static Superoperator
+  toSuperoperator(const std::vector<cudaq::kraus_channel> &channels) {
+    Superoperator result;
+    for (auto &channel : channels) {
+      if (channel.empty())
+        continue;
+      Superoperator channelSuperop;
+      // Note: Kraus channel flattened matrix data is **row-major**.
+      for (auto &op : channel.get_ops()) {
+        std::vector<std::complex<double>> data(op.data.begin(), op.data.end());
+        nvqir::kernels::addToSuperoperator(channelSuperop, data.data(),
+                                           op.nRows);
+      }
+      const std::size_t superDim = channel.dimension() * channel.dimension();
+      result = result.empty() ? std::move(channelSuperop)
+                              : nvqir::kernels::multiplySquare(
+                                    channelSuperop, result, superDim);
+    }
+    return result;
+  }
+
+  /// @brief Return the superoperator of the noise model channels for the
+  /// given gate, or nullptr if there is no noise to apply.
+  const Superoperator *
+  getChannelSuperoperator(const cudaq::noise_model &noiseModel,
+                          const std::string_view gateName,
+                          const std::vector<std::size_t> &controls,
+                          const std::vector<std::size_t> &targets,
+                          const std::vector<double> &params) {
+    auto krausChannels =
+        noiseModel.get_channels_cached(gateName, targets, controls, params);
+    if (krausChannels->empty())
+      return nullptr;
+
+    auto iter = channelSuperoperators.find(krausChannels.get());
+    if (iter == channelSuperoperators.end()) {
+      if (channelSuperoperators.size() >= maxCachedSuperoperators) {
+        fusedSuperoperators.clear();
+        channelSuperoperators.clear();
+      }
+      auto superop = toSuperoperator(*krausChannels);
+      iter = channelSuperoperators
+                 .emplace(krausChannels.get(),
+                          std::make_pair(krausChannels, std::move(superop)))
+                 .first;
+    }
+    return iter->second.second.empty() ? nullptr : &iter->second.second;
+  }
+
+  /// @brief Apply the superoperator on the given qubits to the state.
+  void applySuperoperator(const Superoperator &superop,
+                          const std::vector<std::size_t> &qubits) {
+    nvqir::kernels::applySuperoperator(state.data(),
+                                       static_cast<std::size_t>(state.rows()),
+                                       superop.data(), qubits);
+  }
+
+  /// @brief Apply a gate followed by its noise channels. For gates on few
+  /// qubits, the gate superoperator is folded into the channel superoperator
+  /// (once per gate matrix and channel) so that the density matrix is updated
+  /// in a single pass.
+  void applyGateWithNoise(const GateApplicationTask &task,
+                          const Superoperator &channelSuperop) {
+    std::vector<std::size_t> qubits{task.controls.begin(),
+                                    task.controls.end()};
+    qubits.insert(qubits.end(), task.targets.begin(), task.targets.end());
+    if (qubits.size() > maxFusedQubits) {
+      applyGate(task);
+      applySuperoperator(channelSuperop, qubits);
+      return;
+    }
+
+    FusedGateKey key{&channelSuperop, task.controls.size(), task.matrix};
+    auto iter = fusedSuperoperators.find(key);
+    if (iter == fusedSuperoperators.end()) {
+      if (fusedSuperoperators.size() >= maxCachedSuperoperators)
+        fusedSuperoperators.clear();
+      const auto gateMatrix = nvqir::kernels::controlledGateMatrix(
+          task.matrix.data(), task.controls.size(), task.targets.size());
+      Superoperator gateSuperop;
+      nvqir::kernels::addToSuperoperator(gateSuperop, gateMatrix.data(),
+                                         1ULL << qubits.size());
+      iter = fusedSuperoperators
+                 .emplace(std::move(key),
+                          nvqir::kernels::multiplySquare(
+                              channelSuperop, gateSuperop,
+                              1ULL << (2 * qubits.size())))
+                 .first;
+    }
+    applySuperoperator(iter->second, qubits);
+  }
+
+  /// @brief Flush the gate queue, applying each gate together with the noise
+  /// model channels for it.
+  void flushGateQueueImpl() override {
+    auto executionContext = cudaq::getExecutionContext();
+    const cudaq::noise_model *noiseModel =
+        executionContext && executionContext->noiseModel &&
+                !executionContext->noiseModel->empty()
+            ? executionContext->noiseModel
+            : nullptr;
+
+    nvqir::ProfileScope flushScope(profile, nvqir::ProfileCategory::flush,
+                                   "flush");
+    try {
+      while (!gateQueue.empty()) {
+        auto &next = gateQueue.front();
+        {
+          nvqir::ProfileScope gateScope(profile, nvqir::ProfileCategory::gate,
+                                        next.operationName);
+          const Superoperator *channelSuperop =
+              noiseModel ? getChannelSuperoperator(*noiseModel,
+                                                   next.operationName,
+                                                   next.controls, next.targets,
+                                                   next.parameters)
+                         : nullptr;
+          if (channelSuperop)
+            applyGateWithNoise(next, *channelSuperop);
+          else
+            applyGate(next);
+        }
+        gateQueue.pop();
+      }
+    } catch (std::exception &e) {
+      gateQueue.clear();
+      throw std::runtime_error(std::string("Exception in applyGate: ") +
+                               e.what());
+    } catch (...) {
+      gateQueue.clear();
+      throw std::runtime_error("Unknown exception in applyGate");
+    }
+  }
+
   /// @brief If we have a noise model, apply any user-specified
   /// kraus_channels for the given gate name on the provided qubits.
   /// @param gateName
@@ -183,43 +369,20 @@ protected:
     if (!executionContext->noiseModel)
       return;
 
-    // Get the name as a string
-    std::string gName(gateName);
-    std::vector<std::size_t> qubits{controls.begin(), controls.end()};
-    qubits.insert(qubits.end(), targets.begin(), targets.end());
-    std::vector<std::size_t> casted_qubits;
-    for (auto index : qubits) {
-      casted_qubits.push_back(convertQubitIndex(index));
-    }
-
-    // Get the Kraus channels specified for this gate and qubits
-    auto krausChannels = executionContext->noiseModel->get_channels(
-        gName, targets, controls, params);
+    // Get the superoperator of the Kraus channels for this gate and qubits
+    const auto *superop = getChannelSuperoperator(
+        *executionContext->noiseModel, gateName, controls, targets, params);
 
     // If none, do nothing
-    if (krausChannels.empty())
+    if (!superop)
       return;
 
-    CUDAQ_INFO("Applying {} kraus channels to qubits {}", krausChannels.size(),
-               qubits);
-
-    for (auto &channel : krausChannels) {
-      // Map our kraus ops to the qpp::cmat
-      std::vector<qpp::cmat> K;
-      auto ops = channel.get_ops();
-      std::transform(ops.begin(), ops.end(), std::back_inserter(K),
-                     [&](auto &el) {
-                       // Note: Kraus channel flattened matrix data is
-                       // **row-major**.
-                       return Eigen::Map<
-                           Eigen::Matrix<std::complex<double>, Eigen::Dynamic,
-                                         Eigen::Dynamic, Eigen::RowMajor>>(
-                           el.data.data(), el.nRows, el.nCols);
-                     });
-
-      // Apply K rho Kdag
-      state = qpp::apply(state, K, casted_qubits);
-    }
+    std::vector<std::size_t> qubits{controls.begin(), controls.end()};
+    qubits.insert(qubits.end(), targets.begin(), targets.end());
+    CUDAQ_INFO("Applying kraus channels to qubits {}", qubits);
+
+    // Apply sum_k K rho Kdag
+    applySuperoperator(*superop, qubits);
   }
 
   /// @brief This simulator supports all noise channels
@@ -232,24 +395,15 @@ protected:
                   const std::vector<std::size_t> &qubits) override {
     flushGateQueue();
     CUDAQ_INFO("[qpp-dm] apply kraus channel {}", channel.get_type_name());
-    std::vector<std::size_t> casted_qubits;
-    for (auto index : qubits) {
-      casted_qubits.push_back(convertQubitIndex(index));
-    }
-    // Map our kraus ops to the qpp::cmat
-    std::vector<qpp::cmat> K;
-    auto ops = channel.get_ops();
-    std::transform(
-        ops.begin(), ops.end(), std::back_inserter(K), [&](auto &el) {
-          // Note: Kraus channel flattened matrix data is
-          // **row-major**.
-          return Eigen::Map<Eigen::Matrix<std::complex<double>, Eigen::Dynamic,
-                                          Eigen::Dynamic, Eigen::RowMajor>>(
-              el.data.data(), el.nRows, el.nCols);
-        });
-
-    // Apply K rho Kdag
-    state = qpp::apply(state, K, casted_qubits);
+    const auto superop = toSuperoperator({channel});
+    if (superop.empty())
+      return;
+    if (channel.dimension() != (1ULL << qubits.size()))
+      throw std::runtime_error(
+          "[qpp-dm] kraus channel dimension does not match the qubits.");
+
+    // Apply sum_k K rho Kdag
+    applySuperoperator(superop, qubits);
   }
 
   /// @brief Grow the density matrix by one qubit.
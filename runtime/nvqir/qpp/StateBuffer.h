@@ -0,0 +1,247 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <utility>
+#include <vector>
+
+/// Pooled storage for CPU simulation states.
+///
+/// Launching a kernel on a CPU simulator used to allocate its state from
+/// scratch and free it at the end, so that every launch page-faulted a fresh
+/// buffer of the full state size. State buffers are instead anonymous
+/// memory mappings that are handed back to a process-wide pool when a state is
+/// deallocated, and reused (reset by zeroing) by the next launch.
+///
+/// The behavior is controlled with the following environment variables:
+/// - `CUDAQ_STATE_POOL_MAX_MB`: the total size of the idle buffers the pool
+///   retains (default 4096). Set to 0 to release state memory after every
+///   launch.
+/// - `CUDAQ_STATE_HUGE_PAGES`: whether to request transparent huge pages for
+///   large buffers (default 1).
+/// - `CUDAQ_STATE_NUMA_FIRST_TOUCH`: whether new pages are first written by
+///   the OpenMP threads that later update them, in the static schedule of the
+///   gate kernels, so that each page is placed on the NUMA node of its thread
+///   (default 1). Otherwise, new pages are zeroed by the calling thread.
+namespace nvqir {
+
+/// @brief Settings of the state buffer pool, read once from the environment.
+struct StateBufferSettings {
+  std::size_t maxPooledBytes = std::size_t{4096} << 20;
+  bool hugePages = true;
+  bool numaFirstTouch = true;
+
+  static const StateBufferSettings &get() {
+    static const StateBufferSettings settings = [] {
+      StateBufferSettings s;
+      s.maxPooledBytes = readUnsigned("CUDAQ_STATE_POOL_MAX_MB",
+                                      s.maxPooledBytes >> 20)
+                         << 20;
+      s.hugePages = readUnsigned("CUDAQ_STATE_HUGE_PAGES", 1) != 0;
+      s.numaFirstTouch = readUnsigned("CUDAQ_STATE_NUMA_FIRST_TOUCH", 1) != 0;
+      return s;
+    }();
+    return settings;
+  }
+
+private:
+  static std::size_t readUnsigned(const char *envVar, std::size_t fallback) {
+    const char *value = std::getenv(envVar);
+    if (!value || !*value)
+      return fallback;
+    char *end = nullptr;
+    errno = 0;
+    const auto parsed = std::strtoull(value, &end, 10);
+    if (end == value || *end != '\0' || errno != 0 || *value == '-')
+      throw std::runtime_error(std::string("Invalid ") + envVar +
+                               " setting. Expected a non-negative integer. "
+                               "Got: " +
+                               value);
+    return parsed;
+  }
+};
+
+/// @brief A page-aligned buffer backed by an anonymous memory mapping. Pages
+/// are only committed when first written.
+class StateBuffer {
+public:
+  StateBuffer() = default;
+  StateBuffer(StateBuffer &&other) noexcept
+      : ptr(std::exchange(other.ptr, nullptr)),
+        bytes(std::exchange(other.bytes, 0)) {}
+  StateBuffer &operator=(StateBuffer &&other) noexcept {
+    if (this != &other) {
+      unmap();
+      ptr = std::exchange(other.ptr, nullptr);
+      bytes = std::exchange(other.bytes, 0);
+    }
+    return *this;
+  }
+  StateBuffer(const StateBuffer &) = delete;
+  StateBuffer &operator=(const StateBuffer &) = delete;
+  ~StateBuffer() { unmap(); }
+
+  template <typename T = void>
+  T *data() const {
+    return static_cast<T *>(ptr);
+  }
+  std::size_t capacity() const { return bytes; }
+
+  /// @brief Make sure the buffer holds at least `size` bytes. The first
+  /// `preserve` bytes are kept; the contents of the rest are unspecified.
+  void reserve(std::size_t size, std::size_t preserve) {
+    if (size <= bytes)
+      return;
+#if defined(__linux__)
+    // Move the page mappings rather than copying the contents.
+    if (ptr) {
+      void *grown = ::mremap(ptr, bytes, size, MREMAP_MAYMOVE);
+      if (grown == MAP_FAILED)
+        throwAllocationError(size);
+      ptr = grown;
+      bytes = size;
+      adviseHugePages();
+      return;
+    }
+#endif
+    void *fresh =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (fresh == MAP_FAILED)
+      throwAllocationError(size);
+    if (ptr && preserve) {
+      firstTouch(fresh, 0, std::min(preserve, bytes));
+      std::memcpy(fresh, ptr, std::min(preserve, bytes));
+    }
+    unmap();
+    ptr = fresh;
+    bytes = size;
+    adviseHugePages();
+  }
+
+  /// @brief Zero `count` bytes from `offset`, splitting the work over OpenMP
+  /// threads in the static schedule used by the gate kernels, if enabled.
+  void zero(std::size_t offset, std::size_t count) {
+    firstTouch(ptr, offset, count);
+  }
+
+private:
+  /// @brief Buffers below this size are zeroed on the calling thread.
+  static constexpr std::size_t parallelZeroBytes = std::size_t{1} << 20;
+
+  /// @brief Transparent huge pages are only requested above this size.
+  static constexpr std::size_t hugePageBytes = std::size_t{2} << 20;
+
+  static void firstTouch(void *base, std::size_t offset, std::size_t count) {
+    auto *begin = static_cast<std::uint8_t *>(base) + offset;
+#if defined(_OPENMP)
+    if (count >= parallelZeroBytes &&
+        StateBufferSettings::get().numaFirstTouch) {
+      constexpr std::size_t blockBytes = std::size_t{64} << 10;
+      const std::int64_t numBlocks = (count + blockBytes - 1) / blockBytes;
+#pragma omp parallel for schedule(static)
+      for (std::int64_t b = 0; b < numBlocks; ++b) {
+        const std::size_t start = b * blockBytes;
+        std::memset(begin + start, 0, std::min(blockBytes, count - start));
+      }
+      return;
+    }
+#endif
+    std::memset(begin, 0, count);
+  }
+
+  void adviseHugePages() {
+#if defined(MADV_HUGEPAGE)
+    if (bytes >= hugePageBytes && StateBufferSettings::get().hugePages)
+      ::madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+  }
+
+  [[noreturn]] static void throwAllocationError(std::size_t size) {
+    throw std::runtime_error("Failed to allocate " + std::to_string(size) +
+                             " bytes of simulation state memory: " +
+                             std::strerror(errno));
+  }
+
+  void unmap() {
+    if (ptr)
+      ::munmap(ptr, bytes);
+    ptr = nullptr;
+    bytes = 0;
+  }
+
+  void *ptr = nullptr;
+  std::size_t bytes = 0;
+};
+
+/// @brief Process-wide pool of idle state buffers, shared by the simulator
+/// instances of all threads.
+class StateBufferPool {
+public:
+  static StateBufferPool &get() {
+    static StateBufferPool pool;
+    return pool;
+  }
+
+  /// @brief Return a buffer of at least `size` bytes. The smallest idle
+  /// buffer that fits is reused; otherwise the largest idle buffer is grown.
+  StateBuffer acquire(std::size_t size) {
+    StateBuffer buffer;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!idle.empty()) {
+        auto best = idle.end();
+        for (auto iter = idle.begin(); iter != idle.end(); ++iter)
+          if (iter->capacity() >= size &&
+              (best == idle.end() || iter->capacity() < best->capacity()))
+            best = iter;
+        if (best == idle.end())
+          best = std::max_element(idle.begin(), idle.end(),
+                                  [](const auto &a, const auto &b) {
+                                    return a.capacity() < b.capacity();
+                                  });
+        idleBytes -= best->capacity();
+        buffer = std::move(*best);
+        idle.erase(best);
+      }
+    }
+    buffer.reserve(size, 0);
+    return buffer;
+  }
+
+  /// @brief Return a buffer to the pool. It is unmapped if the pool would
+  /// exceed its size limit.
+  void release(StateBuffer &&buffer) {
+    if (buffer.capacity() == 0)
+      return;
+    StateBuffer discarded = std::move(buffer);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (idleBytes + discarded.capacity() >
+        StateBufferSettings::get().maxPooledBytes)
+      return;
+    idleBytes += discarded.capacity();
+    idle.push_back(std::move(discarded));
+  }
+
+private:
+  std::mutex mutex;
+  std::vector<StateBuffer> idle;
+  std::size_t idleBytes = 0;
+};
+
+} // namespace nvqir
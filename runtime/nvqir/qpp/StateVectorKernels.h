@@ -0,0 +1,243 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// In-place gate application kernels for CPU state vectors.
+///
+/// Qubit `q` of the simulator maps to bit `q` of the amplitude index. Gate
+/// matrices are row-major and, as for `GateApplicationTask`, `targets[0]` is
+/// the most significant bit of the local (matrix) index.
+namespace nvqir::kernels {
+
+/// @brief State vectors smaller than this are updated on the calling thread,
+/// since forking an OpenMP team costs more than the update itself.
+constexpr std::size_t ParallelDimensionThreshold = 1ULL << 14;
+
+/// @brief Complex multiply on the real and imaginary parts. Unlike
+/// `operator*` on `std::complex`, this does not emit the Annex G NaN recovery
+/// branch, which otherwise keeps the amplitude loops from vectorizing.
+template <typename ScalarType>
+inline std::complex<ScalarType> cmul(const std::complex<ScalarType> &a,
+                                     const std::complex<ScalarType> &b) {
+  return {a.real() * b.real() - a.imag() * b.imag(),
+          a.real() * b.imag() + a.imag() * b.real()};
+}
+
+/// @brief Expand `idx` by inserting a zero bit at each of the given (ascending)
+/// bit positions.
+inline std::size_t insertZeroBits(std::size_t idx,
+                                  const std::size_t *sortedPositions,
+                                  std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::size_t low = (1ULL << sortedPositions[i]) - 1;
+    idx = ((idx & ~low) << 1) | (idx & low);
+  }
+  return idx;
+}
+
+/// @brief The bit positions touched by a gate (controls and targets) and the
+/// mask of its control bits. Used to enumerate the base index of every
+/// amplitude group the gate mixes, with all control bits set.
+struct GateLayout {
+  std::array<std::size_t, 64> sortedPositions;
+  std::size_t numPositions = 0;
+  std::size_t controlMask = 0;
+
+  GateLayout(const std::vector<std::size_t> &controls,
+             const std::vector<std::size_t> &targets) {
+    assert(controls.size() + targets.size() <= 64);
+    for (auto c : controls) {
+      controlMask |= (1ULL << c);
+      insert(c);
+    }
+    for (auto t : targets)
+      insert(t);
+  }
+
+  /// @brief Number of independent amplitude groups in a state of dimension
+  /// `dim`.
+  std::size_t numGroups(std::size_t dim) const { return dim >> numPositions; }
+
+  /// @brief Index of the first amplitude of group `i`.
+  std::size_t base(std::size_t i) const {
+    return insertZeroBits(i, sortedPositions.data(), numPositions) |
+           controlMask;
+  }
+
+private:
+  void insert(std::size_t position) {
+    std::size_t i = numPositions++;
+    for (; i > 0 && sortedPositions[i - 1] > position; --i)
+      sortedPositions[i] = sortedPositions[i - 1];
+    sortedPositions[i] = position;
+  }
+};
+
+/// @brief Invoke `body(base)` for every amplitude group of the layout,
+/// distributing the groups over OpenMP threads for large states.
+template <typename Body>
+inline void forEachGroup(std::size_t dim, const GateLayout &layout,
+                         Body &&body) {
+  const std::int64_t count = layout.numGroups(dim);
+#if defined(_OPENMP)
+#pragma omp parallel for simd if (dim >= ParallelDimensionThreshold)
+#endif
+  for (std::int64_t i = 0; i < count; ++i)
+    body(layout.base(i));
+}
+
+/// @brief Apply a (possibly controlled) single-qubit gate in place. Diagonal
+/// and anti-diagonal matrices (phase, Z, S, T, RZ, X, Y, ...) only touch the
+/// amplitudes they change.
+template <typename ScalarType>
+void applyOneQubitGate(std::complex<ScalarType> *sv, std::size_t dim,
+                       const std::complex<ScalarType> *m,
+                       const std::vector<std::size_t> &controls,
+                       std::size_t target) {
+  using ComplexType = std::complex<ScalarType>;
+  const GateLayout layout(controls, {target});
+  const std::size_t tBit = 1ULL << target;
+  const ComplexType zero(0, 0), one(1, 0);
+  const ComplexType m00 = m[0], m01 = m[1], m10 = m[2], m11 = m[3];
+
+  if (m01 == zero && m10 == zero) {
+    if (m00 == one) {
+      forEachGroup(dim, layout, [=](std::size_t i0) {
+        sv[i0 | tBit] = cmul(m11, sv[i0 | tBit]);
+      });
+      return;
+    }
+    forEachGroup(dim, layout, [=](std::size_t i0) {
+      sv[i0] = cmul(m00, sv[i0]);
+      sv[i0 | tBit] = cmul(m11, sv[i0 | tBit]);
+    });
+    return;
+  }
+
+  if (m00 == zero && m11 == zero) {
+    if (m01 == one && m10 == one) {
+      forEachGroup(dim, layout, [=](std::size_t i0) {
+        const ComplexType a0 = sv[i0];
+        sv[i0] = sv[i0 | tBit];
+        sv[i0 | tBit] = a0;
+      });
+      return;
+    }
+    forEachGroup(dim, layout, [=](std::size_t i0) {
+      const ComplexType a0 = sv[i0];
+      const ComplexType a1 = sv[i0 | tBit];
+      sv[i0] = cmul(m01, a1);
+      sv[i0 | tBit] = cmul(m10, a0);
+    });
+    return;
+  }
+
+  forEachGroup(dim, layout, [=](std::size_t i0) {
+    const ComplexType a0 = sv[i0];
+    const ComplexType a1 = sv[i0 | tBit];
+    sv[i0] = cmul(m00, a0) + cmul(m01, a1);
+    sv[i0 | tBit] = cmul(m10, a0) + cmul(m11, a1);
+  });
+}
+
+/// @brief Apply a (possibly controlled) two-qubit gate in place.
+template <typename ScalarType>
+void applyTwoQubitGate(std::complex<ScalarType> *sv, std::size_t dim,
+                       const std::complex<ScalarType> *m,
+                       const std::vector<std::size_t> &controls,
+                       const std::vector<std::size_t> &targets) {
+  using ComplexType = std::complex<ScalarType>;
+  assert(targets.size() == 2);
+  const GateLayout layout(controls, targets);
+  const std::size_t hiBit = 1ULL << targets[0];
+  const std::size_t loBit = 1ULL << targets[1];
+  std::array<ComplexType, 16> mat;
+  for (std::size_t i = 0; i < 16; ++i)
+    mat[i] = m[i];
+
+  forEachGroup(dim, layout, [=](std::size_t base) {
+    const std::size_t idx[4] = {base, base | loBit, base | hiBit,
+                                base | hiBit | loBit};
+    const ComplexType a[4] = {sv[idx[0]], sv[idx[1]], sv[idx[2]], sv[idx[3]]};
+    for (std::size_t r = 0; r < 4; ++r)
+      sv[idx[r]] = cmul(mat[4 * r], a[0]) + cmul(mat[4 * r + 1], a[1]) +
+                   cmul(mat[4 * r + 2], a[2]) + cmul(mat[4 * r + 3], a[3]);
+  });
+}
+
+/// @brief Apply a (possibly controlled) dense gate on any number of targets in
+/// place. Each thread gathers the 2^k amplitudes of a group into a private
+/// buffer, multiplies and scatters them back.
+template <typename ScalarType>
+void applyMultiQubitGate(std::complex<ScalarType> *sv, std::size_t dim,
+                         const std::complex<ScalarType> *m,
+                         const std::vector<std::size_t> &controls,
+                         const std::vector<std::size_t> &targets) {
+  using ComplexType = std::complex<ScalarType>;
+  const GateLayout layout(controls, targets);
+  const std::size_t nTargets = targets.size();
+  const std::size_t localDim = 1ULL << nTargets;
+  std::vector<std::size_t> offsets(localDim, 0);
+  for (std::size_t r = 0; r < localDim; ++r)
+    for (std::size_t j = 0; j < nTargets; ++j)
+      if (r & (1ULL << (nTargets - 1 - j)))
+        offsets[r] |= (1ULL << targets[j]);
+
+  const std::int64_t count = layout.numGroups(dim);
+#if defined(_OPENMP)
+#pragma omp parallel if (dim >= ParallelDimensionThreshold)
+#endif
+  {
+    std::vector<ComplexType> in(localDim);
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+    for (std::int64_t i = 0; i < count; ++i) {
+      const std::size_t base = layout.base(i);
+      for (std::size_t c = 0; c < localDim; ++c)
+        in[c] = sv[base | offsets[c]];
+      for (std::size_t r = 0; r < localDim; ++r) {
+        const ComplexType *row = m + r * localDim;
+        ComplexType acc(0, 0);
+        for (std::size_t c = 0; c < localDim; ++c)
+          acc += cmul(row[c], in[c]);
+        sv[base | offsets[r]] = acc;
+      }
+    }
+  }
+}
+
+/// @brief Apply the gate described by `matrix`, `controls` and `targets` to
+/// the state vector in place, dispatching on the number of targets.
+template <typename ScalarType>
+void applyGate(std::complex<ScalarType> *sv, std::size_t dim,
+               const std::complex<ScalarType> *matrix,
+               const std::vector<std::size_t> &controls,
+               const std::vector<std::size_t> &targets) {
+  switch (targets.size()) {
+  case 1:
+    applyOneQubitGate(sv, dim, matrix, controls, targets[0]);
+    return;
+  case 2:
+    applyTwoQubitGate(sv, dim, matrix, controls, targets);
+    return;
+  default:
+    applyMultiQubitGate(sv, dim, matrix, controls, targets);
+    return;
+  }
+}
+
+} // namespace nvqir::kernels
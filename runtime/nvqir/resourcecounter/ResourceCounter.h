@@ -47,6 +47,7 @@ public:
     // Populate the correct name so it is printed correctly during
     // deconstructor.
     summaryData.name = name();
+    profile.name = name();
   }
   virtual ~ResourceCounter() = default;
 
@@ -97,8 +98,10 @@ public:
 
   cudaq::Resources *getResourceCounts() { return &this->resourceCounts; }
   void setResourceCounts(cudaq::Resources &&rc) {
+    // Static counts without a qubit count leave the allocations to be counted
+    // as the kernel runs.
+    this->prepopulated = rc.getNumQubits() != 0;
     this->resourceCounts = std::move(rc);
-    this->prepopulated = true;
   }
 
   void setChoiceFunction(std::function<bool()> choice) {
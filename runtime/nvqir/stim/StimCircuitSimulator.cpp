@@ -9,8 +9,14 @@
 #include "common/FmtCore.h"
 #include "nvqir/CircuitSimulator.h"
 #include "stim.h"
+#include <bit>
+#include <cerrno>
 #include <cmath>
+#include <cstring>
+#include <fcntl.h>
 #include <numeric>
+#include <sys/mman.h>
+#include <unistd.h>
 
 using namespace cudaq;
 
@@ -30,6 +36,39 @@ struct StimNoiseType {
   int num_targets = 1;
 };
 
+/// @brief A file of a fixed size, memory mapped for writing.
+class MappedOutputFile {
+public:
+  MappedOutputFile(const std::string &path, std::size_t size) : size(size) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+      throw std::runtime_error(
+          fmt::format("Could not open {}: {}", path, std::strerror(errno)));
+    if (::ftruncate(fd, size) == 0)
+      data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      const int error = errno;
+      ::close(fd);
+      throw std::runtime_error(fmt::format("Could not map {} ({} bytes): {}",
+                                           path, size, std::strerror(error)));
+    }
+  }
+  MappedOutputFile(const MappedOutputFile &) = delete;
+  MappedOutputFile &operator=(const MappedOutputFile &) = delete;
+
+  ~MappedOutputFile() {
+    ::munmap(data, size);
+    ::close(fd);
+  }
+
+  std::uint8_t *bytes() const { return static_cast<std::uint8_t *>(data); }
+
+private:
+  std::size_t size;
+  int fd = -1;
+  void *data = MAP_FAILED;
+};
+
 /// @brief The StimCircuitSimulator implements the CircuitSimulator
 /// base class to provide a simulator delegating to the Stim library from
 /// https://github.com/quantumlib/Stim.
@@ -63,6 +102,15 @@ protected:
   /// for speed)
   bool is_msm_mode = false;
 
+  /// @brief Whether or not the execution context name is "detector_sample", in
+  /// which case every operation applied to the simulators is also appended to
+  /// `recordedCircuit`.
+  bool is_detector_mode = false;
+
+  /// @brief The noisy circuit executed so far. This is only recorded for the
+  /// "detector_sample" execution context.
+  stim::Circuit recordedCircuit;
+
   std::optional<StimNoiseType>
   isValidStimNoiseChannel(const kraus_channel &channel) const {
 
@@ -167,9 +215,34 @@ protected:
       batch_size =
           executionContext->msm_dimensions.value_or(std::make_pair(1, 1))
               .second;
+    else if (isBatchObserve(executionContext))
+      batch_size = executionContext->shots;
     return batch_size;
   }
 
+  /// @brief Return true if the context is a shot-based observe, for which
+  /// every term is evaluated from one batch of frame simulator shots.
+  static bool isBatchObserve(const ExecutionContext *executionContext) {
+    return executionContext && executionContext->name == "observe" &&
+           !executionContext->hasConditionalsOnMeasureResults &&
+           executionContext->shots > 0 &&
+           executionContext->shots != static_cast<std::size_t>(-1);
+  }
+
+  /// @brief Return the number of `shots` bits set in `bits`, ignoring the
+  /// padding bits of the last word.
+  static std::size_t countOnes(const stim::simd_bits<W> &bits,
+                               std::size_t shots) {
+    std::size_t ones = 0;
+    const std::size_t fullWords = shots / 64;
+    for (std::size_t w = 0; w < fullWords; w++)
+      ones += std::popcount(bits.u64[w]);
+    if (shots % 64)
+      ones += std::popcount(bits.u64[fullWords] &
+                            ((std::uint64_t{1} << (shots % 64)) - 1));
+    return ones;
+  }
+
   /// @brief Return the number of rows and columns needed for a Parity Check
   /// Matrix
   std::optional<std::pair<std::size_t, std::size_t>>
@@ -187,19 +260,145 @@ protected:
 
     // Now it's msmSample[error_mechanism_index][measure_idx]
     msmSample = msmSample.transposed();
-    CountsDictionary counts;
-    std::vector<std::string> sequentialData;
+    PackedCounts counts(num_measurements);
+    PackedBitStrings sequentialData(num_measurements);
     sequentialData.reserve(num_cols);
+    std::vector<std::uint64_t> aShot(counts.numWords());
     for (std::size_t shot = 0; shot < num_cols; shot++) {
-      std::string aShot(num_measurements, '0');
+      std::fill(aShot.begin(), aShot.end(), 0);
       for (std::size_t b = 0; b < num_measurements; b++)
-        aShot[b] = msmSample[shot][b] ? '1' : '0';
-      counts[aShot]++;
-      sequentialData.push_back(std::move(aShot));
+        if (msmSample[shot][b])
+          PackedBitStrings::setBit(aShot.data(), b);
+      counts.add(aShot.data());
+      sequentialData.push_back(aShot.data());
+    }
+    getExecutionContext()->result = cudaq::sample_result(
+        ExecutionResult(std::move(counts), std::move(sequentialData)));
+  }
+
+  /// @brief Annotate the recorded circuit with the detectors and observables
+  /// of the execution context, extract its detector error model, and stream
+  /// `shots` samples of detection events and observable flips in chunks.
+  ///
+  /// Every chunk runs a fresh frame simulator pass over the recorded circuit.
+  /// The frame simulator stores detection events and observable flips
+  /// bit-packed by shot, one row per detector or observable, which is exactly
+  /// the output layout, so rows are copied out word by word without building
+  /// any per-shot data.
+  void generateDetectorSamples() override {
+    auto *executionContext = getExecutionContext();
+    if (!executionContext->detectorSample)
+      throw std::runtime_error("The detector_sample execution context requires "
+                               "detector sample options.");
+    auto &options = *executionContext->detectorSample;
+    flushGateQueue();
+
+    // Stim refers to measurements relative to the most recent one.
+    stim::Circuit circuit = recordedCircuit;
+    auto appendParity = [&](const std::string &instruction,
+                            const std::vector<std::size_t> &measurements) {
+      std::string text = instruction;
+      for (auto m : measurements) {
+        if (m >= num_measurements)
+          throw std::runtime_error(fmt::format(
+              "{} refers to measurement {}, but the kernel only performed {} "
+              "measurements.",
+              instruction, m, num_measurements));
+        text += fmt::format(" rec[-{}]", num_measurements - m);
+      }
+      circuit.append_from_text(text);
+    };
+    for (const auto &detector : options.detectors)
+      appendParity("DETECTOR", detector);
+    for (std::size_t o = 0; o < options.observables.size(); o++)
+      appendParity(fmt::format("OBSERVABLE_INCLUDE({})", o),
+                   options.observables[o]);
+
+    options.circuit = circuit.str();
+    // Disjoint error channels (e.g., PAULI_CHANNEL_1) are approximated as
+    // independent errors.
+    options.errorModel =
+        stim::ErrorAnalyzer::circuit_to_detector_error_model(
+            circuit, /*decompose_errors=*/false, /*fold_loops=*/true,
+            /*allow_gauge_detectors=*/false,
+            /*approximate_disjoint_errors_threshold=*/1,
+            /*ignore_decomposition_failures=*/false,
+            /*block_decomposition_from_introducing_remnant_edges=*/false)
+            .str();
+
+    const std::size_t shots = executionContext->shots;
+    if (shots == 0)
+      return;
+
+    const std::size_t chunkShots =
+        std::max<std::size_t>(64, (options.chunkShots + 63) / 64 * 64);
+    const std::size_t wordsPerRow = chunkShots / 64;
+    const std::size_t numDetectors = options.detectors.size();
+    const std::size_t numObservables = options.observables.size();
+    const std::size_t numRows = numDetectors + numObservables;
+    const std::size_t chunkWords = numRows * wordsPerRow;
+    const std::size_t numChunks = (shots + chunkShots - 1) / chunkShots;
+
+    constexpr std::size_t headerSize =
+        sizeof(cudaq::detector_sample_file_header);
+    std::unique_ptr<MappedOutputFile> file;
+    std::vector<std::uint64_t> buffer;
+    if (!options.outputFile.empty()) {
+      file = std::make_unique<MappedOutputFile>(
+          options.outputFile,
+          headerSize + numChunks * chunkWords * sizeof(std::uint64_t));
+      cudaq::detector_sample_file_header header{};
+      std::memcpy(header.magic, header.expectedMagic, sizeof(header.magic));
+      header.version = header.currentVersion;
+      header.numShots = shots;
+      header.chunkShots = chunkShots;
+      header.numDetectors = numDetectors;
+      header.numObservables = numObservables;
+      std::memcpy(file->bytes(), &header, headerSize);
+    } else {
+      buffer.resize(chunkWords);
+    }
+
+    CUDAQ_INFO("Sampling {} detectors and {} observables for {} shots in {} "
+               "chunks of {} shots",
+               numDetectors, numObservables, shots, numChunks, chunkShots);
+    randomEngine.discard(
+        std::uniform_int_distribution<int>(1, 30)(randomEngine));
+    stim::FrameSimulator<W> chunkSim(
+        circuit.compute_stats(),
+        stim::FrameSimulatorMode::STORE_DETECTIONS_TO_MEMORY, chunkShots,
+        std::mt19937_64(randomEngine));
+    for (std::size_t c = 0; c < numChunks; c++) {
+      const std::size_t firstShot = c * chunkShots;
+      const std::size_t numShots = std::min(chunkShots, shots - firstShot);
+      chunkSim.reset_all();
+      chunkSim.do_circuit(circuit);
+
+      std::uint64_t *chunk =
+          file ? reinterpret_cast<std::uint64_t *>(file->bytes() + headerSize) +
+                     c * chunkWords
+               : buffer.data();
+      for (std::size_t r = 0; r < numRows; r++) {
+        const auto row = r < numDetectors
+                             ? chunkSim.det_record.storage[r]
+                             : chunkSim.obs_record[r - numDetectors];
+        std::uint64_t *out = chunk + r * wordsPerRow;
+        std::copy_n(row.u64, wordsPerRow, out);
+        // Clear the bits of the padding shots of the last chunk.
+        if (numShots < chunkShots) {
+          std::fill(out + (numShots + 63) / 64, out + wordsPerRow, 0);
+          if (numShots % 64)
+            out[numShots / 64] &= (std::uint64_t{1} << (numShots % 64)) - 1;
+        }
+      }
+      if (options.callback)
+        options.callback({.firstShot = firstShot,
+                          .numShots = numShots,
+                          .chunkShots = chunkShots,
+                          .numDetectors = numDetectors,
+                          .numObservables = numObservables,
+                          .data = chunk});
     }
-    ExecutionResult result(counts);
-    result.sequentialData = std::move(sequentialData);
-    getExecutionContext()->result = result;
   }
 
   /// @brief Override the default sized allocation of qubits
@@ -222,6 +421,12 @@ protected:
     }
     if (!sampleSim) {
       is_msm_mode = executionContext && executionContext->name == "msm";
+      is_detector_mode =
+          executionContext && executionContext->name == "detector_sample";
+      if (is_detector_mode && executionContext->hasConditionalsOnMeasureResults)
+        throw std::runtime_error(
+            "Detector sampling does not support kernels with conditionals on "
+            "measurement results.");
       std::size_t anticipated_num_measurements = 0;
       std::size_t num_msm_cols = 0;
       if (is_msm_mode) {
@@ -271,6 +476,8 @@ protected:
     msm_err_count = 0;
     msm_id_counter = 0;
     is_msm_mode = false;
+    is_detector_mode = false;
+    recordedCircuit = stim::Circuit();
   }
 
   /// @brief Apply operation to all Stim simulators.
@@ -283,6 +490,8 @@ protected:
     tempCircuit.safe_append_u(gate_name, targets);
     tableau->safe_do_circuit(tempCircuit);
     sampleSim->safe_do_circuit(tempCircuit);
+    if (is_detector_mode)
+      recordedCircuit += tempCircuit;
   }
 
   /// @brief Apply the noise channel on \p qubits
@@ -300,9 +509,6 @@ protected:
     if (!executionContext->noiseModel)
       return;
 
-    // Get the name as a string
-    std::string gName(gateName);
-
     // Cast size_t to uint32_t
     std::vector<std::uint32_t> stimTargets;
     stimTargets.reserve(controls.size() + targets.size());
@@ -312,17 +518,18 @@ protected:
       stimTargets.push_back(static_cast<std::uint32_t>(q));
 
     // Get the Kraus channels specified for this gate and qubits
-    auto krausChannels = executionContext->noiseModel->get_channels(
-        gName, targets, controls, params);
+    const auto krausChannels =
+        executionContext->noiseModel->get_channels_cached(gateName, targets,
+                                                          controls, params);
 
     // If none, do nothing
-    if (krausChannels.empty())
+    if (krausChannels->empty())
       return;
 
-    CUDAQ_INFO("Applying {} kraus channels to qubits {}", krausChannels.size(),
+    CUDAQ_INFO("Applying {} kraus channels to qubits {}", krausChannels->size(),
                stimTargets);
 
-    for (auto &channel : krausChannels)
+    for (auto &channel : *krausChannels)
       applyNoise(channel, stimTargets);
   }
 
@@ -385,6 +592,8 @@ protected:
         // Only apply the noise operations to the sample simulator (not the
         // Tableau simulator).
         sampleSim->safe_do_circuit(noiseOps);
+        if (is_detector_mode)
+          recordedCircuit += noiseOps;
 
         // Increment the error count by the number of mechanisms
         msm_err_count += res->params.size();
@@ -535,6 +744,7 @@ public:
     // Populate the correct name so it is printed correctly during
     // deconstructor.
     summaryData.name = name();
+    profile.name = name();
     // Set supportsBufferedSample = true to tell the base class that this
     // simulator knows how to buffer the results across multiple sample()
     // invocations.
@@ -546,7 +756,87 @@ public:
     randomEngine = std::mt19937_64(seed);
   }
 
-  bool canHandleObserve() override { return false; }
+  /// @brief Shot-based observe is handled by `observe`, so that no basis
+  /// change or sampling pass is needed per term.
+  bool canHandleObserve() override {
+    return isBatchObserve(getExecutionContext());
+  }
+
+  /// @brief Compute the expectation value of every term of `op` from the
+  /// batch of frame simulator shots, without changing the state.
+  ///
+  /// Each shot of the frame simulator is the noiseless reference state of the
+  /// tableau with a Pauli error frame applied. Measuring a Pauli product `P`
+  /// gives the reference outcome, flipped if the frame anticommutes with `P`.
+  /// The anticommutation bits of all shots are computed at once by XOR-ing
+  /// the bit-packed frame rows of the qubits in the support of `P`: the X
+  /// rows for qubits where `P` has a Z component, and the Z rows for qubits
+  /// where it has an X component. The reference outcome is deterministic if
+  /// `P` or `-P` stabilizes the reference state. Otherwise it is uniformly
+  /// random, and a fresh random bit is drawn per shot.
+  cudaq::observe_result observe(const cudaq::spin_op &op) override {
+    auto *executionContext = getExecutionContext();
+    assert(isBatchObserve(executionContext));
+    flushGateQueue();
+    const std::size_t shots = executionContext->shots;
+    if (!sampleSim || sampleSim->batch_size < shots)
+      throw std::runtime_error("The Stim frame simulator has fewer shots than "
+                               "requested for observe.");
+
+    // Make sure both simulators cover every qubit of the operator.
+    std::size_t numQubits = 0;
+    for (const auto &term : op)
+      for (const auto &p : term)
+        numQubits = std::max<std::size_t>(numQubits, p.target() + 1);
+    if (numQubits > sampleSim->num_qubits ||
+        numQubits > tableau->inv_state.num_qubits)
+      applyOpToSims("I", {static_cast<std::uint32_t>(numQubits - 1)});
+
+    stim::simd_bits<W> flips(sampleSim->batch_size);
+    double ee = 0.0;
+    std::vector<cudaq::ExecutionResult> results;
+    results.reserve(op.num_terms() + 1);
+    for (const auto &term : op) {
+      stim::PauliString<W> pauli(numQubits);
+      flips.clear();
+      for (const auto &p : term) {
+        const auto q = p.target();
+        const auto type = p.as_pauli();
+        const bool hasX = type == cudaq::pauli::X || type == cudaq::pauli::Y;
+        const bool hasZ = type == cudaq::pauli::Z || type == cudaq::pauli::Y;
+        pauli.xs[q] = hasX;
+        pauli.zs[q] = hasZ;
+        if (hasZ)
+          flips ^= sampleSim->x_table[q];
+        if (hasX)
+          flips ^= sampleSim->z_table[q];
+      }
+
+      const auto reference = tableau->peek_observable_expectation(pauli);
+      if (reference == 0) {
+        stim::simd_bits<W> coin(sampleSim->batch_size);
+        coin.randomize(sampleSim->batch_size, sampleSim->rng);
+        flips ^= coin;
+      } else if (reference < 0) {
+        flips.invert_bits();
+      }
+
+      const std::size_t odd = countOnes(flips, shots);
+      const double exp =
+          (static_cast<double>(shots) - 2.0 * odd) / static_cast<double>(shots);
+      ee += (term.evaluate_coefficient() * exp).real();
+      // Record the parity of the outcomes, so that the expectation value of
+      // the counts matches the one computed here.
+      cudaq::CountsDictionary counts;
+      if (odd < shots)
+        counts["0"] = shots - odd;
+      if (odd > 0)
+        counts["1"] = odd;
+      results.emplace_back(std::move(counts), term.get_term_id(), exp);
+    }
+    results.emplace_back(cudaq::CountsDictionary{}, op.to_string(), ee);
+    return cudaq::observe_result(ee, op, cudaq::sample_result(results));
+  }
 
   /// @brief Reset the qubit
   /// @param index 0-based index of qubit to reset
@@ -607,7 +897,6 @@ public:
         sample[s].word_range_ref(0, ref.num_simd_words) ^= ref;
 
     size_t bits_per_sample = num_measurements;
-    std::vector<std::string> sequentialData;
     // Only retain the final "qubits.size()" measurements. All other
     // measurements were mid-circuit measurements that have been previously
     // accounted for and saved.
@@ -615,21 +904,22 @@ public:
     std::size_t first_bit_to_save = executionContext->explicitMeasurements
                                         ? 0
                                         : bits_per_sample - qubits.size();
-    CountsDictionary counts;
+    const std::size_t bits_to_save = bits_per_sample - first_bit_to_save;
+    PackedCounts counts(bits_to_save);
+    PackedBitStrings sequentialData(bits_to_save);
     if (includeSequentialData)
       sequentialData.reserve(shots);
+    std::vector<std::uint64_t> aShot(counts.numWords());
     for (std::size_t shot = 0; shot < shots; shot++) {
-      std::string aShot(bits_per_sample - first_bit_to_save, '0');
+      std::fill(aShot.begin(), aShot.end(), 0);
       for (std::size_t b = first_bit_to_save; b < bits_per_sample; b++)
-        aShot[b - first_bit_to_save] = sample[shot][b] ? '1' : '0';
-      counts[aShot]++;
+        if (sample[shot][b])
+          PackedBitStrings::setBit(aShot.data(), b - first_bit_to_save);
+      counts.add(aShot.data());
       if (includeSequentialData)
-        sequentialData.push_back(std::move(aShot));
+        sequentialData.push_back(aShot.data());
     }
-    ExecutionResult result(counts);
-    if (includeSequentialData)
-      result.sequentialData = std::move(sequentialData);
-    return result;
+    return ExecutionResult(std::move(counts), std::move(sequentialData));
   }
 
   bool isStateVectorSimulator() const override { return false; }
@@ -0,0 +1,244 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// REQUIRES: remote-sim
+// UNSUPPORTED: darwin-arm64
+// clang-format off
+// RUN: nvq++ --target remote-mqpu --remote-mqpu-url localhost:30471,localhost:30471,localhost:30471,localhost:30471 %s -o %t && %t
+// clang-format on
+
+// Four QPUs sharing a single `cudaq-qpud --workers 2 --max-queued-requests 1`
+// server, which this test launches itself. The workers are held with SIGSTOP,
+// and the load of the server is polled, so that the requests are in the
+// expected state whatever their timing.
+
+#include "remote_test_assert.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <cudaq.h>
+#include <filesystem>
+#include <fstream>
+#include <netinet/in.h>
+#include <optional>
+#include <signal.h>
+#include <sstream>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+extern char **environ;
+
+constexpr int serverPort = 30471;
+
+struct ghz {
+  void operator()(int numQubits) __qpu__ {
+    cudaq::qvector q(numQubits);
+    h(q[0]);
+    for (int i = 0; i + 1 < numQubits; ++i)
+      x<cudaq::ctrl>(q[i], q[i + 1]);
+    mz(q);
+  }
+};
+
+// Server process, terminated when the test exits.
+struct Server {
+  pid_t pid = -1;
+
+  Server() {
+    const std::string port = std::to_string(serverPort);
+    const char *argv[] = {"cudaq-qpud",
+                          "--port",
+                          port.c_str(),
+                          "--workers",
+                          "2",
+                          "--max-queued-requests",
+                          "1",
+                          nullptr};
+    if (::posix_spawnp(&pid, argv[0], nullptr, nullptr,
+                       const_cast<char **>(argv), environ) != 0)
+      pid = -1;
+  }
+
+  ~Server() {
+    if (pid > 0) {
+      // Stopped workers would keep the server from exiting.
+      signalWorkers(SIGCONT);
+      ::kill(pid, SIGTERM);
+      ::waitpid(pid, nullptr, 0);
+    }
+  }
+
+  // Open a connection to the server, or return -1.
+  static int connect() {
+    int sock = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(serverPort);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(sock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) ==
+        0)
+      return sock;
+    ::close(sock);
+    return -1;
+  }
+
+  // Wait until the server accepts connections.
+  bool waitUntilReady() const {
+    for (int i = 0; i < 300; ++i) {
+      int sock = connect();
+      if (sock >= 0) {
+        ::close(sock);
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return false;
+  }
+
+  // The numbers of running and queued requests, from the `/workers` endpoint.
+  static std::optional<std::pair<int, int>> load() {
+    int sock = connect();
+    if (sock < 0)
+      return std::nullopt;
+    const std::string request = "GET /workers HTTP/1.1\r\nHost: localhost\r\n"
+                                "Connection: close\r\n\r\n";
+    std::string response;
+    if (::send(sock, request.data(), request.size(), 0) ==
+        static_cast<ssize_t>(request.size())) {
+      char buffer[1024];
+      for (ssize_t n; (n = ::recv(sock, buffer, sizeof(buffer), 0)) > 0;)
+        response.append(buffer, n);
+    }
+    ::close(sock);
+    auto field = [&](const std::string &name) -> std::optional<int> {
+      const auto pos = response.find("\"" + name + "\":");
+      if (pos == std::string::npos)
+        return std::nullopt;
+      return std::atoi(response.c_str() + pos + name.size() + 3);
+    };
+    auto running = field("running");
+    auto queued = field("queued");
+    if (!running || !queued)
+      return std::nullopt;
+    return std::make_pair(*running, *queued);
+  }
+
+  // Poll the server until it has `running` requests on its workers and
+  // `queued` requests waiting for one.
+  static bool waitForLoad(int running, int queued) {
+    for (int i = 0; i < 3000; ++i) {
+      if (load() == std::make_pair(running, queued))
+        return true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+  }
+
+  // The worker processes are the children of the server.
+  std::vector<pid_t> workers() const {
+    std::vector<pid_t> children;
+    for (const auto &entry : std::filesystem::directory_iterator("/proc")) {
+      std::ifstream stat(entry.path() / "stat");
+      std::string line;
+      if (!std::getline(stat, line))
+        continue;
+      // The parent PID is the second field after the parenthesized name.
+      std::istringstream fields(line.substr(line.rfind(')') + 2));
+      char state;
+      pid_t ppid = -1;
+      fields >> state >> ppid;
+      // Killed workers stay zombies until the server restarts them.
+      if (ppid == pid && state != 'Z')
+        children.push_back(std::stoi(entry.path().filename()));
+    }
+    return children;
+  }
+
+  // Stopped workers hold on to the requests they are given until continued.
+  void signalWorkers(int signal) const {
+    for (auto worker : workers())
+      ::kill(worker, signal);
+  }
+};
+
+// Whether `counts` holds the two outcomes of a GHZ state on `numQubits`.
+bool isGhz(const cudaq::sample_result &counts, int numQubits) {
+  for (auto &[bits, count] : counts)
+    if (bits != std::string(numQubits, '0') &&
+        bits != std::string(numQubits, '1'))
+      return false;
+  return counts.size() == 2;
+}
+
+int main() {
+  Server server;
+  REMOTE_TEST_ASSERT(server.pid > 0);
+  REMOTE_TEST_ASSERT(server.waitUntilReady());
+  REMOTE_TEST_ASSERT(cudaq::get_platform().num_qpus() == 4);
+  REMOTE_TEST_ASSERT(server.workers().size() == 2);
+
+  // Concurrent clients each get the results of their own kernel. With both
+  // workers busy and the queue full, the fourth concurrent request is
+  // rejected.
+  {
+    server.signalWorkers(SIGSTOP);
+    std::vector<cudaq::async_sample_result> futures;
+    for (std::size_t qpu = 0; qpu < 3; ++qpu)
+      futures.emplace_back(cudaq::sample_async(qpu, ghz{}, qpu + 2));
+    const bool full = server.waitForLoad(2, 1);
+    bool rejected = false;
+    if (full) {
+      try {
+        cudaq::sample_async(3, ghz{}, 5).get();
+      } catch (std::exception &e) {
+        printf("Rejected: %s\n", e.what());
+        rejected =
+            std::string(e.what()).find("Server busy") != std::string::npos;
+      }
+    }
+    server.signalWorkers(SIGCONT);
+    for (std::size_t qpu = 0; qpu < 3; ++qpu)
+      REMOTE_TEST_ASSERT(isGhz(futures[qpu].get(), qpu + 2));
+    REMOTE_TEST_ASSERT(full);
+    REMOTE_TEST_ASSERT(rejected);
+    REMOTE_TEST_ASSERT(server.waitForLoad(0, 0));
+  }
+
+  // Killing the workers fails the request in flight, and the workers are
+  // restarted for the next requests.
+  {
+    const auto workers = server.workers();
+    REMOTE_TEST_ASSERT(workers.size() == 2);
+    server.signalWorkers(SIGSTOP);
+    auto inFlight = cudaq::sample_async(0, ghz{}, 4);
+    const bool running = server.waitForLoad(1, 0);
+    for (auto worker : workers)
+      ::kill(worker, SIGKILL);
+    bool failed = false;
+    try {
+      inFlight.get();
+    } catch (std::exception &e) {
+      printf("Failed: %s\n", e.what());
+      failed = std::string(e.what()).find("exited unexpectedly") !=
+               std::string::npos;
+    }
+    REMOTE_TEST_ASSERT(running);
+    REMOTE_TEST_ASSERT(failed);
+
+    // Enough concurrent requests to need both workers again.
+    std::vector<cudaq::async_sample_result> futures;
+    for (std::size_t qpu = 0; qpu < 3; ++qpu)
+      futures.emplace_back(cudaq::sample_async(qpu, ghz{}, qpu + 2));
+    for (std::size_t qpu = 0; qpu < 3; ++qpu)
+      REMOTE_TEST_ASSERT(isGhz(futures[qpu].get(), qpu + 2));
+  }
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates.                         *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// clang-format off
+// RUN: nvq++ %s -o %t && %t | FileCheck %s
+// RUN: nvq++ --library-mode %s -o %t && %t | FileCheck %s
+// clang-format on
+
+#include <cudaq.h>
+
+__qpu__ int unary_test(int count) {
+  unsigned result = 0;
+  cudaq::qvector v(count);
+  x(v);
+  for (int i = 0; i < count; i++) {
+    bool w = mz(v[i]);
+    result |= ((unsigned)w) << (count - 1 - i);
+  }
+  return result;
+}
+
+__qpu__ std::vector<int> vector_int_test() {
+  std::vector<int> result(2);
+  result[0] = 42;
+  result[1] = -13;
+  return result;
+}
+
+int main() {
+  {
+    // 10 shots in chunks of 4: 4 + 4 + 2.
+    std::vector<std::size_t> chunkSizes;
+    std::size_t numResults = 0;
+    bool allCorrect = true;
+    cudaq::run_streaming_options options;
+    options.chunk_size = 4;
+    const auto executed = cudaq::run_streaming(
+        10, options,
+        [&](std::vector<int> &&chunk) {
+          chunkSizes.push_back(chunk.size());
+          numResults += chunk.size();
+          for (auto r : chunk)
+            allCorrect = allCorrect && r == 15;
+          return true;
+        },
+        unary_test, 4);
+    printf("executed %lu, results %lu, chunks %lu, correct %d\n", executed,
+           numResults, chunkSizes.size(), allCorrect);
+    for (auto size : chunkSizes)
+      printf("chunk of %lu\n", size);
+  }
+
+  {
+    // Stop after the second chunk.
+    std::size_t numChunks = 0;
+    std::size_t numResults = 0;
+    bool allCorrect = true;
+    cudaq::run_streaming_options options;
+    options.chunk_size = 3;
+    const auto executed = cudaq::run_streaming(
+        100, options,
+        [&](std::vector<std::vector<int>> &&chunk) {
+          numResults += chunk.size();
+          for (auto &r : chunk)
+            allCorrect = allCorrect && r.size() == 2 && r[0] == 42 &&
+                         r[1] == -13;
+          return ++numChunks < 2;
+        },
+        vector_int_test);
+    printf("early stop: executed %lu, results %lu, chunks %lu, correct %d\n",
+           executed, numResults, numChunks, allCorrect);
+  }
+  return 0;
+}
+
+// CHECK: executed 10, results 10, chunks 3, correct 1
+// CHECK: chunk of 4
+// CHECK: chunk of 4
+// CHECK: chunk of 2
+// CHECK: early stop: executed 6, results 6, chunks 2, correct 1
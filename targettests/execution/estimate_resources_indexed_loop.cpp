@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * Copyright (c) 2025 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+
+// RUN: nvq++ --target quantinuum --emulate %s -o %t && %t | FileCheck %s
+
+#include <cudaq.h>
+#include <cudaq/algorithms/resource_estimation.h>
+
+struct ladder {
+  auto operator()() __qpu__ {
+    cudaq::qarray<4> q;
+    for (int i = 0; i < 4; i++)
+      h(q[i]);
+    for (int i = 0; i < 3; i++)
+      x<cudaq::ctrl>(q[i], q[i + 1]);
+  }
+};
+
+struct dynamic_ladder {
+  auto operator()(int n) __qpu__ {
+    cudaq::qvector q(n);
+    h(q[0]);
+    x<cudaq::ctrl>(q[0], q[1]);
+    x<cudaq::ctrl>(q[1], q[2]);
+  }
+};
+
+int main() {
+  auto counts = cudaq::estimate_resources(ladder{});
+  counts.dump();
+  // CHECK: Total # of gates: 7, total # of qubits: 4, circuit depth: 4, multi-Q gate count: 3, multi-Q depth: 3
+  // CHECK-DAG: h :  4
+  // CHECK-DAG: cx :  3
+
+  auto dynamicCounts = cudaq::estimate_resources(dynamic_ladder{}, 3);
+  dynamicCounts.dump();
+  // CHECK: Total # of gates: 3, total # of qubits: 3, circuit depth: 3, multi-Q gate count: 2, multi-Q depth: 2
+  // CHECK-DAG: h :  1
+  // CHECK-DAG: cx :  2
+
+  return 0;
+}
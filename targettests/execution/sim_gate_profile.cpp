@@ -0,0 +1,40 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// clang-format off
+// RUN: nvq++ --target qpp-cpu %s -o %t && CUDAQ_TIMING_TAGS=12 CUDAQ_PROFILE_FILE=%t %t | FileCheck %s
+// clang-format on
+
+// With the default settings, qpp fuses gates. Profiling still reports one
+// histogram per gate kind.
+
+#include <cudaq.h>
+#include <iostream>
+
+__qpu__ void kernel() {
+  cudaq::qvector q(4);
+  h(q);
+  for (int i = 0; i < 3; i++)
+    x<cudaq::ctrl>(q[i], q[i + 1]);
+  rx(0.1, q[0]);
+  rx(0.2, q[3]);
+  mz(q);
+}
+
+int main() {
+  auto counts = cudaq::sample(kernel);
+  std::cout << "done\n";
+  return 0;
+}
+
+// CHECK: done
+// CHECK: CircuitSimulator 'qpp' Profile [tag=12]:
+// CHECK-DAG: gate:h count = 4,
+// CHECK-DAG: gate:x count = 3,
+// CHECK-DAG: gate:rx count = 2,
+// CHECK-NOT: fused flush
@@ -10,6 +10,8 @@
 #include "common/Registry.h"
 #include "common/RemoteKernelExecutor.h"
 #include "llvm/Support/CommandLine.h"
+#include <algorithm>
+#include <thread>
 
 #ifdef __linux__
 #include <signal.h>
@@ -42,6 +44,19 @@ static llvm::cl::opt<bool> printRestPayloadVersion(
     llvm::cl::desc(
         "Display the REST request payload version that this server supports."),
     llvm::cl::init(false));
+static llvm::cl::opt<unsigned> numWorkers(
+    "workers",
+    llvm::cl::desc("Number of worker processes handling requests concurrently "
+                   "(0: one per hardware thread)."),
+    llvm::cl::init(1));
+static llvm::cl::opt<unsigned> maxQueuedRequests(
+    "max-queued-requests",
+    llvm::cl::desc("Number of requests that can wait for a worker before "
+                   "further requests are rejected."),
+    llvm::cl::init(64));
+// Internal: serve the requests of the parent server process.
+static llvm::cl::opt<bool> workerMode("worker", llvm::cl::Hidden,
+                                      llvm::cl::init(false));
 static llvm::cl::opt<bool> printCudaProperties(
     "cuda-properties",
     llvm::cl::desc("Display the CUDA properties of the host and exit."),
@@ -78,7 +93,10 @@ int main(int argc, char **argv) {
     }
     return 0;
   }
-  if (cudaq::mpi::available())
+  // Worker processes do not take part in MPI; servers running on multiple MPI
+  // ranks handle their requests in the main process.
+  const bool useMpi = !workerMode && cudaq::mpi::available();
+  if (useMpi)
     cudaq::mpi::initialize();
   // Check the server type arg is valid.
   if (!cudaq::registry::isRegistered<cudaq::RemoteRuntimeServer>(serverSubType))
@@ -87,7 +105,7 @@ int main(int argc, char **argv) {
         std::string(serverSubType));
   // Only log if this is not the default locally-hosted Rest server
   // implementation.
-  if (serverSubType != std::string(DEFAULT_SERVER_IMPL))
+  if (serverSubType != std::string(DEFAULT_SERVER_IMPL) && !workerMode)
     printf("[cudaq-qpud] Using server subtype: %s\n", serverSubType.c_str());
   auto restServer =
       cudaq::registry::get<cudaq::RemoteRuntimeServer>(serverSubType);
@@ -98,8 +116,20 @@ int main(int argc, char **argv) {
     return 0;
   }
 
-  restServer->init({{"port", std::to_string(port)}});
+  if (workerMode) {
+    restServer->init({{"worker", "1"}});
+    restServer->start();
+    return 0;
+  }
+
+  const unsigned workers =
+      numWorkers ? numWorkers.getValue()
+                 : std::max(1u, std::thread::hardware_concurrency());
+  restServer->init({{"port", std::to_string(port)},
+                    {"type", serverSubType},
+                    {"workers", std::to_string(workers)},
+                    {"max-queued-requests", std::to_string(maxQueuedRequests)}});
   restServer->start();
-  if (cudaq::mpi::available())
+  if (useMpi)
     cudaq::mpi::finalize();
 }
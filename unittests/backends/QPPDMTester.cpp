@@ -121,3 +121,61 @@ CUDAQ_TEST(QPPTester, checkDensityOrderingBug) {
     EXPECT_EQ(0, qppBackend.mz(q3));
   }
 }
+
+// Checks the in-place density matrix kernels against qpp, for a controlled
+// gate and for a channel applied on its own and fused with a gate.
+CUDAQ_TEST(QPPTester, checkDensityMatrixKernels) {
+  const std::size_t numQubits = 4;
+  const std::size_t dim = 1ULL << numQubits;
+  // qpp orders qubits big endian.
+  auto toQpp = [&](std::vector<std::size_t> qubits) {
+    for (auto &q : qubits)
+      q = numQubits - 1 - q;
+    return qubits;
+  };
+  auto toCmat = [](const std::vector<std::complex<double>> &rowMajor,
+                   std::size_t n) -> qpp::cmat {
+    return Eigen::Map<const Eigen::Matrix<std::complex<double>, Eigen::Dynamic,
+                                          Eigen::Dynamic, Eigen::RowMajor>>(
+        rowMajor.data(), n, n);
+  };
+
+  qpp::ket psi = qpp::randket(dim);
+  qpp::cmat expected = psi * psi.adjoint();
+  qpp::cmat rho = expected;
+
+  // Controlled U3 with control 3 and target 1.
+  auto u3 = nvqir::getGateByName<double>(nvqir::GateName::U3, {0.1, 0.2, 0.3});
+  nvqir::kernels::applyGateToDensityMatrix(rho.data(), dim, u3.data(), {3},
+                                           {1});
+  expected = qpp::applyCTRL(expected, toCmat(u3, 2), toQpp({3}), toQpp({1}));
+  EXPECT_TRUE(rho.isApprox(expected, 1e-12));
+
+  // Two-qubit amplitude damping-like channel on qubits 2 and 0.
+  std::vector<std::size_t> qubits{2, 0};
+  const auto damping = cudaq::amplitude_damping_channel(0.3).get_ops();
+  std::vector<qpp::cmat> kraus;
+  std::vector<std::complex<double>> superop;
+  for (auto &k1 : damping)
+    for (auto &k2 : damping) {
+      qpp::cmat k = qpp::kron(toCmat({k1.data.begin(), k1.data.end()}, 2),
+                              toCmat({k2.data.begin(), k2.data.end()}, 2));
+      kraus.push_back(k);
+      Eigen::Matrix<std::complex<double>, 4, 4, Eigen::RowMajor> rowMajor = k;
+      nvqir::kernels::addToSuperoperator(superop, rowMajor.data(), 4);
+    }
+  nvqir::kernels::applySuperoperator(rho.data(), dim, superop.data(), qubits);
+  expected = qpp::apply(expected, kraus, toQpp(qubits));
+  EXPECT_TRUE(rho.isApprox(expected, 1e-12));
+
+  // The same channel fused with a CNOT from qubit 2 to qubit 0.
+  auto x = nvqir::getGateByName<double>(nvqir::GateName::X, {});
+  auto cnot = nvqir::kernels::controlledGateMatrix(x.data(), 1, 1);
+  std::vector<std::complex<double>> gateSuperop;
+  nvqir::kernels::addToSuperoperator(gateSuperop, cnot.data(), 4);
+  auto fused = nvqir::kernels::multiplySquare(superop, gateSuperop, 16);
+  nvqir::kernels::applySuperoperator(rho.data(), dim, fused.data(), qubits);
+  expected = qpp::applyCTRL(expected, toCmat(x, 2), toQpp({2}), toQpp({0}));
+  expected = qpp::apply(expected, kraus, toQpp(qubits));
+  EXPECT_TRUE(rho.isApprox(expected, 1e-12));
+}
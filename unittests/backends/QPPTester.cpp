@@ -1228,3 +1228,72 @@ CUDAQ_TEST(QPPTester, checkReset) {
     EXPECT_EQ(1, qppBackend.mz(q1));
   }
 }
+
+// Checks that flushing a queue of gates through the gate fusion stage gives the
+// same state as applying the gates one at a time.
+CUDAQ_TEST(QPPTester, checkFusedGateQueue) {
+  QppSimulator fused, unfused;
+  std::vector<std::size_t> fusedQubits, unfusedQubits;
+  for (int i = 0; i < 4; i++) {
+    fusedQubits.push_back(fused.allocateQubit());
+    unfusedQubits.push_back(unfused.allocateQubit());
+  }
+
+  auto circuit = [](QppSimulator &sim, const std::vector<std::size_t> &q,
+                    bool flushEachGate) {
+    auto step = [&]() {
+      if (flushEachGate)
+        sim.getStateVector();
+    };
+    sim.h(q[0]);
+    step();
+    sim.x({q[0]}, q[1]);
+    step();
+    sim.ry(0.3, q[2]);
+    step();
+    sim.rz(0.7, q[1]);
+    step();
+    sim.x({q[1], q[2]}, q[3]);
+    step();
+    sim.t(q[2]);
+    step();
+    sim.swap(q[0], q[3]);
+    step();
+    sim.u3(0.1, 0.2, 0.3, {q[3]}, q[0]);
+    step();
+    sim.s(q[1]);
+    step();
+    sim.rx(1.1, q[2]);
+    step();
+  };
+
+  circuit(fused, fusedQubits, /*flushEachGate=*/false);
+  circuit(unfused, unfusedQubits, /*flushEachGate=*/true);
+  EXPECT_EQ_KETS(unfused.getStateVector(), fused.getStateVector(), 1e-12);
+}
+
+CUDAQ_TEST(QPPTester, checkPooledStateVector) {
+  qpp::ket bell = qpp::ket::Zero(4);
+  bell(0) = bell(3) = M_SQRT1_2;
+  const std::vector<std::complex<double>> plus{M_SQRT1_2, M_SQRT1_2};
+  const qpp::ket plusKet = Eigen::Map<const qpp::ket>(plus.data(), 2);
+
+  QppSimulator qppBackend;
+  for (int launch = 0; launch < 2; launch++) {
+    // Every launch starts in the 0-state, although the buffer of the previous
+    // launch is reused.
+    auto q0 = qppBackend.allocateQubit();
+    auto q1 = qppBackend.allocateQubit();
+    EXPECT_EQ_KETS(getZeroState(2), qppBackend.getStateVector());
+    qppBackend.h(q0);
+    qppBackend.x({q0}, q1);
+
+    // Growing the register in place keeps the existing amplitudes.
+    auto q2 = qppBackend.allocateQubits(1, plus.data(),
+                                        cudaq::simulation_precision::fp64);
+    auto q3 = qppBackend.allocateQubit();
+    EXPECT_EQ_KETS(qpp::kron(getZeroState(1), qpp::kron(plusKet, bell)),
+                   qppBackend.getStateVector());
+    qppBackend.deallocateQubits({q0, q1, q2[0], q3});
+  }
+}
@@ -8,6 +8,8 @@
 
 #include "StimCircuitSimulator.cpp"
 
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 
 #include "CUDAQTestUtils.h"
@@ -61,3 +63,141 @@ CUDAQ_TEST(StimTester, SetToZeroStatePreservesSimulators) {
   }
   EXPECT_EQ(false, sim.mz(q0));
 }
+
+struct StimBellKernel {
+  void operator()() __qpu__ {
+    cudaq::qvector q(2);
+    h(q[0]);
+    x<cudaq::ctrl>(q[0], q[1]);
+  }
+};
+
+struct StimFlipKernel {
+  void operator()() __qpu__ {
+    cudaq::qubit q;
+    x(q);
+  }
+};
+
+CUDAQ_TEST(StimTester, BatchObserve) {
+  cudaq::set_random_seed(13);
+  const int shots = 10000;
+  auto zz = cudaq::spin_op::z(0) * cudaq::spin_op::z(1);
+  auto xx = cudaq::spin_op::x(0) * cudaq::spin_op::x(1);
+  auto yy = cudaq::spin_op::y(0) * cudaq::spin_op::y(1);
+  auto z0 = cudaq::spin_op::z(0);
+  cudaq::spin_op h = 2.0 + zz + 0.5 * xx + 0.25 * yy - z0;
+
+  auto result = cudaq::observe(shots, StimBellKernel{}, h);
+  // Stabilizers of the Bell state are deterministic, Z0 is random.
+  EXPECT_NEAR(result.expectation(zz), 1.0, 1e-12);
+  EXPECT_NEAR(result.expectation(xx), 1.0, 1e-12);
+  EXPECT_NEAR(result.expectation(yy), -1.0, 1e-12);
+  EXPECT_NEAR(result.expectation(z0), 0.0, 0.05);
+  EXPECT_NEAR(result.expectation(), 2.0 + 1.0 + 0.5 - 0.25, 0.05);
+
+  // Every term is estimated from the requested number of shots.
+  auto data = result.raw_data();
+  for (const auto &name : data.register_names()) {
+    if (name == cudaq::GlobalRegisterName)
+      continue;
+    std::size_t totalShots = 0;
+    for (auto &[bits, count] : data.to_map(name))
+      totalShots += count;
+    EXPECT_EQ(totalShots, shots);
+  }
+
+  // Noise flips the frames of the shots.
+  cudaq::noise_model noise;
+  noise.add_channel<cudaq::types::x>({0}, cudaq::bit_flip_channel(0.1));
+  auto noisy = cudaq::observe({.shots = shots, .noise = noise},
+                              StimFlipKernel{}, z0);
+  EXPECT_NEAR(noisy.expectation(), -0.8, 0.03);
+}
+
+struct StimRepetitionKernel {
+  void operator()() __qpu__ {
+    cudaq::qvector data(3), ancilla(2);
+    x<cudaq::ctrl>(data[0], ancilla[0]);
+    x<cudaq::ctrl>(data[1], ancilla[0]);
+    x<cudaq::ctrl>(data[1], ancilla[1]);
+    x<cudaq::ctrl>(data[2], ancilla[1]);
+    mz(ancilla);
+    mz(data);
+  }
+};
+
+CUDAQ_TEST(StimTester, DetectorSample) {
+  cudaq::set_random_seed(13);
+  const double p = 0.0625;
+  cudaq::noise_model noise;
+  for (std::size_t q = 0; q < 3; q++)
+    noise.add_channel("mz", {q}, cudaq::bit_flip_channel(p));
+
+  // Measurements: ancilla 0, ancilla 1, data 0, data 1, data 2.
+  const std::size_t shots = 1000;
+  auto fileName = std::filesystem::temp_directory_path() /
+                  "cudaq_stim_detector_sample.bin";
+  cudaq::ExecutionContext ctx("detector_sample", shots);
+  ctx.noiseModel = &noise;
+  auto &options = ctx.detectorSample.emplace();
+  options.detectors = {{0}, {1}, {0, 2, 3}, {1, 3, 4}};
+  options.observables = {{2}};
+  options.chunkShots = 250;
+  options.outputFile = fileName.string();
+  std::vector<std::size_t> firstShots;
+  std::vector<std::uint64_t> samples;
+  options.callback = [&](const cudaq::detector_sample_batch &batch) {
+    firstShots.push_back(batch.firstShot);
+    samples.insert(samples.end(), batch.data,
+                   batch.data + (batch.numDetectors + batch.numObservables) *
+                                    batch.wordsPerRow());
+  };
+  cudaq::get_platform().with_execution_context(ctx, StimRepetitionKernel{});
+
+  EXPECT_NE(options.circuit.find("DETECTOR rec[-5] rec[-3] rec[-2]"),
+            std::string::npos);
+  EXPECT_NE(options.circuit.find("OBSERVABLE_INCLUDE(0) rec[-3]"),
+            std::string::npos);
+  // A measurement error on data qubit 1 triggers both data detectors, and
+  // one on data qubit 0 flips the observable.
+  EXPECT_NE(options.errorModel.find("D2 D3"), std::string::npos);
+  EXPECT_NE(options.errorModel.find("D2 L0"), std::string::npos);
+
+  // Chunks are rounded up to 256 shots, and padding shots are zero.
+  const std::size_t chunkShots = 256, wordsPerRow = 4, numRows = 5;
+  EXPECT_EQ(firstShots, (std::vector<std::size_t>{0, 256, 512, 768}));
+  ASSERT_EQ(samples.size(), firstShots.size() * numRows * wordsPerRow);
+  std::size_t d3 = 0;
+  for (std::size_t c = 0; c < firstShots.size(); c++) {
+    const auto *chunk = samples.data() + c * numRows * wordsPerRow;
+    for (std::size_t s = 0; s < chunkShots; s++) {
+      auto bit = [&](std::size_t row) {
+        return (chunk[row * wordsPerRow + s / 64] >> (s % 64)) & 1;
+      };
+      EXPECT_EQ(bit(0), 0);
+      EXPECT_EQ(bit(1), 0);
+      if (c * chunkShots + s >= shots)
+        for (std::size_t row = 2; row < numRows; row++)
+          EXPECT_EQ(bit(row), 0);
+      d3 += bit(3);
+    }
+  }
+  EXPECT_NEAR(static_cast<double>(d3) / shots, 2 * p * (1 - p), 0.04);
+
+  // The file holds the header followed by the same chunks.
+  std::ifstream file(fileName, std::ios::binary);
+  cudaq::detector_sample_file_header header;
+  file.read(reinterpret_cast<char *>(&header), sizeof(header));
+  EXPECT_EQ(std::string(header.magic, 8), "CUDAQDET");
+  EXPECT_EQ(header.numShots, shots);
+  EXPECT_EQ(header.chunkShots, chunkShots);
+  EXPECT_EQ(header.numDetectors, 4);
+  EXPECT_EQ(header.numObservables, 1);
+  std::vector<std::uint64_t> fileSamples(samples.size());
+  file.read(reinterpret_cast<char *>(fileSamples.data()),
+            fileSamples.size() * sizeof(std::uint64_t));
+  EXPECT_EQ(fileSamples, samples);
+  file.close();
+  std::filesystem::remove(fileName);
+}
@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "common/Future.h"
+#include "common/RestClient.h"
+#include "common/ServerHelper.h"
+#include <chrono>
+#include <gtest/gtest.h>
+
+namespace {
+const std::string mockUrl = "http://localhost:62454";
+
+/// Server helper for the polling mock server. Jobs report `running` with the
+/// interval after which they want to be polled again, and `done` with their
+/// counts once their duration has elapsed.
+class FuturePollingServerHelper : public cudaq::ServerHelper {
+public:
+  const std::string name() const override { return "future_polling"; }
+
+  void initialize(cudaq::BackendConfig config) override {
+    backendConfig = std::move(config);
+  }
+
+  cudaq::RestHeaders getHeaders() override { return cudaq::RestHeaders(); }
+
+  cudaq::ServerJobPayload
+  createJob(std::vector<cudaq::KernelExecution> &circuitCodes) override {
+    throw std::runtime_error("future_polling does not submit kernels.");
+  }
+
+  std::string extractJobId(cudaq::ServerMessage &postResponse) override {
+    return postResponse["id"];
+  }
+
+  std::string constructGetJobPath(std::string &jobId) override {
+    return mockUrl + "/job/" + jobId;
+  }
+
+  std::string constructGetJobPath(cudaq::ServerMessage &postResponse) override {
+    return mockUrl + "/job/" + postResponse["id"].get<std::string>();
+  }
+
+  std::chrono::microseconds
+  nextResultPollingInterval(cudaq::ServerMessage &getJobResponse) override {
+    return std::chrono::milliseconds(getJobResponse["interval_ms"].get<int>());
+  }
+
+  bool jobIsDone(cudaq::ServerMessage &getJobResponse) override {
+    return getJobResponse["status"] == "done";
+  }
+
+  cudaq::sample_result processResults(cudaq::ServerMessage &getJobResponse,
+                                      std::string &jobId) override {
+    return cudaq::sample_result(cudaq::ExecutionResult(
+        getJobResponse["counts"].get<cudaq::CountsDictionary>()));
+  }
+};
+} // namespace
+
+CUDAQ_REGISTER_TYPE(cudaq::ServerHelper, FuturePollingServerHelper,
+                    future_polling)
+
+CUDAQ_TEST(FuturePollingTester, checkOutOfOrderJobs) {
+  using namespace std::chrono_literals;
+  cudaq::RestClient client;
+  std::map<std::string, std::string> headers;
+
+  // Jobs finish in the order 1, 2, 0, and each asks to be polled every 100ms.
+  const std::vector<double> durations = {0.9, 0.3, 0.6};
+  std::vector<cudaq::details::future::Job> jobs;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < durations.size(); ++i) {
+    nlohmann::json payload;
+    payload["duration"] = durations[i];
+    payload["interval"] = 0.1;
+    payload["counts"] = {{std::string(i + 1, '1'), i + 1}};
+    auto response = client.post(mockUrl, "/job", payload, headers);
+    jobs.emplace_back(response["id"].get<std::string>(),
+                      "job" + std::to_string(i));
+  }
+
+  std::string qpuName = "future_polling";
+  std::map<std::string, std::string> config;
+  cudaq::details::future f(jobs, qpuName, config,
+                           cudaq::details::ExecutionContextType::observe);
+  auto result = f.get();
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  // Results are assembled in job order, not completion order.
+  ASSERT_EQ(result.register_names().size(), jobs.size());
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    auto counts = result.to_map(jobs[i].second);
+    ASSERT_EQ(counts.size(), 1);
+    EXPECT_EQ(counts.begin()->first, std::string(i + 1, '1'));
+    EXPECT_EQ(counts.begin()->second, i + 1);
+  }
+
+  // The jobs are polled concurrently, so the wait is bounded by the slowest
+  // job (0.9s) rather than the sum of all of them (1.8s).
+  EXPECT_LT(elapsed, 1500ms);
+
+  // No job was polled before the interval it asked for had elapsed, and no
+  // job was polled much more often than its interval allows.
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    auto stats =
+        client.get(mockUrl, "/job/" + jobs[i].first + "/stats", headers);
+    EXPECT_EQ(stats["early_polls"].get<int>(), 0) << jobs[i].second;
+    EXPECT_LE(stats["polls"].get<int>(),
+              static_cast<int>(durations[i] / 0.1) + 2)
+        << jobs[i].second;
+  }
+}
@@ -0,0 +1,69 @@
+# ============================================================================ #
+# Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                   #
+# All rights reserved.                                                         #
+#                                                                              #
+# This source code and the accompanying materials are made available under     #
+# the terms of the Apache License 2.0 which accompanies this distribution.     #
+# ============================================================================ #
+
+from fastapi import FastAPI, HTTPException, Request
+import time, uuid, uvicorn
+
+# Define the REST Server App
+app = FastAPI()
+
+# Slack allowed between the advertised polling interval and the next poll.
+POLL_TOLERANCE = 0.02
+
+# Job id -> job record. A job runs for `duration` seconds from its creation and
+# asks to be polled again every `interval` seconds until then.
+createdJobs = {}
+
+
+@app.post("/job")
+async def postJob(request: Request):
+    payload = await request.json()
+    newId = str(uuid.uuid4())
+    createdJobs[newId] = {
+        "done_at": time.monotonic() + payload["duration"],
+        "interval": payload["interval"],
+        "counts": payload["counts"],
+        "next_poll": 0.0,
+        "polls": 0,
+        "early_polls": 0,
+    }
+    return {"id": newId}
+
+
+@app.get("/job/{jobId}")
+async def getJob(jobId: str):
+    if jobId not in createdJobs:
+        raise HTTPException(status_code=404, detail="Job ID not found")
+
+    job = createdJobs[jobId]
+    now = time.monotonic()
+    job["polls"] += 1
+    if now + POLL_TOLERANCE < job["next_poll"]:
+        job["early_polls"] += 1
+
+    if now >= job["done_at"]:
+        return {"status": "done", "counts": job["counts"]}
+
+    job["next_poll"] = now + job["interval"]
+    return {"status": "running", "interval_ms": int(job["interval"] * 1000)}
+
+
+@app.get("/job/{jobId}/stats")
+async def getJobStats(jobId: str):
+    if jobId not in createdJobs:
+        raise HTTPException(status_code=404, detail="Job ID not found")
+    job = createdJobs[jobId]
+    return {"polls": job["polls"], "early_polls": job["early_polls"]}
+
+
+def startServer(port):
+    uvicorn.run(app, port=port, host='0.0.0.0', log_level="info")
+
+
+if __name__ == '__main__':
+    startServer(62454)
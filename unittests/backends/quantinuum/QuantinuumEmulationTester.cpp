@@ -8,6 +8,7 @@
 
 #include "CUDAQTestUtils.h"
 #include "cudaq/algorithm.h"
+#include "cudaq_internal/compiler/JITCache.h"
 #include <fstream>
 #include <gtest/gtest.h>
 
@@ -83,6 +84,39 @@ CUDAQ_TEST(QuantinuumTester, checkObserveAsyncEmulate) {
   EXPECT_TRUE(isValidExpVal(result.expectation()));
 }
 
+CUDAQ_TEST(QuantinuumTester, checkJITCacheEmulate) {
+
+  auto [kernel, theta] = cudaq::make_kernel<double>();
+  auto qubit = kernel.qalloc(2);
+  kernel.x(qubit[0]);
+  kernel.ry(theta, qubit[1]);
+  kernel.x<cudaq::ctrl>(qubit[1], qubit[0]);
+  kernel.mz(qubit);
+
+  auto &cache = cudaq_internal::compiler::JITCache::get();
+  cache.clear();
+  auto counts = cudaq::sample(100, kernel, .59);
+  EXPECT_EQ(cache.getHits(), 0);
+  EXPECT_EQ(cache.getMisses(), 1);
+
+  // Same kernel and arguments: the lowered module is reused.
+  counts = cudaq::sample(100, kernel, .59);
+  EXPECT_EQ(cache.getHits(), 1);
+  EXPECT_EQ(cache.getMisses(), 1);
+
+  // New synthesized argument: new lowered module.
+  counts = cudaq::sample(100, kernel, 1.2);
+  EXPECT_EQ(cache.getHits(), 1);
+  EXPECT_EQ(cache.getMisses(), 2);
+
+  const auto capacity = cache.getCapacity();
+  cache.setCapacity(0);
+  counts = cudaq::sample(100, kernel, .59);
+  EXPECT_EQ(cache.getHits(), 1);
+  EXPECT_EQ(cache.getMisses(), 2);
+  cache.setCapacity(capacity);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   auto ret = RUN_ALL_TESTS();
@@ -9,9 +9,15 @@
 #include "common/ExecutionContext.h"
 #include "common/RuntimeTarget.h"
 #include "cudaq/platform/qpu.h"
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
 #include <gtest/gtest.h>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -85,3 +91,79 @@ TEST(ExecutionContextThreadTester, checkThreadLocalContext) {
   // 2. Context was null after reset.
   EXPECT_EQ(successCount.load(), numThreads * 2);
 }
+
+/// Test that a queue with multiple workers runs independent tasks
+/// concurrently, each on its own thread.
+TEST(ExecutionContextThreadTester, checkConcurrentExecutionQueue) {
+  constexpr std::size_t numTasks = 4;
+  QuantumExecutionQueue queue(numTasks);
+  EXPECT_EQ(queue.getNumWorkers(), numTasks);
+
+  // Every task waits until all tasks have started, which can only happen if
+  // they run concurrently.
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::size_t numStarted = 0;
+  std::vector<std::thread::id> threadIds;
+  std::vector<std::future<bool>> results;
+  for (std::size_t i = 0; i < numTasks; ++i) {
+    auto promise = std::make_shared<std::promise<bool>>();
+    results.push_back(promise->get_future());
+    QuantumTask task = [&, promise]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      ++numStarted;
+      threadIds.push_back(std::this_thread::get_id());
+      cv.notify_all();
+      promise->set_value(cv.wait_for(lock, std::chrono::seconds(30), [&] {
+        return numStarted == numTasks;
+      }));
+    };
+    queue.enqueue(task);
+  }
+
+  for (auto &result : results)
+    EXPECT_TRUE(result.get());
+  std::sort(threadIds.begin(), threadIds.end());
+  EXPECT_EQ(std::unique(threadIds.begin(), threadIds.end()), threadIds.end());
+}
+
+/// Test that ordered tasks neither overlap with nor overtake other tasks.
+TEST(ExecutionContextThreadTester, checkOrderedExecutionQueueTasks) {
+  QuantumExecutionQueue queue(4);
+
+  std::mutex mutex;
+  std::vector<std::string> events;
+  auto makeTask = [&](std::string name) -> QuantumTask {
+    return [&, name]() {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back("start " + name);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      std::lock_guard<std::mutex> lock(mutex);
+      events.push_back("end " + name);
+    };
+  };
+
+  auto a = makeTask("a");
+  auto b = makeTask("b");
+  auto c = makeTask("c");
+  auto d = makeTask("d");
+  std::promise<void> done;
+  QuantumTask last = [&]() { done.set_value(); };
+  queue.enqueue(a);
+  queue.enqueue(b);
+  queue.enqueueOrdered(c);
+  queue.enqueue(d);
+  queue.enqueueOrdered(last);
+  done.get_future().get();
+
+  auto position = [&](const std::string &event) {
+    return std::find(events.begin(), events.end(), event) - events.begin();
+  };
+  ASSERT_EQ(events.size(), 8u);
+  EXPECT_LT(position("end a"), position("start c"));
+  EXPECT_LT(position("end b"), position("start c"));
+  EXPECT_EQ(position("end c"), position("start c") + 1);
+  EXPECT_LT(position("end c"), position("start d"));
+}
@@ -8,6 +8,7 @@
 
 #include "CUDAQTestUtils.h"
 #include "common/SampleResult.h"
+#include <thread>
 
 using namespace cudaq;
 
@@ -64,3 +65,151 @@ CUDAQ_TEST(MeasureCountsTester, checkMeasureCountsSerialize) {
 
   EXPECT_TRUE(mm == mc);
 }
+
+// Packed results must behave exactly like the equivalent string results.
+CUDAQ_TEST(MeasureCountsTester, checkPackedResult) {
+  const std::vector<std::string> shots = {"0110", "0110", "1111", "0001",
+                                          "0110", "1000", "1111"};
+  PackedCounts packedCounts(4);
+  PackedBitStrings packedShots(4);
+  ExecutionResult stringResult;
+  std::vector<std::uint64_t> record(packedCounts.numWords());
+  for (auto &shot : shots) {
+    PackedBitStrings::pack(shot, record.data());
+    packedCounts.add(record.data());
+    packedShots.push_back(record.data());
+    stringResult.appendResult(shot, 1);
+  }
+  ExecutionResult packedResult(packedCounts, packedShots);
+  EXPECT_TRUE(packedResult.isPacked());
+  EXPECT_EQ(packedResult.getCounts(), stringResult.counts);
+
+  cudaq::sample_result packed(packedResult), strings(stringResult);
+  EXPECT_EQ(packed.size(), strings.size());
+  EXPECT_EQ(packed.get_total_shots(), shots.size());
+  EXPECT_EQ(packed.most_probable(), "0110");
+  EXPECT_EQ(packed.count("1111"), 2);
+  EXPECT_EQ(packed.count("111"), 0);
+  EXPECT_NEAR(packed.probability("0001"), 1. / 7., 1e-12);
+  EXPECT_NEAR(packed.expectation(), strings.expectation(), 1e-12);
+  EXPECT_EQ(packed.sequential_data(), shots);
+  EXPECT_EQ(packed.to_map(), strings.to_map());
+
+  auto packedMarginal = packed.get_marginal({3, 0});
+  auto stringMarginal = strings.get_marginal({3, 0});
+  EXPECT_EQ(packedMarginal.to_map(), stringMarginal.to_map());
+
+  packed.reorder({3, 2, 1, 0});
+  strings.reorder({3, 2, 1, 0});
+  EXPECT_EQ(packed.sequential_data(), strings.sequential_data());
+
+  packed += packed;
+  strings += strings;
+  EXPECT_EQ(packed.get_total_shots(), 2 * shots.size());
+  EXPECT_EQ(packed.to_map(), strings.to_map());
+  EXPECT_TRUE(packed == strings);
+
+  // Iterating materializes the string form.
+  std::size_t total = 0;
+  for (auto &[bits, count] : packed)
+    total += count;
+  EXPECT_EQ(total, 2 * shots.size());
+}
+
+CUDAQ_TEST(MeasureCountsTester, checkPackedCountsWide) {
+  // Bit strings spanning several 64-bit words.
+  const std::size_t numBits = 130;
+  PackedCounts counts(numBits);
+  std::string a(numBits, '0'), b(numBits, '0');
+  a[0] = a[64] = a[129] = '1';
+  b[63] = b[127] = '1';
+  std::vector<std::uint64_t> record(counts.numWords());
+  PackedBitStrings::pack(a, record.data());
+  counts.add(record.data(), 3);
+  PackedBitStrings::pack(b, record.data());
+  counts.add(record.data(), 5);
+  PackedBitStrings::pack(a, record.data());
+  counts.add(record.data());
+
+  EXPECT_EQ(counts.size(), 2);
+  EXPECT_EQ(counts.totalCount(), 9);
+  EXPECT_EQ(counts.count(a), 4);
+  EXPECT_EQ(counts.count(b), 5);
+  EXPECT_EQ(counts.count(std::string(numBits, '1')), 0);
+
+  cudaq::sample_result result(ExecutionResult{counts});
+  EXPECT_EQ(result.most_probable(), b);
+  // `a` has odd parity, `b` even.
+  EXPECT_NEAR(result.expectation(), (5. - 4.) / 9., 1e-12);
+}
+
+// Const iteration of a shared packed result may happen on several threads.
+CUDAQ_TEST(MeasureCountsTester, checkPackedConstIterationConcurrent) {
+  PackedCounts packedCounts(3);
+  std::vector<std::uint64_t> record(packedCounts.numWords());
+  for (const auto *shot : {"000", "101", "101", "110"}) {
+    PackedBitStrings::pack(shot, record.data());
+    packedCounts.add(record.data());
+  }
+  const cudaq::sample_result result{ExecutionResult(packedCounts)};
+
+  std::vector<std::thread> threads;
+  std::vector<std::size_t> totals(8, 0);
+  for (std::size_t t = 0; t < totals.size(); ++t)
+    threads.emplace_back([&, t] {
+      for (auto &[bits, count] : result)
+        totals[t] += count * (result.count(bits) == count);
+    });
+  for (auto &thread : threads)
+    thread.join();
+  for (auto total : totals)
+    EXPECT_EQ(total, 4);
+  EXPECT_EQ(result.to_map().at("101"), 2);
+
+  // Mutating the result drops the cached string form.
+  cudaq::sample_result copy = result;
+  copy.reorder({2, 1, 0});
+  std::size_t reordered = 0;
+  for (auto &[bits, count] : copy)
+    reordered += bits == "011" ? count : 0;
+  EXPECT_EQ(reordered, 1);
+}
+
+// Merging packed results drops the string form cached by const iteration.
+CUDAQ_TEST(MeasureCountsTester, checkPackedCachedCountsAfterMerge) {
+  auto makeResult = [](const std::vector<std::string> &shots) {
+    PackedCounts packedCounts(2);
+    PackedBitStrings packedShots(2);
+    std::vector<std::uint64_t> record(packedCounts.numWords());
+    for (auto &shot : shots) {
+      PackedBitStrings::pack(shot, record.data());
+      packedCounts.add(record.data());
+      packedShots.push_back(record.data());
+    }
+    return ExecutionResult(packedCounts, packedShots);
+  };
+  auto totalOf = [](const cudaq::sample_result &result) {
+    std::size_t total = 0;
+    for (auto &[bits, count] : result)
+      total += count;
+    return total;
+  };
+
+  cudaq::sample_result merged(makeResult({"01", "01", "10"}));
+  EXPECT_EQ(totalOf(merged), 3);
+  merged += cudaq::sample_result(makeResult({"01", "11"}));
+  EXPECT_EQ(totalOf(merged), 5);
+  EXPECT_EQ(merged.count("01"), 3);
+  EXPECT_EQ(merged.count("11"), 1);
+  EXPECT_EQ(merged.to_map().at("01"), 3);
+
+  cudaq::sample_result stitched(makeResult({"01", "10", "10"}));
+  EXPECT_EQ(totalOf(stitched), 3);
+  stitched.append(makeResult({"11", "00", "10"}), /*concatenate=*/true);
+  EXPECT_EQ(totalOf(stitched), 3);
+  EXPECT_EQ(stitched.count("0111"), 1);
+  EXPECT_EQ(stitched.count("1000"), 1);
+  EXPECT_EQ(stitched.count("1010"), 1);
+  EXPECT_EQ(stitched.sequential_data(),
+            (std::vector<std::string>{"0111", "1000", "1010"}));
+}
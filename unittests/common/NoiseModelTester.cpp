@@ -75,6 +75,41 @@ CUDAQ_TEST(NoiseModelTester, checkConstruction) {
   EXPECT_ANY_THROW({ noise.add_channel("invalid_op", {0}, simpleChannel); });
 }
 
+CUDAQ_TEST(NoiseModelTester, checkCachedChannels) {
+  cudaq::noise_model noise;
+  noise.add_channel("x", {1}, bit_flip_channel(0.1));
+
+  // Repeated lookups share one resolved result.
+  auto channels = noise.get_channels_cached("x", {1});
+  ASSERT_EQ(1, channels->size());
+  EXPECT_EQ((*channels)[0][1].data, noise.get_channels("x", {1})[0][1].data);
+  EXPECT_EQ(channels, noise.get_channels_cached("x", {1}));
+  EXPECT_TRUE(noise.get_channels_cached("x", {0})->empty());
+  EXPECT_TRUE(noise.get_channels_cached("x", {1}, {0})->empty());
+
+  // Changing the model invalidates the cache.
+  noise.add_all_qubit_channel("x", depolarization_channel(0.1));
+  EXPECT_EQ(2, noise.get_channels_cached("x", {1})->size());
+  EXPECT_EQ(1, noise.get_channels_cached("x", {0})->size());
+
+  // Callback channels are resolved per gate parameter.
+  std::size_t numCalls = 0;
+  noise.add_channel("rx", [&](const auto &qubits, const auto &params) {
+    ++numCalls;
+    return params[0] > 1. ? kraus_channel(bit_flip_channel(0.1))
+                          : kraus_channel();
+  });
+  EXPECT_TRUE(noise.get_channels_cached("rx", {0}, {}, {0.5})->empty());
+  EXPECT_EQ(1, noise.get_channels_cached("rx", {0}, {}, {1.5})->size());
+  EXPECT_TRUE(noise.get_channels_cached("rx", {0}, {}, {0.5})->empty());
+  EXPECT_EQ(2, numCalls);
+
+  // Copies do not share the cache.
+  cudaq::noise_model copy(noise);
+  EXPECT_NE(copy.get_channels_cached("x", {1}),
+            noise.get_channels_cached("x", {1}));
+}
+
 CUDAQ_TEST(NoiseModelTester, checkOpNames) {
   // Standard channel gets explicit names.
   auto depol = depolarization_channel(0.1);
@@ -8,6 +8,7 @@
 
 #include "CUDAQTestUtils.h"
 #include <cudaq/algorithm.h>
+#include <cudaq/algorithms/gradients/adjoint.h>
 #include <cudaq/algorithms/gradients/central_difference.h>
 #include <cudaq/optimizers.h>
 
@@ -77,6 +78,33 @@ CUDAQ_TEST(GradientTester, checkSimple) {
   EXPECT_NEAR(-2.0453, opt_val, 1e-3);
 }
 
+CUDAQ_TEST(GradientTester, checkAdjoint) {
+  cudaq::spin_op h =
+      5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+      2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+      .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1);
+  cudaq::spin_op h3 = h + 9.625 - 9.625 * cudaq::spin_op::z(2) -
+                      3.913119 * cudaq::spin_op::x(1) * cudaq::spin_op::x(2) -
+                      3.913119 * cudaq::spin_op::y(1) * cudaq::spin_op::y(2);
+  auto argsMapper = [](std::vector<double> x) {
+    return std::make_tuple(x[0], x[1]);
+  };
+
+  // The ansatz uses x0 twice, with opposite signs.
+  cudaq::gradients::adjoint adjoint(deuteron_n3_ansatz{}, argsMapper);
+  cudaq::gradients::central_difference reference(deuteron_n3_ansatz{},
+                                                 argsMapper);
+  for (const std::vector<double> x :
+       {std::vector<double>{.1, .2}, std::vector<double>{-1.3, 2.5}}) {
+    double e = cudaq::observe(deuteron_n3_ansatz{}, h3, x[0], x[1]);
+    std::vector<double> expected(2), actual(2);
+    reference.compute(x, expected, h3, e);
+    adjoint.compute(x, actual, h3, e);
+    for (std::size_t i = 0; i < x.size(); ++i)
+      EXPECT_NEAR(expected[i], actual[i], 1e-5);
+  }
+}
+
 #endif
 
 #endif
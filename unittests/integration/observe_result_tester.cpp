@@ -123,6 +123,66 @@ CUDAQ_TEST(ObserveResult, checkExpValBug) {
   // it acts on a different number of qubits). This is in particular
   // also relevant for noise modeling.
 }
+
+CUDAQ_TEST(ObserveResult, checkGroupedShotObserve) {
+  cudaq::spin_op h =
+      5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+      2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+      .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1) +
+      0.5 * cudaq::spin_op::x(0) + 0.25 * cudaq::spin_op::z(0) *
+                                       cudaq::spin_op::z(1);
+
+  auto ansatz = [](double theta) __qpu__ {
+    cudaq::qubit q, r;
+    x(q);
+    ry(theta, r);
+    x<cudaq::ctrl>(r, q);
+  };
+
+  const std::size_t shots = 100000;
+  auto exact = cudaq::observe(ansatz, h, 0.59);
+
+  setenv("CUDAQ_OBSERVE_GROUP_TERMS", "1", true);
+  auto grouped = cudaq::observe(shots, ansatz, h, 0.59);
+  unsetenv("CUDAQ_OBSERVE_GROUP_TERMS");
+
+  EXPECT_NEAR(grouped.expectation(), exact.expectation(), 1e-1);
+  for (const auto &term : h) {
+    if (term.is_identity())
+      continue;
+    EXPECT_NEAR(grouped.expectation(term), exact.expectation(term), 2e-2);
+    std::size_t totalShots = 0;
+    for (auto &[bits, count] : grouped.counts(term))
+      totalShots += count;
+    EXPECT_EQ(totalShots, shots);
+  }
+}
+
+CUDAQ_TEST(ObserveResult, checkGroupedShotObserveSingleTermGroups) {
+  // X0 and Z0 do not commute qubit-wise, so each is a group of its own.
+  cudaq::spin_op h = cudaq::spin_op::x(0) + 0.5 * cudaq::spin_op::z(0);
+
+  auto ansatz = [](double theta) __qpu__ {
+    cudaq::qubit q;
+    ry(theta, q);
+  };
+
+  const std::size_t shots = 100000;
+  auto exact = cudaq::observe(ansatz, h, 0.59);
+
+  setenv("CUDAQ_OBSERVE_GROUP_TERMS", "1", true);
+  auto grouped = cudaq::observe(shots, ansatz, h, 0.59);
+  unsetenv("CUDAQ_OBSERVE_GROUP_TERMS");
+
+  EXPECT_NEAR(grouped.expectation(), exact.expectation(), 2e-2);
+  for (const auto &term : h) {
+    EXPECT_NEAR(grouped.expectation(term), exact.expectation(term), 2e-2);
+    std::size_t totalShots = 0;
+    for (auto &[bits, count] : grouped.counts(term))
+      totalShots += count;
+    EXPECT_EQ(totalShots, shots);
+  }
+}
 #endif
 
 CUDAQ_TEST(ObserveResult, checkObserveWithIdentity) {
@@ -142,6 +202,51 @@ CUDAQ_TEST(ObserveResult, checkObserveWithIdentity) {
   EXPECT_NEAR(expVal.expectation(), -0.416147, 1e-6);
 }
 
+#ifndef CUDAQ_BACKEND_TENSORNET
+CUDAQ_TEST(ObserveResult, checkDirectPauliExpectation) {
+  // Product state with <Z0> = cos(a), <Y0> = -sin(a), <Z1> = -1,
+  // <Z2> = cos(b) and <X2> = sin(b).
+  auto kernel = [](double a, double b) __qpu__ {
+    cudaq::qvector q(3);
+    rx(a, q[0]);
+    x(q[1]);
+    ry(b, q[2]);
+  };
+
+  const double a = 0.3, b = 0.7;
+  auto y0z1x2 = cudaq::spin_op::y(0) * cudaq::spin_op::z(1) *
+                cudaq::spin_op::x(2);
+  auto z0x2 = cudaq::spin_op::z(0) * cudaq::spin_op::x(2);
+  cudaq::spin_op h = 2.0 * y0z1x2 + 0.5 * z0x2 -
+                     1.5 * cudaq::spin_op::z(1) + 0.25;
+  const double expected = 2.0 * std::sin(a) * std::sin(b) +
+                          0.5 * std::cos(a) * std::sin(b) + 1.5 + 0.25;
+
+  auto flipSecond = []() __qpu__ {
+    cudaq::qvector q(2);
+    x(q[1]);
+  };
+
+  // Check both the sampling-based and the direct (amplitude-based) paths.
+  for (const char *fromSampling : {"1", "0"}) {
+    setenv("CUDAQ_OBSERVE_FROM_SAMPLING", fromSampling, true);
+    auto result = cudaq::observe(kernel, h, a, b);
+    EXPECT_NEAR(result.expectation(), expected, 1e-6);
+    EXPECT_NEAR(result.expectation(y0z1x2), std::sin(a) * std::sin(b), 1e-6);
+    EXPECT_NEAR(result.expectation(z0x2), std::cos(a) * std::sin(b), 1e-6);
+
+    // Qubits must not be reversed.
+    EXPECT_NEAR(
+        cudaq::observe(flipSecond, cudaq::spin_op::z(0)).expectation(), 1.0,
+        1e-6);
+    EXPECT_NEAR(
+        cudaq::observe(flipSecond, cudaq::spin_op::z(1)).expectation(), -1.0,
+        1e-6);
+  }
+  unsetenv("CUDAQ_OBSERVE_FROM_SAMPLING");
+}
+#endif
+
 #ifdef CUDAQ_BACKEND_TENSORNET
 CUDAQ_TEST(ObserveResult, checkObserveWithIdentityLarge) {
 
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2026 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include <cmath>
+#include <cudaq/algorithms/unitary.h>
+
+namespace {
+/// Reference unitary: the product of every gate, made controlled and expanded
+/// to the whole system as dense matrices.
+cudaq::complex_matrix denseUnitary(const cudaq::Trace &trace) {
+  const std::size_t numQubits = trace.getNumQudits();
+  auto U = cudaq::complex_matrix::identity(1ULL << numQubits);
+  for (const auto &inst : trace) {
+    auto gateVec = nvqir::getGateByName<double>(
+        nvqir::getGateNameFromString(inst.name), inst.params);
+    std::size_t gateDim = std::sqrt(gateVec.size());
+    cudaq::complex_matrix gate(gateVec, {gateDim, gateDim});
+    if (!inst.controls.empty())
+      gate =
+          cudaq::contrib::make_controlled_unitary(gate, inst.controls.size());
+    std::vector<std::size_t> qubits;
+    for (const auto &control : inst.controls)
+      qubits.push_back(control.id);
+    for (const auto &target : inst.targets)
+      qubits.push_back(target.id);
+    U = cudaq::contrib::expand_gate_to_system(gate, numQubits, qubits) * U;
+  }
+  return U;
+}
+
+void expectNear(const cudaq::complex_matrix &expected,
+                const cudaq::complex_matrix &actual) {
+  ASSERT_EQ(expected.rows(), actual.rows());
+  ASSERT_EQ(expected.cols(), actual.cols());
+  for (std::size_t i = 0; i < expected.rows(); ++i)
+    for (std::size_t j = 0; j < expected.cols(); ++j)
+      EXPECT_NEAR(std::abs(expected(i, j) - actual(i, j)), 0.0, 1e-12)
+          << "at (" << i << ", " << j << ")";
+}
+} // namespace
+
+CUDAQ_TEST(UnitaryTester, checkFusionMatchesDenseProduct) {
+  auto q = [](std::size_t id) { return cudaq::QuditInfo(2, id); };
+  cudaq::Trace trace;
+  trace.appendInstruction("h", {}, {}, {q(0)});
+  trace.appendInstruction("rx", {0.3}, {}, {q(2)});
+  // Controlled gates on non-adjacent qubits, with controls on either side of
+  // the target and in decreasing order.
+  trace.appendInstruction("x", {}, {q(0)}, {q(3)});
+  trace.appendInstruction("y", {}, {q(3), q(1)}, {q(0)});
+  trace.appendInstruction("ry", {0.7}, {}, {q(1)});
+  // Multi-qubit targets, plain and controlled.
+  trace.appendInstruction("swap", {}, {}, {q(3), q(1)});
+  trace.appendInstruction("swap", {}, {q(2)}, {q(0), q(3)});
+  trace.appendInstruction("rz", {1.1}, {}, {q(3)});
+  trace.appendInstruction("r1", {0.4}, {q(1), q(2)}, {q(0)});
+  trace.appendInstruction("u3", {0.2, 0.5, 0.9}, {}, {q(2)});
+  trace.appendInstruction("t", {}, {}, {q(1)});
+  trace.appendInstruction("s", {}, {q(3)}, {q(2)});
+  trace.appendInstruction("h", {}, {}, {q(3)});
+  ASSERT_EQ(trace.getNumQudits(), 4);
+
+  const auto expected = denseUnitary(trace);
+  // Without fusion, with the default fusion, and with fused gates spanning up
+  // to the whole system.
+  expectNear(expected, cudaq::contrib::unitary_from_trace(trace, 0));
+  expectNear(expected, cudaq::contrib::unitary_from_trace(trace));
+  expectNear(expected, cudaq::contrib::unitary_from_trace(trace, 3));
+  expectNear(expected, cudaq::contrib::unitary_from_trace(trace, 4));
+}
@@ -7,6 +7,8 @@
  ******************************************************************************/
 #include <cudaq.h>
 #include <cudaq/algorithm.h>
+#include <cudaq/optimizers.h>
+#include <atomic>
 #include <gtest/gtest.h>
 #include <random>
 
@@ -126,3 +128,89 @@ TEST(MQPUTester, checkAsyncWithKernelBuilder) {
     EXPECT_NEAR(std::abs(gotState[1] - expectedState[1]), 0.0, 1e-6);
   }
 }
+
+TEST(MQPUTester, checkBroadcastUnevenSplit) {
+  auto ansatz = [](double theta) __qpu__ {
+    cudaq::qubit q;
+    ry(theta, q);
+  };
+
+  // Use a number of argument sets that does not divide evenly over the QPUs,
+  // so that the last QPUs get short (or no) slices.
+  auto &platform = cudaq::get_platform();
+  const std::size_t numSets = 2 * platform.num_qpus() + 1;
+  std::vector<double> angles = cudaq::linspace(-M_PI, M_PI, numSets);
+  auto results =
+      cudaq::observe(ansatz, cudaq::spin_op::z(0), cudaq::make_argset(angles));
+
+  ASSERT_EQ(results.size(), numSets);
+  for (std::size_t i = 0; i < numSets; ++i)
+    EXPECT_NEAR(results[i].expectation(), std::cos(angles[i]), 1e-6);
+}
+
+TEST(MQPUTester, checkGradientFanOut) {
+  cudaq::spin_op h =
+      5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+      2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+      .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1);
+
+  auto ansatz = [](std::vector<double> theta) __qpu__ {
+    cudaq::qubit q, r;
+    x(q);
+    ry(theta[0], r);
+    x<cudaq::ctrl>(r, q);
+  };
+
+  // The shifted points are spread over all QPUs and gathered in order.
+  cudaq::gradients::parameter_shift gradient(ansatz);
+  const std::vector<double> x{0.3};
+  std::vector<double> dx(1);
+  gradient.compute(x, dx, h, cudaq::observe(ansatz, h, x));
+  const double plus = cudaq::observe(ansatz, h, std::vector{0.3 + M_PI_2});
+  const double minus = cudaq::observe(ansatz, h, std::vector{0.3 - M_PI_2});
+  EXPECT_NEAR(dx[0], (plus - minus) / 2., 1e-9);
+
+  cudaq::optimizers::lbfgs optimizer;
+  auto [energy, params] = cudaq::vqe(ansatz, gradient, h, optimizer, 1);
+  EXPECT_NEAR(energy, -1.7487, 1e-3);
+}
+
+namespace {
+// Number of ansatz invocations that ran without the noise model set.
+std::atomic<int> noiselessRuns = 0;
+} // namespace
+
+TEST(MQPUTester, checkNoisyGradientStaysOnNoisyQpu) {
+  cudaq::spin_op h =
+      5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+      2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+      .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1);
+
+  auto ansatz = [](std::vector<double> theta) __qpu__ {
+    // The execution context of a QPU carries its noise model, if any.
+    if (!cudaq::get_platform().get_noise())
+      noiselessRuns++;
+    cudaq::qubit q, r;
+    x(q);
+    ry(theta[0], r);
+    x<cudaq::ctrl>(r, q);
+  };
+
+  // cudaq::set_noise only sets the noise model of QPU 0, so every observation
+  // of the gradient and of the VQE objective must run there.
+  cudaq::noise_model noise;
+  noise.add_channel<cudaq::types::ry>({1}, cudaq::depolarization_channel(.1));
+  cudaq::set_noise(noise);
+  noiselessRuns = 0;
+
+  cudaq::gradients::parameter_shift gradient(ansatz);
+  const std::vector<double> x{0.3};
+  std::vector<double> dx(1);
+  gradient.compute(x, dx, h, cudaq::observe(ansatz, h, x));
+  EXPECT_EQ(noiselessRuns, 0);
+
+  cudaq::optimizers::lbfgs optimizer;
+  cudaq::vqe(ansatz, gradient, h, optimizer, 1);
+  cudaq::unset_noise();
+  EXPECT_EQ(noiselessRuns, 0);
+}
@@ -593,3 +593,52 @@ TEST(OperatorExpressions, checkSpinOpsDegreeVerification) {
   ASSERT_ANY_THROW((op1 + op2).to_matrix({{0, 3}}));
   ASSERT_NO_THROW(op1.to_matrix({{0, 3}}));
 }
+
+TEST(OperatorExpressions, checkSpinOpsTermAggregation) {
+  // Pauli products on shared degrees, including degrees far apart.
+  {
+    auto prod = cudaq::spin_op::x(1000) * cudaq::spin_op::z(3) *
+                cudaq::spin_op::y(1000) * cudaq::spin_op::x(3);
+    EXPECT_EQ(prod.get_term_id(), "Y3Z1000");
+    EXPECT_EQ(prod.evaluate_coefficient(), std::complex<double>(-1., 0.));
+
+    auto lhs = cudaq::spin_op::y(0) * cudaq::spin_op::z(1);
+    auto rhs = cudaq::spin_op::z(0) * cudaq::spin_op::x(1) *
+               cudaq::spin_op::x(2);
+    auto got = lhs * rhs;
+    EXPECT_EQ(got.get_term_id(), "X0Y1X2");
+    EXPECT_EQ(got.evaluate_coefficient(), std::complex<double>(-1., 0.));
+  }
+
+  // Terms are combined if and only if they act with the same Paulis on the
+  // same degrees, including identities.
+  {
+    auto sum = cudaq::spin_op::x(0) * cudaq::spin_op::z(200) +
+               2. * cudaq::spin_op::z(200) * cudaq::spin_op::x(0) +
+               cudaq::spin_op::x(0) * cudaq::spin_op::i(200) +
+               cudaq::spin_op::x(1) + cudaq::spin_op::x(1) +
+               cudaq::spin_op::x(1) * cudaq::spin_op::i(0) +
+               cudaq::spin_op::i(5) + cudaq::spin_op::identity();
+    EXPECT_EQ(sum.num_terms(), 6);
+    for (const auto &term : sum) {
+      auto id = term.get_term_id();
+      if (id == "X0Z200")
+        EXPECT_EQ(term.evaluate_coefficient(), std::complex<double>(3., 0.));
+      else if (id == "X1")
+        EXPECT_EQ(term.evaluate_coefficient(), std::complex<double>(2., 0.));
+      else
+        EXPECT_EQ(term.evaluate_coefficient(), std::complex<double>(1., 0.));
+    }
+  }
+
+  // (X + Y)(X - Y) = -2iZ, with a vanishing identity term
+  {
+    auto sum = (cudaq::spin_op::x(0) + cudaq::spin_op::y(0)) *
+               (cudaq::spin_op::x(0) - cudaq::spin_op::y(0));
+    sum.trim();
+    EXPECT_EQ(sum.num_terms(), 1);
+    EXPECT_EQ(sum.begin()->get_term_id(), "Z0");
+    EXPECT_EQ(sum.begin()->evaluate_coefficient(),
+              std::complex<double>(0., -2.));
+  }
+}
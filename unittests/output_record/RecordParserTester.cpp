@@ -858,3 +858,36 @@ CUDAQ_TEST(ParserTester, checkResultTypeWithArray) {
   buffer = nullptr;
   origBuffer = nullptr;
 }
+
+CUDAQ_TEST(ParserTester, checkChunkedShots) {
+  // The log of a streamed run is decoded chunk by chunk with the same parser.
+  // The header is only part of the first chunk.
+  const std::string firstChunk = "HEADER\tschema_id\tlabeled\n"
+                                 "START\n"
+                                 "OUTPUT\tINT\t7\ti32\n"
+                                 "END\t0\n"
+                                 "START\n"
+                                 "OUTPUT\tINT\t8\ti32\n"
+                                 "END\t0\n";
+  const std::string secondChunk = "START\n"
+                                  "OUTPUT\tINT\t9\ti32\n"
+                                  "END\t0\n";
+  cudaq::RecordLogParser parser;
+  parser.parse(firstChunk);
+  ASSERT_EQ(2 * sizeof(int), parser.getBufferSize());
+  int values[2];
+  std::memcpy(values, parser.getBufferPtr(), sizeof(values));
+  EXPECT_EQ(7, values[0]);
+  EXPECT_EQ(8, values[1]);
+
+  parser.clearBuffer();
+  EXPECT_EQ(0, parser.getBufferSize());
+  parser.parse(secondChunk);
+  ASSERT_EQ(sizeof(int), parser.getBufferSize());
+  std::memcpy(values, parser.getBufferPtr(), sizeof(int));
+  EXPECT_EQ(9, values[0]);
+
+  // The labeled schema from the first chunk still applies.
+  parser.clearBuffer();
+  EXPECT_ANY_THROW(parser.parse("START\nOUTPUT\tINT\t10\nEND\t0\n"));
+}
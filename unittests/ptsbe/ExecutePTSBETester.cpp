@@ -401,3 +401,81 @@ CUDAQ_TEST(ExecutePTSBETest, LifecycleDispatchProducesCorrectResults) {
   EXPECT_EQ(results.size(), 1u);
   EXPECT_EQ(results[0].count("1"), 10u);
 }
+
+/// Trajectories sharing error prefixes give the same results whether they
+/// reuse saved states, restart from |0>, or run on several threads.
+CUDAQ_TEST(ExecutePTSBETest, PrefixReuseAndThreadsMatchSerial) {
+  // Trace: X then a bit flip on each of 3 qubits.
+  PTSBatch batch;
+  for (std::size_t q = 0; q < 3; ++q) {
+    batch.trace.push_back(
+        {ptsbe::TraceInstructionType::Gate, "x", {q}, {}, {}});
+    batch.trace.push_back({ptsbe::TraceInstructionType::Noise,
+                           "bit_flip",
+                           {q},
+                           {},
+                           {},
+                           bit_flip_channel(0.5)});
+    batch.trace.back().channel->generateUnitaryParameters();
+  }
+  batch.measureQubits = {0, 1, 2};
+
+  // One trajectory per subset of flipped qubits, plus one without shots.
+  std::vector<std::string> expected;
+  for (std::size_t mask = 0; mask < 8; ++mask) {
+    std::vector<KrausSelection> selections;
+    std::string bits = "111";
+    for (std::size_t q = 0; q < 3; ++q) {
+      const bool flip = (mask >> q) & 1;
+      selections.emplace_back(2 * q + 1, std::vector<std::size_t>{q}, "x",
+                              flip ? 1 : 0, flip);
+      if (flip)
+        bits[q] = '0';
+    }
+    batch.trajectories.emplace_back(mask, selections, 0.125, 5 + mask);
+    expected.push_back(bits);
+  }
+  batch.trajectories.emplace_back(8, std::vector<KrausSelection>{}, 0.0, 0);
+
+  auto check = [&](const std::vector<sample_result> &results) {
+    ASSERT_EQ(results.size(), 9u);
+    for (std::size_t t = 0; t < 8; ++t) {
+      EXPECT_EQ(results[t].count(expected[t]), 5 + t);
+      EXPECT_EQ(results[t].get_total_shots(), 5 + t);
+    }
+    EXPECT_EQ(results[8].get_total_shots(), 0u);
+  };
+
+  check(samplePTSBEWithLifecycle(batch));
+
+  setenv("CUDAQ_PTSBE_MAX_CHECKPOINTS", "0", 1);
+  check(samplePTSBEWithLifecycle(batch));
+  unsetenv("CUDAQ_PTSBE_MAX_CHECKPOINTS");
+
+  setenv("CUDAQ_PTSBE_NUM_THREADS", "3", 1);
+  check(samplePTSBEWithLifecycle(batch));
+  unsetenv("CUDAQ_PTSBE_NUM_THREADS");
+}
+
+/// Threaded trajectory execution follows the global random seed.
+CUDAQ_TEST(ExecutePTSBETest, ThreadsFollowRandomSeed) {
+  PTSBatch batch;
+  batch.trace = kHadamardTrace;
+  batch.measureQubits = {0};
+  for (std::size_t t = 0; t < 6; ++t)
+    batch.trajectories.emplace_back(t, std::vector<KrausSelection>{}, 1.0 / 6,
+                                    100);
+
+  setenv("CUDAQ_PTSBE_NUM_THREADS", "3", 1);
+  cudaq::set_random_seed(7);
+  auto first = samplePTSBEWithLifecycle(batch);
+  cudaq::set_random_seed(7);
+  auto second = samplePTSBEWithLifecycle(batch);
+  unsetenv("CUDAQ_PTSBE_NUM_THREADS");
+
+  ASSERT_EQ(first.size(), second.size());
+  for (std::size_t t = 0; t < first.size(); ++t) {
+    EXPECT_EQ(first[t].to_map(), second[t].to_map());
+    EXPECT_EQ(first[t].get_total_shots(), 100u);
+  }
+}
@@ -10,7 +10,9 @@
 #include "common/ExecutionContext.h"
 #include "cudaq/platform.h"
 #include "nvqir/Gates.h"
+#include "nvqir/SimulatorProfile.h"
 #include <cmath>
+#include <sstream>
 
 extern "C" {
 extern bool verbose;
@@ -124,6 +126,46 @@ CUDAQ_TEST(NVQIRTester, checkSimple) {
   __quantum__rt__finalize();
 }
 
+CUDAQ_TEST(NVQIRTester, checkSimulatorProfile) {
+  nvqir::SimulatorProfile profile;
+  profile.enabled = true;
+  profile.name = "test";
+  const auto start = nvqir::SimulatorProfile::Clock::now();
+  for (std::size_t i = 0; i < 3; i++)
+    profile.record(nvqir::ProfileCategory::gate, "h", start,
+                   start + std::chrono::microseconds(10 * (i + 1)));
+  profile.record(nvqir::ProfileCategory::noise, "h", start,
+                 start + std::chrono::microseconds(5));
+  profile.recordMemory(64);
+  profile.recordMemory(16);
+
+  const auto &histograms = profile.getHistograms();
+  ASSERT_EQ(histograms.size(), 2);
+  EXPECT_EQ(histograms[0].count, 3);
+  EXPECT_EQ(histograms[0].totalNs, 60000);
+  EXPECT_EQ(histograms[0].minNs, 10000);
+  EXPECT_EQ(histograms[0].maxNs, 30000);
+  EXPECT_GE(histograms[0].quantileNs(0.5), 20000);
+  EXPECT_LE(histograms[0].quantileNs(0.5), 30000);
+  EXPECT_EQ(histograms[1].category, nvqir::ProfileCategory::noise);
+  EXPECT_EQ(profile.getMemoryHighWaterMark(), 64);
+
+  std::stringstream trace;
+  profile.writeChromeTrace(trace);
+  const auto json = trace.str();
+  EXPECT_NE(json.find("\"cat\":\"gate\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(json.find("\"dur\":30"), std::string::npos);
+  EXPECT_NE(json.find("\"memoryHighWaterBytes\":64"), std::string::npos);
+
+  // Only an enabled profile records scopes.
+  nvqir::SimulatorProfile disabled;
+  disabled.enabled = false;
+  { nvqir::ProfileScope scope(disabled, nvqir::ProfileCategory::gate, "x"); }
+  EXPECT_TRUE(disabled.getHistograms().empty());
+  // Keep the destructor from writing a trace file.
+  profile.enabled = false;
+}
+
 // Stim does not support many of the gates used in these tests.
 #ifndef CUDAQ_BACKEND_STIM
 
@@ -435,6 +477,26 @@ CUDAQ_TEST(NVQIRTester, checkGates) {
   }
 }
 
+CUDAQ_TEST(NVQIRTester, checkGateOpcodes) {
+  EXPECT_EQ(nvqir::getGateNameOrCustom("rx"), nvqir::GateName::Rx);
+  EXPECT_EQ(nvqir::getGateNameOrCustom("phased_rx"),
+            nvqir::GateName::PhasedRx);
+  EXPECT_EQ(nvqir::getGateNameOrCustom("my_unitary"), nvqir::GateName::Custom);
+  EXPECT_EQ(nvqir::rz<double>::opcode, nvqir::GateName::Rz);
+  EXPECT_THROW(nvqir::getGateNameFromString("my_unitary"), std::runtime_error);
+
+  // Filling a matrix in place matches getGateByName and keeps the buffer.
+  std::vector<std::complex<double>> matrix;
+  matrix.reserve(16);
+  const auto *data = matrix.data();
+  const double angle[] = {0.3};
+  nvqir::fillGateByName<double>(nvqir::GateName::Ry, angle, matrix);
+  EXPECT_EQ(matrix, nvqir::getGateByName<double>(nvqir::GateName::Ry, {0.3}));
+  nvqir::fillGateByName<double>(nvqir::GateName::Swap, {}, matrix);
+  EXPECT_EQ(matrix, nvqir::getGateByName<double>(nvqir::GateName::Swap));
+  EXPECT_EQ(matrix.data(), data);
+}
+
 CUDAQ_TEST(NVQIRTester, checkQubitAllocationFromStateVec) {
   // Library code...
   __quantum__rt__initialize(0, nullptr);
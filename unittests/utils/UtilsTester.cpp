@@ -208,4 +208,18 @@ TEST(UtilsTester, JsonSerDesGradient) {
     json j2(*test_grad_round_trip);
     EXPECT_EQ(j.dump(), j2.dump());
   }
+
+  {
+    cudaq::gradients::adjoint grad;
+    json j(grad);
+    std::cout << j.dump() << '\n';
+    EXPECT_EQ(j.dump(), "{}");
+    EXPECT_EQ(json(cudaq::get_gradient_type(grad)).dump(), "\"ADJOINT\"");
+
+    auto test_grad_round_trip =
+        make_gradient_from_json(j, cudaq::get_gradient_type(grad));
+    EXPECT_NE(
+        dynamic_cast<cudaq::gradients::adjoint *>(test_grad_round_trip.get()),
+        nullptr);
+  }
 }